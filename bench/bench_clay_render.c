@@ -0,0 +1,111 @@
+#include "bench_common.h"
+
+#include <stdlib.h>
+
+#define CLAY_IMPLEMENTATION
+#include "clay.h"
+// The renderer is compiled here, against the real raylib and Clay headers
+#include "clay_renderer_raylib.c"
+
+// Clay UI drawing: Clay_Raylib_Render, which regroups commands by texture
+// between scissor changes, versus drawing the same commands in Clay's
+// painter's order. The layout is the kind that alternates textures on every
+// row: bordered panels of labelled rows, the last one a clipped scrolling list.
+//
+// Needs a window (a hidden one is opened); without a display it reports
+// that and exits successfully.
+//
+// Usage: bench_clay_render [rows] [frames]
+
+#define BENCH_PANELS 4
+
+static void layout_panels(int rows) {
+    CLAY({ .id = CLAY_ID("root"),
+           .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .childGap = 8, .padding = CLAY_PADDING_ALL(8) } }) {
+        for (int p = 0; p < BENCH_PANELS; p++) {
+            CLAY({ .id = CLAY_IDI("panel", p),
+                   .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) }, .layoutDirection = CLAY_TOP_TO_BOTTOM, .childGap = 2 },
+                   .backgroundColor = { 30, 30, 40, 255 },
+                   .border = { .color = { 120, 120, 140, 255 }, .width = { 1, 1, 1, 1 } },
+                   .clip = { .vertical = p == BENCH_PANELS - 1 } }) {
+                for (int i = 0; i < rows; i++) {
+                    CLAY({ .id = CLAY_IDI("row", p * rows + i),
+                           .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT() }, .padding = CLAY_PADDING_ALL(4) },
+                           .backgroundColor = { 60, 60, (float)(70 + i % 4 * 20), 255 },
+                           .cornerRadius = CLAY_CORNER_RADIUS(3) }) {
+                        CLAY_TEXT(CLAY_STRING("Potion of healing"), CLAY_TEXT_CONFIG({ .fontSize = 16, .textColor = { 240, 240, 240, 255 } }));
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Every command in Clay's order, as the renderer drew them before batching
+static void render_in_order(Clay_RenderCommandArray commands, Font* fonts) {
+    for (int i = 0; i < commands.length; i++) {
+        Clay_Raylib_DrawCommand(commands, Clay_RenderCommandArray_Get(&commands, i), fonts);
+    }
+}
+
+typedef void (*RenderFn)(Clay_RenderCommandArray commands, Font* fonts);
+
+static void render_batched(Clay_RenderCommandArray commands, Font* fonts) {
+    Clay_Raylib_Render(commands, fonts);
+}
+
+static double bench_render(const char* name, RenderFn fn, Clay_RenderCommandArray commands, Font* fonts, int frames) {
+    double seconds = 0.0;
+    for (int f = 0; f < frames; f++) {
+        BeginDrawing();
+        ClearBackground(BLACK);
+        double t0 = bench_now_seconds();
+        fn(commands, fonts);
+        EndDrawing();  // flushes raylib's batch, so the draw calls are timed too
+        seconds += bench_now_seconds() - t0;
+    }
+    printf("  %-8s %5d frames %9.3f ms %7.3f ms/frame\n", name, frames, seconds * 1e3, seconds * 1e3 / frames);
+    return seconds;
+}
+
+static void clay_error(Clay_ErrorData error) {
+    fprintf(stderr, "clay: %.*s\n", (int)error.errorText.length, error.errorText.chars);
+}
+
+int main(int argc, char** argv) {
+    int rows = argc > 1 ? atoi(argv[1]) : 40;
+    int frames = argc > 2 ? atoi(argv[2]) : 300;
+    if (rows <= 0) rows = 40;
+    if (frames <= 0) frames = 300;
+
+    SetTraceLogLevel(LOG_WARNING);
+    Clay_Raylib_Initialize(1600, 900, "bench_clay_render", FLAG_WINDOW_HIDDEN);
+    if (!IsWindowReady()) {
+        printf("bench_clay_render: no window available, skipped\n");
+        return 0;
+    }
+    SetTargetFPS(0);
+
+    Font fonts[1] = { GetFontDefault() };
+    uint32_t memorySize = Clay_MinMemorySize();
+    void* memory = malloc(memorySize);
+    if (!memory) return 1;
+    Clay_Arena arena = Clay_CreateArenaWithCapacityAndMemory(memorySize, memory);
+    Clay_Initialize(arena, (Clay_Dimensions){ 1600, 900 }, (Clay_ErrorHandler){ clay_error, 0 });
+    Clay_SetMeasureTextFunction(Raylib_MeasureText, fonts);
+
+    Clay_BeginLayout();
+    layout_panels(rows);
+    Clay_RenderCommandArray commands = Clay_EndLayout();
+
+    printf("bench_clay_render: %d panels x %d rows, %d commands, %d frames\n",
+           BENCH_PANELS, rows, commands.length, frames);
+    double ordered = bench_render("ordered", render_in_order, commands, fonts, frames);
+    double batched = bench_render("batched", render_batched, commands, fonts, frames);
+    Clay_RaylibRenderStats stats = Clay_Raylib_GetRenderStats();
+    printf("  texture runs %d -> %d, speedup %.2fx\n", stats.unbatchedRuns, stats.batches, ordered / batched);
+
+    free(memory);
+    Clay_Raylib_Close();
+    return 0;
+}
@@ -0,0 +1,32 @@
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+// Shared helpers for the bench_* executables (built with -DBUILD_BENCHMARKS=ON)
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+static inline double bench_now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// xorshift32, keeps random access patterns identical across runs
+static inline uint32_t bench_rand(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static inline void bench_report(const char* backend, const char* op, long ops, double seconds) {
+    double nsPerOp = ops > 0 ? (seconds * 1e9) / (double)ops : 0.0;
+    printf("  %-10s %-6s %10ld ops  %9.3f ms  %8.2f ns/op\n", backend, op, ops, seconds * 1e3, nsPerOp);
+}
+
+#endif // BENCH_COMMON_H
@@ -0,0 +1,94 @@
+#include "bench_common.h"
+
+#include <stdlib.h>
+
+#include "systems/dungeon_system.h"
+
+// Floors generated per second by DungeonSystem at several map sizes and
+// thread counts. Every configuration is also checked against the
+// single-threaded FloorSystem_generate: the output must be bit-identical.
+//
+// Usage: bench_dungeon [tilesPerRun] [maxThreads]
+
+#define BENCH_DUNGEON_SEED 0x3C6EF372u
+#define BENCH_VERIFY_DEPTHS 4
+
+static const int mapSizes[] = { 128, 512, 1024, 2048, 4096 };
+
+static const FloorTiles palette = { 5, 4, 3, 8, 7 };
+
+// FNV-1a over the floor's tiles and stairs
+static uint64_t floor_hash(const Floor* floor) {
+    uint64_t h = 0xCBF29CE484222325ull;
+    long count = (long)floor->width * floor->height;
+    for (long i = 0; i < count; i++) {
+        h = (h ^ floor->tiles[i]) * 0x100000001B3ull;
+    }
+    h = (h ^ (uint64_t)(floor->upX * 31 + floor->upY)) * 0x100000001B3ull;
+    h = (h ^ (uint64_t)(floor->downX * 31 + floor->downY)) * 0x100000001B3ull;
+    return h;
+}
+
+static bool verify(DungeonSystem* sys, Floor* floor, Floor* reference) {
+    for (int depth = 0; depth < BENCH_VERIFY_DEPTHS; depth++) {
+        FloorSystem_generate(reference, FloorSystem_floor_seed(BENCH_DUNGEON_SEED, depth), &palette);
+        DungeonSystem_generate(sys, floor, depth, &palette);
+        if (floor_hash(floor) != floor_hash(reference)) return false;
+    }
+    return true;
+}
+
+static bool bench_size(int mapSize, long tilesPerRun, int maxThreads) {
+    Floor floor, reference;
+    if (!FloorSystem_init(&floor, mapSize, mapSize) || !FloorSystem_init(&reference, mapSize, mapSize)) {
+        fprintf(stderr, "bench_dungeon: out of memory at %dx%d\n", mapSize, mapSize);
+        FloorSystem_free(&floor);
+        return false;
+    }
+    long floors = tilesPerRun / ((long)mapSize * mapSize);
+    if (floors < 1) floors = 1;
+
+    bool identical = true;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        DungeonSystem sys;
+        DungeonSystem_init(&sys, BENCH_DUNGEON_SEED, threads - 1);
+        int used = sys.workerCount + 1;
+        if (used < threads) {  // could not start more workers
+            DungeonSystem_shutdown(&sys);
+            break;
+        }
+
+        double t0 = bench_now_seconds();
+        for (long i = 0; i < floors; i++) {
+            DungeonSystem_generate(&sys, &floor, (int)i, &palette);
+        }
+        double seconds = bench_now_seconds() - t0;
+
+        bool same = verify(&sys, &floor, &reference);
+        identical = identical && same;
+        printf("  %5dx%-5d %2d threads %7ld floors %10.3f ms %11.1f floors/s  %s\n",
+               mapSize, mapSize, used, floors, seconds * 1e3,
+               seconds > 0.0 ? (double)floors / seconds : 0.0, same ? "identical" : "MISMATCH");
+
+        DungeonSystem_shutdown(&sys);
+    }
+
+    FloorSystem_free(&floor);
+    FloorSystem_free(&reference);
+    return identical;
+}
+
+int main(int argc, char** argv) {
+    long tilesPerRun = argc > 1 ? atol(argv[1]) : 64L * 1024 * 1024;
+    int maxThreads = argc > 2 ? atoi(argv[2]) : DUNGEON_MAX_WORKERS + 1;
+    if (tilesPerRun <= 0) tilesPerRun = 64L * 1024 * 1024;
+    if (maxThreads <= 0) maxThreads = DUNGEON_MAX_WORKERS + 1;
+
+    printf("bench_dungeon: %ld tiles per run, up to %d threads, %d-tile regions\n",
+           tilesPerRun, maxThreads, FLOOR_REGION_SIZE);
+    bool identical = true;
+    for (size_t i = 0; i < sizeof(mapSizes) / sizeof(mapSizes[0]); i++) {
+        identical = bench_size(mapSizes[i], tilesPerRun, maxThreads) && identical;
+    }
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+#include "bench_common.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+#include "systems/game_system.h"
+#include "renderer/renderer_headless.h"
+#include "input/input_scripted.h"
+
+// Runs GameSystem_frame against the headless renderer and a scripted input
+// provider, so it needs no display or GPU. The script walks the player in
+// a square (one step every few frames), zooms out and back, toggles the
+// debug overlay and places a tile. Reports time per frame and the draw
+// calls, texture binds and command bytes the frames issued.
+//
+// The UI provider is left out: the Clay renderer draws through raylib
+// directly. Chunk and tile-edit files go under cache/ and saves/ in the
+// working directory, as they do for the game.
+//
+// Usage: bench_frame [frames] [mapSize] [chunked|table]
+
+#define BENCH_WIDTH 1600
+#define BENCH_HEIGHT 900
+#define BENCH_TILE_SIZE 16
+#define BENCH_STEP_FRAMES 4   // frames between steps
+#define BENCH_SIDE_STEPS 24   // steps along each side of the square
+
+static const int walkKeys[] = { INPUT_KEY_D, INPUT_KEY_S, INPUT_KEY_A, INPUT_KEY_W };
+
+static InputScriptEvent event_at(uint32_t frame) {
+    InputScriptEvent e = { frame, 0, -1, 0.0f, false, { 0.0f, 0.0f } };
+    return e;
+}
+
+// Returns the script period; events are written sorted by frame
+static uint32_t build_script(InputScriptEvent* events, int* outCount) {
+    int n = 0;
+    uint32_t frame = 0;
+
+    InputScriptEvent debug = event_at(frame);
+    debug.key = INPUT_KEY_F3;
+    events[n++] = debug;
+
+    for (int side = 0; side < 4; side++) {
+        for (int step = 0; step < BENCH_SIDE_STEPS; step++) {
+            frame += BENCH_STEP_FRAMES;
+            InputScriptEvent e = event_at(frame);
+            e.key = walkKeys[side];
+            if (side == 1 && step == 0) e.wheel = -3.0f;
+            if (side == 3 && step == 0) e.wheel = 3.0f;
+            events[n++] = e;
+        }
+        InputScriptEvent click = event_at(++frame);
+        click.mouseButton = INPUT_MOUSE_BUTTON_LEFT;
+        click.moveMouse = true;
+        click.mousePos = (RenderVector2){ BENCH_WIDTH * 0.5f + 48.0f, BENCH_HEIGHT * 0.5f };
+        events[n++] = click;
+    }
+
+    *outCount = n;
+    return frame + 1;
+}
+
+int main(int argc, char** argv) {
+    long frames = argc > 1 ? atol(argv[1]) : 2000;
+    int mapSize = argc > 2 ? atoi(argv[2]) : 512;
+    if (frames <= 0) frames = 2000;
+    if (mapSize <= 0) mapSize = 512;
+    TileStorageMode storageMode = argc > 3 && strcmp(argv[3], "table") == 0 ? TILE_STORAGE_TABLE : TILE_STORAGE_CHUNKED;
+
+    InputScriptEvent events[4 * (BENCH_SIDE_STEPS + 1) + 1];
+    int eventCount = 0;
+    uint32_t period = build_script(events, &eventCount);
+
+    Renderer* renderer = RendererHeadless_create(BENCH_WIDTH, BENCH_HEIGHT, 1.0f / 60.0f, (uint32_t)frames);
+    InputProvider* input = InputProviderScripted_create(events, eventCount, period);
+    if (!renderer || !input) {
+        fprintf(stderr, "bench_frame: failed to create headless renderer or input\n");
+        return 1;
+    }
+
+    Arena_T arena = Arena_new();
+    double t0 = bench_now_seconds();
+    GameSystem* game = GameSystem_create(arena, mapSize, BENCH_TILE_SIZE, storageMode,
+                                         (Vector2){ BENCH_WIDTH, BENCH_HEIGHT }, renderer, input, NULL);
+    double createSeconds = bench_now_seconds() - t0;
+
+    double worst = 0.0;
+    t0 = bench_now_seconds();
+    while (!Renderer_should_close(renderer)) {
+        double f0 = bench_now_seconds();
+        Renderer_begin_frame(renderer);
+        GameSystem_frame(game, Renderer_get_delta_time(renderer));
+        Renderer_end_frame(renderer);
+        InputProviderScripted_advance(input);
+        double f = bench_now_seconds() - f0;
+        if (f > worst) worst = f;
+    }
+    double seconds = bench_now_seconds() - t0;
+
+    RendererHeadlessStats total = RendererHeadless_total_stats(renderer);
+    long ran = (long)RendererHeadless_frame_count(renderer);
+    double perFrame = ran > 0 ? 1.0 / (double)ran : 0.0;
+
+    printf("bench_frame: %ld frames, %dx%d %s map, %dx%d target, script period %u frames\n",
+           ran, mapSize, mapSize, storageMode == TILE_STORAGE_TABLE ? "table" : "chunked",
+           BENCH_WIDTH, BENCH_HEIGHT, period);
+    printf("  create     %10.3f ms\n", createSeconds * 1e3);
+    bench_report("headless", "frame", ran, seconds);
+    printf("  worst      %10.3f ms\n", worst * 1e3);
+    printf("  per frame  %8.1f commands  %8.1f draws  %8.1f binds  %10.1f bytes\n",
+           total.commands * perFrame, total.drawCalls * perFrame,
+           total.textureBinds * perFrame, total.bytes * perFrame);
+
+    GameSystem_destroy(game);
+    Arena_dispose(&arena);
+    InputProviderScripted_destroy(input);
+    RendererHeadless_destroy(renderer);
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include "bench_common.h"
+
+#include <stdlib.h>
+
+#include "arena.h"
+#include "renderer/render_commands.h"
+#include "renderer/render_layer.h"
+#include "renderer/renderer_headless.h"
+
+// Draw calls for a populated scene submitted immediately, in entity order,
+// versus through RenderPipeline. The scene is a screen of chunk textures
+// plus entities that each draw a sprite from one of two atlases, a health
+// bar (two rectangles) and a name label. Draw calls are the batch breaks
+// the headless renderer counts: a new draw starts whenever the texture
+// changes.
+//
+// Usage: bench_render_pipeline [entities] [frames]
+
+#define BENCH_CHUNK_TEXTURES 12
+
+// Stand-ins for backend texture handles, only compared
+static char chunkTextures[BENCH_CHUNK_TEXTURES];
+static char monsterAtlas;
+static char itemAtlas;
+
+static const RenderColor white = { 255, 255, 255, 255 };
+
+typedef void (*SubmitFn)(void* target, int layer, const RenderCommand* cmd);
+
+static void submit_immediate(void* target, int layer, const RenderCommand* cmd) {
+    (void)layer;
+    Renderer_execute_command((Renderer*)target, cmd);
+}
+
+static void submit_layer(void* target, int layer, const RenderCommand* cmd) {
+    RenderLayer** layers = (RenderLayer**)target;
+    RenderLayer_add_command(layers[layer], cmd);
+}
+
+static void build_scene(SubmitFn submit, void* target, int entities) {
+    for (int i = 0; i < BENCH_CHUNK_TEXTURES; i++) {
+        RenderCommand cmd = RenderCommand_texture(&chunkTextures[i], (RenderRect){ 0, 0, 1024, -1024 },
+                                                  (RenderRect){ (float)(i % 4) * 400.0f, (float)(i / 4) * 300.0f, 400, 300 }, white);
+        submit(target, 0, &cmd);
+    }
+
+    uint32_t rng = 0x9E3779B9u;
+    for (int i = 0; i < entities; i++) {
+        float x = (float)(bench_rand(&rng) % 1600);
+        float y = (float)(bench_rand(&rng) % 900);
+        void* atlas = (i % 3 == 0) ? (void*)&itemAtlas : (void*)&monsterAtlas;
+        float tile = (float)(bench_rand(&rng) % 9) * 16.0f;
+
+        RenderCommand sprite = RenderCommand_texture(atlas, (RenderRect){ tile, 0, 16, 16 },
+                                                     (RenderRect){ x, y, 32, 32 }, white);
+        RenderCommand barBack = RenderCommand_rectangle((RenderRect){ x, y - 6, 32, 4 }, (RenderColor){ 40, 40, 40, 255 });
+        RenderCommand barFill = RenderCommand_rectangle((RenderRect){ x, y - 6, 24, 4 }, (RenderColor){ 200, 30, 30, 255 });
+        RenderCommand label = RenderCommand_text("goblin", x, y + 34, 10.0f, white);
+        submit(target, 1, &sprite);
+        submit(target, 1, &barBack);
+        submit(target, 1, &barFill);
+        submit(target, 1, &label);
+    }
+}
+
+int main(int argc, char** argv) {
+    int entities = argc > 1 ? atoi(argv[1]) : 2000;
+    int frames = argc > 2 ? atoi(argv[2]) : 200;
+    if (entities <= 0) entities = 2000;
+    if (frames <= 0) frames = 200;
+
+    Renderer* immediate = RendererHeadless_create(1600, 900, 1.0f / 60.0f, 0);
+    Renderer* batched = RendererHeadless_create(1600, 900, 1.0f / 60.0f, 0);
+    if (!immediate || !batched) {
+        fprintf(stderr, "bench_render_pipeline: failed to create headless renderers\n");
+        return 1;
+    }
+
+    Arena_T arena = Arena_new();
+    RenderPipeline* pipeline = RenderPipeline_create(arena);
+    RenderLayer* layers[2];
+    for (int i = 0; i < 2; i++) {
+        layers[i] = RenderLayer_create(arena, i);
+        RenderPipeline_add_layer(pipeline, layers[i]);
+    }
+
+    double t0 = bench_now_seconds();
+    for (int f = 0; f < frames; f++) {
+        Renderer_begin_frame(immediate);
+        build_scene(submit_immediate, immediate, entities);
+        Renderer_end_frame(immediate);
+    }
+    double immediateSeconds = bench_now_seconds() - t0;
+
+    t0 = bench_now_seconds();
+    for (int f = 0; f < frames; f++) {
+        Renderer_begin_frame(batched);
+        RenderPipeline_clear(pipeline);
+        build_scene(submit_layer, layers, entities);
+        RenderPipeline_execute(pipeline, batched);
+        Renderer_end_frame(batched);
+    }
+    double batchedSeconds = bench_now_seconds() - t0;
+
+    RendererHeadlessStats before = RendererHeadless_frame_stats(immediate);
+    RendererHeadlessStats after = RendererHeadless_frame_stats(batched);
+    printf("bench_render_pipeline: %d entities, %d chunk textures, %d frames\n",
+           entities, BENCH_CHUNK_TEXTURES, frames);
+    printf("  %-10s %8ld commands %8ld draw calls\n", "immediate", before.commands, before.textureBinds);
+    printf("  %-10s %8ld commands %8ld draw calls (pipeline counted %ld -> %ld)\n", "pipeline",
+           after.commands, after.textureBinds, pipeline->stats.unsortedRuns, pipeline->stats.runs);
+    bench_report("immediate", "frame", frames, immediateSeconds);
+    bench_report("pipeline", "frame", frames, batchedSeconds);
+
+    Arena_dispose(&arena);
+    RendererHeadless_destroy(immediate);
+    RendererHeadless_destroy(batched);
+    return after.textureBinds <= before.textureBinds ? 0 : 1;
+}
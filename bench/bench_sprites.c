@@ -0,0 +1,102 @@
+#include "bench_common.h"
+
+#include <stdlib.h>
+
+#include "arena.h"
+#include "gramarye_ecs/ecs.h"
+#include "gramarye_ecs/entity.h"
+#include "core/position.h"
+#include "textures/sprite.h"
+#include "textures/atlas.h"
+#include "components/spatial_index.h"
+#include "systems/sprite_render_system.h"
+#include "renderer/render_layer.h"
+#include "renderer/renderer_headless.h"
+
+// SpriteRenderSystem over monsters and items drawn from two atlases,
+// either spread over a large area (most culled) or packed into the view.
+// Reports time per frame and per indexed entity, and the draw calls the
+// headless renderer counts after the pipeline.
+//
+// Usage: bench_sprites [entities] [frames]
+
+#define BENCH_TILE_SIZE 16
+#define BENCH_SPREAD_TILES 1024
+
+static void bench_scene(const char* name, int entities, int frames, int spreadTiles) {
+    Arena_T arena = Arena_new();
+    ECS* ecs = ECS_new(arena);
+    ComponentTypeId positionTypeId = ECS_register_component_type(ecs, "Position", sizeof(Position));
+    ComponentTypeId spriteTypeId = ECS_register_component_type(ecs, "Sprite", sizeof(Sprite));
+    EntityRegistry* registry = ECS_get_entity_registry(ecs);
+
+    // No window, so the atlases only carry source rects
+    Atlas* monsters = Atlas_new(16);
+    Atlas* items = Atlas_new(16);
+    for (int i = 0; i < 9; i++) {
+        Rectangle rect = { (float)(i * 16), 0.0f, 16.0f, 16.0f };
+        Atlas_addRect(monsters, i, rect);
+        Atlas_addRect(items, i, rect);
+    }
+
+    SpatialIndex index;
+    SpatialIndex_init(&index, entities);
+    uint32_t rng = 0x243F6A88u;
+    for (int i = 0; i < entities; i++) {
+        EntityId e = Entity_create(registry);
+        int x = (int)(bench_rand(&rng) % spreadTiles);
+        int y = (int)(bench_rand(&rng) % spreadTiles);
+        Position_add(ecs, e, positionTypeId, x, y);
+        Sprite_add(ecs, e, spriteTypeId, (i % 4 == 0) ? items : monsters, (int)(bench_rand(&rng) % 9));
+        SpatialIndex_insert(&index, e, x, y);
+    }
+
+    SpriteRenderSystem sprites;
+    SpriteRenderSystem_init(&sprites, ecs, &index, spriteTypeId, BENCH_TILE_SIZE);
+
+    Camera2DEx cam;
+    Camera_Init(&cam, (Vector2){ 1600.0f, 900.0f });
+    cam.pos = (Vector2){ 0.0f, 0.0f };
+    AspectFit fit = Camera_ComputeAspectFit(cam.logicalSize, 1600, 900);
+
+    Renderer* renderer = RendererHeadless_create(1600, 900, 1.0f / 60.0f, 0);
+    RenderPipeline* pipeline = RenderPipeline_create(arena);
+    RenderLayer* layer = RenderLayer_create(arena, 0);
+    RenderPipeline_add_layer(pipeline, layer);
+
+    double t0 = bench_now_seconds();
+    for (int f = 0; f < frames; f++) {
+        // Pan a tile every frame so the culled set changes
+        cam.pos.x = (float)((f % 64) * BENCH_TILE_SIZE);
+        Renderer_begin_frame(renderer);
+        RenderPipeline_clear(pipeline);
+        SpriteRenderSystem_render(&sprites, layer, &cam, fit);
+        RenderPipeline_execute(pipeline, renderer);
+        Renderer_end_frame(renderer);
+    }
+    double seconds = bench_now_seconds() - t0;
+
+    RendererHeadlessStats stats = RendererHeadless_frame_stats(renderer);
+    printf("  %-7s %7d entities %7d visible %2d batches %3ld draw calls %9.3f ms/frame %7.2f ns/entity\n",
+           name, entities, sprites.visibleCount, sprites.batchCount, stats.textureBinds,
+           seconds * 1e3 / frames, seconds * 1e9 / ((double)frames * entities));
+
+    SpriteRenderSystem_cleanup(&sprites);
+    SpatialIndex_free(&index);
+    RendererHeadless_destroy(renderer);
+    Atlas_free(monsters);
+    Atlas_free(items);
+    Arena_dispose(&arena);
+}
+
+int main(int argc, char** argv) {
+    int entities = argc > 1 ? atoi(argv[1]) : 20000;
+    int frames = argc > 2 ? atoi(argv[2]) : 200;
+    if (entities <= 0) entities = 20000;
+    if (frames <= 0) frames = 200;
+
+    printf("bench_sprites: %d frames, 1600x900 view, %d-pixel tiles\n", frames, BENCH_TILE_SIZE);
+    bench_scene("spread", entities, frames, BENCH_SPREAD_TILES);
+    bench_scene("packed", entities, frames, 50);
+    return 0;
+}
@@ -0,0 +1,200 @@
+#include "bench_common.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CLAY_IMPLEMENTATION
+#include "clay.h"
+#include "raylib.h"
+#include "renderer/glyph_advance.h"
+
+// UI text measurement: the per-glyph walk Raylib_MeasureText does versus
+// GlyphAdvanceTable, first on bare strings (message log lines and
+// tooltips), then inside a Clay layout of a scrolling message log with
+// tooltips whose numbers change every frame, so Clay's word cache keeps
+// missing the way it does while a log fills up.
+//
+// The font is synthetic (no window is opened): 95 ASCII glyphs with
+// varied advances at a 32-pixel base size.
+//
+// Usage: bench_text [logLines] [frames]
+
+#define BENCH_FONT_BASE 32
+#define BENCH_GLYPHS 95
+#define BENCH_LINE_CHARS 96
+#define BENCH_TOOLTIPS 16
+
+static const char* actors[] = { "goblin", "skeleton archer", "cave spider", "you", "the shopkeeper", "a giant rat" };
+static const char* verbs[] = { "hits", "misses", "bites", "shoots", "curses", "ignores" };
+
+static Font make_font(GlyphInfo* glyphs, Rectangle* recs) {
+    for (int i = 0; i < BENCH_GLYPHS; i++) {
+        int advance = 10 + (i * 7) % 12;
+        glyphs[i] = (GlyphInfo){ .value = 32 + i, .offsetX = 1, .offsetY = 0, .advanceX = advance };
+        recs[i] = (Rectangle){ (float)(i * 24), 0.0f, (float)(advance - 2), (float)BENCH_FONT_BASE };
+    }
+    Font font = { 0 };
+    font.baseSize = BENCH_FONT_BASE;
+    font.glyphCount = BENCH_GLYPHS;
+    font.glyphs = glyphs;
+    font.recs = recs;
+    return font;
+}
+
+// Raylib_MeasureText from clay_renderer_raylib.c, which the game used before
+static Clay_Dimensions measure_walk(Clay_StringSlice text, Clay_TextElementConfig* config, void* userData) {
+    Clay_Dimensions textSize = { 0 };
+    float maxTextWidth = 0.0f;
+    float lineTextWidth = 0;
+    int lineCharCount = 0;
+    Font* fonts = (Font*)userData;
+    Font fontToUse = fonts[config->fontId];
+    float scaleFactor = config->fontSize / (float)fontToUse.baseSize;
+    for (int i = 0; i < text.length; ++i, lineCharCount++) {
+        if (text.chars[i] == '\n') {
+            maxTextWidth = fmaxf(maxTextWidth, lineTextWidth);
+            lineTextWidth = 0;
+            lineCharCount = 0;
+            continue;
+        }
+        int index = text.chars[i] - 32;
+        if (fontToUse.glyphs[index].advanceX != 0) lineTextWidth += fontToUse.glyphs[index].advanceX;
+        else lineTextWidth += (fontToUse.recs[index].width + fontToUse.glyphs[index].offsetX);
+    }
+    maxTextWidth = fmaxf(maxTextWidth, lineTextWidth);
+    textSize.width = maxTextWidth * scaleFactor + (lineCharCount * config->letterSpacing);
+    textSize.height = config->fontSize;
+    return textSize;
+}
+
+static Clay_Dimensions measure_table(Clay_StringSlice text, Clay_TextElementConfig* config, void* userData) {
+    const GlyphAdvanceTable* tables = (const GlyphAdvanceTable*)userData;
+    Vector2 size = GlyphAdvanceTable_measure(&tables[config->fontId], text.chars, text.length,
+                                             (float)config->fontSize, (float)config->letterSpacing);
+    return (Clay_Dimensions){ size.x, size.y };
+}
+
+typedef Clay_Dimensions (*MeasureFn)(Clay_StringSlice, Clay_TextElementConfig*, void*);
+
+typedef struct BenchText {
+    char (*lines)[BENCH_LINE_CHARS];
+    int lineCount;
+    char tooltips[BENCH_TOOLTIPS][BENCH_LINE_CHARS * 2];
+} BenchText;
+
+// Log lines as they read at a given turn; every line carries the turn number
+static void write_text(BenchText* text, int turn) {
+    for (int i = 0; i < text->lineCount; i++) {
+        int t = turn + i;
+        snprintf(text->lines[i], BENCH_LINE_CHARS, "Turn %d: %s %s %s for %d damage.",
+                 t, actors[t % 6], verbs[(t / 6) % 6], actors[(t / 36) % 6], (t * 7) % 23);
+    }
+    for (int i = 0; i < BENCH_TOOLTIPS; i++) {
+        int t = turn + i * 3;
+        snprintf(text->tooltips[i], sizeof(text->tooltips[i]),
+                 "Potion of healing (%d)\nRestores %d hit points.\nWeight %d.%d lb, value %d gold", t % 9 + 1,
+                 10 + t % 40, t % 3, t % 10, 25 + t % 100);
+    }
+}
+
+static double bench_measure(const char* name, MeasureFn fn, void* userData, const BenchText* text, int rounds,
+                            long* chars, float* checksum) {
+    Clay_TextElementConfig config = { .fontId = 0, .fontSize = 16, .letterSpacing = 0 };
+    *chars = 0;
+    *checksum = 0.0f;
+    double t0 = bench_now_seconds();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < text->lineCount; i++) {
+            Clay_StringSlice slice = { .length = (int32_t)strlen(text->lines[i]), .chars = text->lines[i] };
+            *checksum += fn(slice, &config, userData).width;
+            *chars += slice.length;
+        }
+        for (int i = 0; i < BENCH_TOOLTIPS; i++) {
+            Clay_StringSlice slice = { .length = (int32_t)strlen(text->tooltips[i]), .chars = text->tooltips[i] };
+            *checksum += fn(slice, &config, userData).width;
+            *chars += slice.length;
+        }
+    }
+    double seconds = bench_now_seconds() - t0;
+    printf("  %-6s measure %9ld chars %9.3f ms %7.2f ns/char (widths sum %.0f)\n",
+           name, *chars, seconds * 1e3, seconds * 1e9 / (double)*chars, *checksum);
+    return seconds;
+}
+
+static void layout_text(const BenchText* text) {
+    CLAY({ .id = CLAY_ID("log"),
+           .layout = { .sizing = { CLAY_SIZING_FIXED(700), CLAY_SIZING_FIT() }, .layoutDirection = CLAY_TOP_TO_BOTTOM } }) {
+        for (int i = 0; i < text->lineCount; i++) {
+            Clay_String line = { .length = (int32_t)strlen(text->lines[i]), .chars = text->lines[i] };
+            CLAY_TEXT(line, CLAY_TEXT_CONFIG({ .fontSize = 16, .lineHeight = 18, .wrapMode = CLAY_TEXT_WRAP_WORDS }));
+        }
+    }
+    for (int i = 0; i < BENCH_TOOLTIPS; i++) {
+        CLAY({ .id = CLAY_IDI("tooltip", i),
+               .layout = { .sizing = { CLAY_SIZING_FIT(), CLAY_SIZING_FIT() }, .padding = CLAY_PADDING_ALL(6) },
+               .floating = { .attachTo = CLAY_ATTACH_TO_ROOT, .offset = { (float)(i * 90), (float)(i * 40) } } }) {
+            Clay_String tip = { .length = (int32_t)strlen(text->tooltips[i]), .chars = text->tooltips[i] };
+            CLAY_TEXT(tip, CLAY_TEXT_CONFIG({ .fontSize = 14, .lineHeight = 16, .wrapMode = CLAY_TEXT_WRAP_NEWLINES }));
+        }
+    }
+}
+
+static double bench_layout(const char* name, MeasureFn fn, void* userData, BenchText* text, int frames) {
+    Clay_ResetMeasureTextCache();
+    Clay_SetMeasureTextFunction(fn, userData);
+    double seconds = 0.0;
+    for (int f = 0; f < frames; f++) {
+        write_text(text, f);
+        double t0 = bench_now_seconds();
+        Clay_BeginLayout();
+        layout_text(text);
+        Clay_EndLayout();
+        seconds += bench_now_seconds() - t0;
+    }
+    printf("  %-6s layout  %5d frames %9.3f ms %7.3f ms/frame\n", name, frames, seconds * 1e3, seconds * 1e3 / frames);
+    return seconds;
+}
+
+static void clay_error(Clay_ErrorData error) {
+    fprintf(stderr, "clay: %.*s\n", (int)error.errorText.length, error.errorText.chars);
+}
+
+int main(int argc, char** argv) {
+    int logLines = argc > 1 ? atoi(argv[1]) : 200;
+    int frames = argc > 2 ? atoi(argv[2]) : 500;
+    if (logLines <= 0) logLines = 200;
+    if (frames <= 0) frames = 500;
+
+    GlyphInfo glyphs[BENCH_GLYPHS];
+    Rectangle recs[BENCH_GLYPHS];
+    Font font = make_font(glyphs, recs);
+    GlyphAdvanceTable table;
+    GlyphAdvanceTable_build(&table, font);
+
+    BenchText text;
+    text.lineCount = logLines;
+    text.lines = malloc(sizeof(*text.lines) * logLines);
+    if (!text.lines) return 1;
+    write_text(&text, 0);
+
+    printf("bench_text: %d log lines, %d tooltips, %d frames\n", logLines, BENCH_TOOLTIPS, frames);
+    long chars;
+    float walkSum, tableSum;
+    double walk = bench_measure("walk", measure_walk, &font, &text, 200, &chars, &walkSum);
+    double tab = bench_measure("table", measure_table, &table, &text, 200, &chars, &tableSum);
+    printf("  measure speedup %.2fx%s\n", walk / tab, walkSum == tableSum ? "" : " (widths differ)");
+
+    uint32_t memorySize = Clay_MinMemorySize();
+    void* memory = malloc(memorySize);
+    if (!memory) return 1;
+    Clay_Arena arena = Clay_CreateArenaWithCapacityAndMemory(memorySize, memory);
+    Clay_Initialize(arena, (Clay_Dimensions){ 1600, 900 }, (Clay_ErrorHandler){ clay_error, 0 });
+    walk = bench_layout("walk", measure_walk, &font, &text, frames);
+    tab = bench_layout("table", measure_table, &table, &text, frames);
+    printf("  layout speedup %.2fx\n", walk / tab);
+
+    free(memory);
+    free(text.lines);
+    return 0;
+}
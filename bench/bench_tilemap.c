@@ -0,0 +1,131 @@
+#include "bench_common.h"
+
+#include <stdlib.h>
+
+#include "arena.h"
+#include "tilemap/tilemap.h"
+#include "components/world.h"
+
+// Compares the table-backed Tilemap against the sparse chunked World on:
+//   set  - fill every tile of the map once
+//   get  - random single-tile lookups
+//   scan - sum every tile, chunk by chunk
+//   pack/unpack - World only: palette/RLE compress every chunk, then decode on access
+//
+// Usage: bench_tilemap [mapSize] [randomLookups]
+
+static volatile unsigned long sink;
+
+static void bench_tilemap_table(int mapSize, long lookups) {
+    Arena_T arena = Arena_new();
+    Tilemap* tilemap = Tilemap_new(mapSize, mapSize, arena);
+    long tiles = (long)mapSize * mapSize;
+
+    double t0 = bench_now_seconds();
+    for (int y = 0; y < mapSize; y++) {
+        for (int x = 0; x < mapSize; x++) {
+            Tilemap_set_tile(tilemap, x, y, (uint16_t)((x % 8) / 2));
+        }
+    }
+    bench_report("Tilemap", "set", tiles, bench_now_seconds() - t0);
+
+    uint32_t rng = 0x9E3779B9u;
+    unsigned long sum = 0;
+    t0 = bench_now_seconds();
+    for (long i = 0; i < lookups; i++) {
+        int x = (int)(bench_rand(&rng) % (uint32_t)mapSize);
+        int y = (int)(bench_rand(&rng) % (uint32_t)mapSize);
+        Tile* tile = Tilemap_get_tile(tilemap, x, y);
+        if (tile) sum += tile->tile_id;
+    }
+    bench_report("Tilemap", "get", lookups, bench_now_seconds() - t0);
+
+    t0 = bench_now_seconds();
+    for (int cy = 0; cy < mapSize; cy += CHUNK_SIZE) {
+        for (int cx = 0; cx < mapSize; cx += CHUNK_SIZE) {
+            for (int y = cy; y < cy + CHUNK_SIZE && y < mapSize; y++) {
+                for (int x = cx; x < cx + CHUNK_SIZE && x < mapSize; x++) {
+                    Tile* tile = Tilemap_get_tile(tilemap, x, y);
+                    if (tile) sum += tile->tile_id;
+                }
+            }
+        }
+    }
+    bench_report("Tilemap", "scan", tiles, bench_now_seconds() - t0);
+
+    sink = sum;
+    Arena_dispose(&arena);
+}
+
+static void bench_world(int mapSize, long lookups) {
+    Arena_T arena = Arena_new();
+    World* world = World_new(arena);
+    long tiles = (long)mapSize * mapSize;
+
+    double t0 = bench_now_seconds();
+    for (int y = 0; y < mapSize; y++) {
+        for (int x = 0; x < mapSize; x++) {
+            World_set_tile(world, x, y, (uint16_t)((x % 8) / 2));
+        }
+    }
+    bench_report("World", "set", tiles, bench_now_seconds() - t0);
+
+    uint32_t rng = 0x9E3779B9u;
+    unsigned long sum = 0;
+    t0 = bench_now_seconds();
+    for (long i = 0; i < lookups; i++) {
+        int x = (int)(bench_rand(&rng) % (uint32_t)mapSize);
+        int y = (int)(bench_rand(&rng) % (uint32_t)mapSize);
+        uint16_t id = World_get_tile(world, x, y);
+        if (id != TILE_NONE) sum += id;
+    }
+    bench_report("World", "get", lookups, bench_now_seconds() - t0);
+
+    t0 = bench_now_seconds();
+    int lastChunk = Chunk_coord(mapSize - 1);
+    for (int cy = 0; cy <= lastChunk; cy++) {
+        for (int cx = 0; cx <= lastChunk; cx++) {
+            const uint16_t* tiles = World_get_chunk(world, cx, cy)->tiles;
+            for (int i = 0; i < CHUNK_AREA; i++) {
+                if (tiles[i] != TILE_NONE) sum += tiles[i];
+            }
+        }
+    }
+    bench_report("World", "scan", tiles, bench_now_seconds() - t0);
+
+    // Age every chunk out in one step, then touch them all again
+    long chunks = world->stats.residentChunks;
+    long rawBytes = world->stats.residentBytes;
+    World_enable_compression(world, 1);
+    World_evict_cold(world);
+    t0 = bench_now_seconds();
+    World_evict_cold(world);
+    bench_report("World", "pack", chunks, bench_now_seconds() - t0);
+    long packedBytes = world->stats.compressedBytes;
+
+    t0 = bench_now_seconds();
+    for (int cy = 0; cy <= lastChunk; cy++) {
+        for (int cx = 0; cx <= lastChunk; cx++) {
+            sum += World_get_chunk(world, cx, cy)->tiles[0];
+        }
+    }
+    bench_report("World", "unpack", chunks, bench_now_seconds() - t0);
+    printf("  World memory: %ld KiB raw, %ld KiB packed (%.1fx)\n",
+           rawBytes / 1024, packedBytes / 1024, packedBytes > 0 ? (double)rawBytes / (double)packedBytes : 0.0);
+
+    sink = sum;
+    World_free(world);
+    Arena_dispose(&arena);
+}
+
+int main(int argc, char** argv) {
+    int mapSize = argc > 1 ? atoi(argv[1]) : 1024;
+    long lookups = argc > 2 ? atol(argv[2]) : 4000000L;
+    if (mapSize <= 0) mapSize = 1024;
+    if (lookups <= 0) lookups = 4000000L;
+
+    printf("bench_tilemap: %dx%d tiles, %ld random lookups\n", mapSize, mapSize, lookups);
+    bench_tilemap_table(mapSize, lookups);
+    bench_world(mapSize, lookups);
+    return 0;
+}
@@ -28,3 +28,5 @@ Vector2 Camera_ScreenToWorld(const Camera2DEx *cam, AspectFit fit, Vector2 scree
 
 // Optional: clamp camera so view stays within bounds of a map of given size
 void Camera_ClampToBounds(Camera2DEx *cam, Vector2 mapPixelSize, AspectFit fit);
+// Same, for a world-space rectangle that need not start at the origin
+void Camera_ClampToRect(Camera2DEx *cam, Rectangle worldRect, AspectFit fit);
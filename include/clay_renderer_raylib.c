@@ -4,6 +4,7 @@
 #include "string.h"
 #include "stdio.h"
 #include "stdlib.h"
+#include "clay_renderer_raylib.h"
 
 #define CLAY_RECTANGLE_TO_RAYLIB_RECTANGLE(rectangle) (Rectangle) { .x = rectangle.x, .y = rectangle.y, .width = rectangle.width, .height = rectangle.height }
 #define CLAY_COLOR_TO_RAYLIB_COLOR(color) (Color) { .r = (unsigned char)roundf(color.r), .g = (unsigned char)roundf(color.g), .b = (unsigned char)roundf(color.b), .a = (unsigned char)roundf(color.a) }
@@ -135,131 +136,290 @@ void Clay_Raylib_Initialize(int width, int height, const char *title, unsigned i
 static char *temp_render_buffer = NULL;
 static int temp_render_buffer_len = 0;
 
+static void Clay_Raylib_FreeBatches(void);
+
 // Call after closing the window to clean up the render buffer
 void Clay_Raylib_Close()
 {
     if(temp_render_buffer) free(temp_render_buffer);
+    temp_render_buffer = NULL;
     temp_render_buffer_len = 0;
+    Clay_Raylib_FreeBatches();
 
     CloseWindow();
 }
 
 
-void Clay_Raylib_Render(Clay_RenderCommandArray renderCommands, Font* fonts)
+static void Clay_Raylib_DrawCommand(Clay_RenderCommandArray renderCommands, Clay_RenderCommand *renderCommand, Font* fonts)
 {
-    for (int j = 0; j < renderCommands.length; j++)
+    Clay_BoundingBox boundingBox = {roundf(renderCommand->boundingBox.x), roundf(renderCommand->boundingBox.y), roundf(renderCommand->boundingBox.width), roundf(renderCommand->boundingBox.height)};
+    switch (renderCommand->commandType)
     {
-        Clay_RenderCommand *renderCommand = Clay_RenderCommandArray_Get(&renderCommands, j);
-        Clay_BoundingBox boundingBox = {roundf(renderCommand->boundingBox.x), roundf(renderCommand->boundingBox.y), roundf(renderCommand->boundingBox.width), roundf(renderCommand->boundingBox.height)};
-        switch (renderCommand->commandType)
-        {
-            case CLAY_RENDER_COMMAND_TYPE_TEXT: {
-                Clay_TextRenderData *textData = &renderCommand->renderData.text;
-                Font fontToUse = fonts[textData->fontId];
-    
-                int strlen = textData->stringContents.length + 1;
-    
-                if(strlen > temp_render_buffer_len) {
-                    // Grow the temp buffer if we need a larger string
-                    if(temp_render_buffer) free(temp_render_buffer);
-                    temp_render_buffer = (char *) malloc(strlen);
-                    temp_render_buffer_len = strlen;
-                }
-    
-                // Raylib uses standard C strings so isn't compatible with cheap slices, we need to clone the string to append null terminator
-                memcpy(temp_render_buffer, textData->stringContents.chars, textData->stringContents.length);
-                temp_render_buffer[textData->stringContents.length] = '\0';
-                DrawTextEx(fontToUse, temp_render_buffer, (Vector2){boundingBox.x, boundingBox.y}, (float)textData->fontSize, (float)textData->letterSpacing, CLAY_COLOR_TO_RAYLIB_COLOR(textData->textColor));
-    
-                break;
+        case CLAY_RENDER_COMMAND_TYPE_TEXT: {
+            Clay_TextRenderData *textData = &renderCommand->renderData.text;
+            Font fontToUse = fonts[textData->fontId];
+
+            int strlen = textData->stringContents.length + 1;
+
+            if(strlen > temp_render_buffer_len) {
+                // Grow the temp buffer if we need a larger string
+                if(temp_render_buffer) free(temp_render_buffer);
+                temp_render_buffer = (char *) malloc(strlen);
+                temp_render_buffer_len = strlen;
             }
-            case CLAY_RENDER_COMMAND_TYPE_IMAGE: {
-                Texture2D imageTexture = *(Texture2D *)renderCommand->renderData.image.imageData;
-                Clay_Color tintColor = renderCommand->renderData.image.backgroundColor;
-                if (tintColor.r == 0 && tintColor.g == 0 && tintColor.b == 0 && tintColor.a == 0) {
-                    tintColor = (Clay_Color) { 255, 255, 255, 255 };
-                }
-                DrawTexturePro(
-                    imageTexture,
-                    (Rectangle) { 0, 0, imageTexture.width, imageTexture.height },
-                    (Rectangle){boundingBox.x, boundingBox.y, boundingBox.width, boundingBox.height},
-                    (Vector2) {},
-                    0,
-                    CLAY_COLOR_TO_RAYLIB_COLOR(tintColor));
-                break;
+
+            // Raylib uses standard C strings so isn't compatible with cheap slices, we need to clone the string to append null terminator
+            memcpy(temp_render_buffer, textData->stringContents.chars, textData->stringContents.length);
+            temp_render_buffer[textData->stringContents.length] = '\0';
+            DrawTextEx(fontToUse, temp_render_buffer, (Vector2){boundingBox.x, boundingBox.y}, (float)textData->fontSize, (float)textData->letterSpacing, CLAY_COLOR_TO_RAYLIB_COLOR(textData->textColor));
+
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_IMAGE: {
+            Texture2D imageTexture = *(Texture2D *)renderCommand->renderData.image.imageData;
+            Clay_Color tintColor = renderCommand->renderData.image.backgroundColor;
+            if (tintColor.r == 0 && tintColor.g == 0 && tintColor.b == 0 && tintColor.a == 0) {
+                tintColor = (Clay_Color) { 255, 255, 255, 255 };
             }
-            case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START: {
-                BeginScissorMode((int)roundf(boundingBox.x), (int)roundf(boundingBox.y), (int)roundf(boundingBox.width), (int)roundf(boundingBox.height));
-                break;
+            DrawTexturePro(
+                imageTexture,
+                (Rectangle) { 0, 0, imageTexture.width, imageTexture.height },
+                (Rectangle){boundingBox.x, boundingBox.y, boundingBox.width, boundingBox.height},
+                (Vector2) {},
+                0,
+                CLAY_COLOR_TO_RAYLIB_COLOR(tintColor));
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START: {
+            BeginScissorMode((int)roundf(boundingBox.x), (int)roundf(boundingBox.y), (int)roundf(boundingBox.width), (int)roundf(boundingBox.height));
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_SCISSOR_END: {
+            EndScissorMode();
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_RECTANGLE: {
+            Clay_RectangleRenderData *config = &renderCommand->renderData.rectangle;
+            if (config->cornerRadius.topLeft > 0) {
+                float radius = (config->cornerRadius.topLeft * 2) / (float)((boundingBox.width > boundingBox.height) ? boundingBox.height : boundingBox.width);
+                DrawRectangleRounded((Rectangle) { boundingBox.x, boundingBox.y, boundingBox.width, boundingBox.height }, radius, 8, CLAY_COLOR_TO_RAYLIB_COLOR(config->backgroundColor));
+            } else {
+                DrawRectangle(boundingBox.x, boundingBox.y, boundingBox.width, boundingBox.height, CLAY_COLOR_TO_RAYLIB_COLOR(config->backgroundColor));
             }
-            case CLAY_RENDER_COMMAND_TYPE_SCISSOR_END: {
-                EndScissorMode();
-                break;
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_BORDER: {
+            Clay_BorderRenderData *config = &renderCommand->renderData.border;
+            // Left border
+            if (config->width.left > 0) {
+                DrawRectangle((int)roundf(boundingBox.x), (int)roundf(boundingBox.y + config->cornerRadius.topLeft), (int)config->width.left, (int)roundf(boundingBox.height - config->cornerRadius.topLeft - config->cornerRadius.bottomLeft), CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
             }
-            case CLAY_RENDER_COMMAND_TYPE_RECTANGLE: {
-                Clay_RectangleRenderData *config = &renderCommand->renderData.rectangle;
-                if (config->cornerRadius.topLeft > 0) {
-                    float radius = (config->cornerRadius.topLeft * 2) / (float)((boundingBox.width > boundingBox.height) ? boundingBox.height : boundingBox.width);
-                    DrawRectangleRounded((Rectangle) { boundingBox.x, boundingBox.y, boundingBox.width, boundingBox.height }, radius, 8, CLAY_COLOR_TO_RAYLIB_COLOR(config->backgroundColor));
-                } else {
-                    DrawRectangle(boundingBox.x, boundingBox.y, boundingBox.width, boundingBox.height, CLAY_COLOR_TO_RAYLIB_COLOR(config->backgroundColor));
-                }
-                break;
+            // Right border
+            if (config->width.right > 0) {
+                DrawRectangle((int)roundf(boundingBox.x + boundingBox.width - config->width.right), (int)roundf(boundingBox.y + config->cornerRadius.topRight), (int)config->width.right, (int)roundf(boundingBox.height - config->cornerRadius.topRight - config->cornerRadius.bottomRight), CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
             }
-            case CLAY_RENDER_COMMAND_TYPE_BORDER: {
-                Clay_BorderRenderData *config = &renderCommand->renderData.border;
-                // Left border
-                if (config->width.left > 0) {
-                    DrawRectangle((int)roundf(boundingBox.x), (int)roundf(boundingBox.y + config->cornerRadius.topLeft), (int)config->width.left, (int)roundf(boundingBox.height - config->cornerRadius.topLeft - config->cornerRadius.bottomLeft), CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
-                }
-                // Right border
-                if (config->width.right > 0) {
-                    DrawRectangle((int)roundf(boundingBox.x + boundingBox.width - config->width.right), (int)roundf(boundingBox.y + config->cornerRadius.topRight), (int)config->width.right, (int)roundf(boundingBox.height - config->cornerRadius.topRight - config->cornerRadius.bottomRight), CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
-                }
-                // Top border
-                if (config->width.top > 0) {
-                    DrawRectangle((int)roundf(boundingBox.x + config->cornerRadius.topLeft), (int)roundf(boundingBox.y), (int)roundf(boundingBox.width - config->cornerRadius.topLeft - config->cornerRadius.topRight), (int)config->width.top, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
-                }
-                // Bottom border
-                if (config->width.bottom > 0) {
-                    DrawRectangle((int)roundf(boundingBox.x + config->cornerRadius.bottomLeft), (int)roundf(boundingBox.y + boundingBox.height - config->width.bottom), (int)roundf(boundingBox.width - config->cornerRadius.bottomLeft - config->cornerRadius.bottomRight), (int)config->width.bottom, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
-                }
-                if (config->cornerRadius.topLeft > 0) {
-                    DrawRing((Vector2) { roundf(boundingBox.x + config->cornerRadius.topLeft), roundf(boundingBox.y + config->cornerRadius.topLeft) }, roundf(config->cornerRadius.topLeft - config->width.top), config->cornerRadius.topLeft, 180, 270, 10, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
-                }
-                if (config->cornerRadius.topRight > 0) {
-                    DrawRing((Vector2) { roundf(boundingBox.x + boundingBox.width - config->cornerRadius.topRight), roundf(boundingBox.y + config->cornerRadius.topRight) }, roundf(config->cornerRadius.topRight - config->width.top), config->cornerRadius.topRight, 270, 360, 10, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
-                }
-                if (config->cornerRadius.bottomLeft > 0) {
-                    DrawRing((Vector2) { roundf(boundingBox.x + config->cornerRadius.bottomLeft), roundf(boundingBox.y + boundingBox.height - config->cornerRadius.bottomLeft) }, roundf(config->cornerRadius.bottomLeft - config->width.bottom), config->cornerRadius.bottomLeft, 90, 180, 10, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
-                }
-                if (config->cornerRadius.bottomRight > 0) {
-                    DrawRing((Vector2) { roundf(boundingBox.x + boundingBox.width - config->cornerRadius.bottomRight), roundf(boundingBox.y + boundingBox.height - config->cornerRadius.bottomRight) }, roundf(config->cornerRadius.bottomRight - config->width.bottom), config->cornerRadius.bottomRight, 0.1, 90, 10, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
-                }
-                break;
+            // Top border
+            if (config->width.top > 0) {
+                DrawRectangle((int)roundf(boundingBox.x + config->cornerRadius.topLeft), (int)roundf(boundingBox.y), (int)roundf(boundingBox.width - config->cornerRadius.topLeft - config->cornerRadius.topRight), (int)config->width.top, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
             }
-            case CLAY_RENDER_COMMAND_TYPE_CUSTOM: {
-                Clay_CustomRenderData *config = &renderCommand->renderData.custom;
-                CustomLayoutElement *customElement = (CustomLayoutElement *)config->customData;
-                if (!customElement) continue;
-                switch (customElement->type) {
-                    case CUSTOM_LAYOUT_ELEMENT_TYPE_3D_MODEL: {
-                        Clay_BoundingBox rootBox = renderCommands.internalArray[0].boundingBox;
-                        float scaleValue = CLAY__MIN(CLAY__MIN(1, 768 / rootBox.height) * CLAY__MAX(1, rootBox.width / 1024), 1.5f);
-                        Ray positionRay = GetScreenToWorldPointWithZDistance((Vector2) { renderCommand->boundingBox.x + renderCommand->boundingBox.width / 2, renderCommand->boundingBox.y + (renderCommand->boundingBox.height / 2) + 20 }, Raylib_camera, (int)roundf(rootBox.width), (int)roundf(rootBox.height), 140);
-                        BeginMode3D(Raylib_camera);
-                            DrawModel(customElement->customData.model.model, positionRay.position, customElement->customData.model.scale * scaleValue, WHITE);        // Draw 3d model with texture
-                        EndMode3D();
-                        break;
-                    }
-                    default: break;
-                }
-                break;
+            // Bottom border
+            if (config->width.bottom > 0) {
+                DrawRectangle((int)roundf(boundingBox.x + config->cornerRadius.bottomLeft), (int)roundf(boundingBox.y + boundingBox.height - config->width.bottom), (int)roundf(boundingBox.width - config->cornerRadius.bottomLeft - config->cornerRadius.bottomRight), (int)config->width.bottom, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
             }
-            default: {
-                printf("Error: unhandled render command.");
-                exit(1);
+            if (config->cornerRadius.topLeft > 0) {
+                DrawRing((Vector2) { roundf(boundingBox.x + config->cornerRadius.topLeft), roundf(boundingBox.y + config->cornerRadius.topLeft) }, roundf(config->cornerRadius.topLeft - config->width.top), config->cornerRadius.topLeft, 180, 270, 10, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
+            }
+            if (config->cornerRadius.topRight > 0) {
+                DrawRing((Vector2) { roundf(boundingBox.x + boundingBox.width - config->cornerRadius.topRight), roundf(boundingBox.y + config->cornerRadius.topRight) }, roundf(config->cornerRadius.topRight - config->width.top), config->cornerRadius.topRight, 270, 360, 10, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
+            }
+            if (config->cornerRadius.bottomLeft > 0) {
+                DrawRing((Vector2) { roundf(boundingBox.x + config->cornerRadius.bottomLeft), roundf(boundingBox.y + boundingBox.height - config->cornerRadius.bottomLeft) }, roundf(config->cornerRadius.bottomLeft - config->width.bottom), config->cornerRadius.bottomLeft, 90, 180, 10, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
+            }
+            if (config->cornerRadius.bottomRight > 0) {
+                DrawRing((Vector2) { roundf(boundingBox.x + boundingBox.width - config->cornerRadius.bottomRight), roundf(boundingBox.y + boundingBox.height - config->cornerRadius.bottomRight) }, roundf(config->cornerRadius.bottomRight - config->width.bottom), config->cornerRadius.bottomRight, 0.1, 90, 10, CLAY_COLOR_TO_RAYLIB_COLOR(config->color));
+            }
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_CUSTOM: {
+            Clay_CustomRenderData *config = &renderCommand->renderData.custom;
+            CustomLayoutElement *customElement = (CustomLayoutElement *)config->customData;
+            if (!customElement) break;
+            switch (customElement->type) {
+                case CUSTOM_LAYOUT_ELEMENT_TYPE_3D_MODEL: {
+                    Clay_BoundingBox rootBox = renderCommands.internalArray[0].boundingBox;
+                    float scaleValue = CLAY__MIN(CLAY__MIN(1, 768 / rootBox.height) * CLAY__MAX(1, rootBox.width / 1024), 1.5f);
+                    Ray positionRay = GetScreenToWorldPointWithZDistance((Vector2) { renderCommand->boundingBox.x + renderCommand->boundingBox.width / 2, renderCommand->boundingBox.y + (renderCommand->boundingBox.height / 2) + 20 }, Raylib_camera, (int)roundf(rootBox.width), (int)roundf(rootBox.height), 140);
+                    BeginMode3D(Raylib_camera);
+                        DrawModel(customElement->customData.model.model, positionRay.position, customElement->customData.model.scale * scaleValue, WHITE);        // Draw 3d model with texture
+                    EndMode3D();
+                    break;
+                }
+                default: break;
             }
+            break;
+        }
+        default: {
+            printf("Error: unhandled render command.");
+            exit(1);
+        }
+    }
+}
+
+// Batching: raylib already merges consecutive draws that use the same
+// texture into one draw call, so the cost of a UI frame is the number of
+// texture changes, and Clay's painter's order alternates between the
+// shapes texture (rectangles, borders) and font atlases (text) on every
+// labelled panel. Between scissor changes, each command is moved back into
+// the latest earlier batch with its texture, provided it does not overlap
+// any batch drawn after that one, so the visible result is unchanged.
+// Scissor and custom commands end the current run of batches.
+typedef struct {
+    unsigned int texture;
+    Clay_BoundingBox bounds;  // union of the batch's commands
+    int count;
+} Clay_Raylib_Batch;
+
+static int *batch_of_command = NULL;  // per pending command
+static int *batch_order = NULL;       // pending commands grouped by batch
+static Clay_Raylib_Batch *batches = NULL;
+static int batch_capacity = 0;
+static Clay_RaylibRenderStats render_stats = {0};
+
+static void Clay_Raylib_FreeBatches(void)
+{
+    free(batch_of_command);
+    free(batch_order);
+    free(batches);
+    batch_of_command = NULL;
+    batch_order = NULL;
+    batches = NULL;
+    batch_capacity = 0;
+}
+
+static bool Clay_Raylib_ReserveBatches(int count)
+{
+    if (count <= batch_capacity) return true;
+    int *of = (int *) realloc(batch_of_command, sizeof(int) * count);
+    if (of) batch_of_command = of;
+    int *order = (int *) realloc(batch_order, sizeof(int) * count);
+    if (order) batch_order = order;
+    Clay_Raylib_Batch *grown = (Clay_Raylib_Batch *) realloc(batches, sizeof(Clay_Raylib_Batch) * count);
+    if (grown) batches = grown;
+    if (!of || !order || !grown) return false;
+    batch_capacity = count;
+    return true;
+}
+
+// Texture a command draws with; 0 for commands that end a batch run
+static unsigned int Clay_Raylib_CommandTexture(Clay_RenderCommand *renderCommand, Font* fonts)
+{
+    switch (renderCommand->commandType) {
+        case CLAY_RENDER_COMMAND_TYPE_TEXT: {
+            unsigned int id = fonts[renderCommand->renderData.text.fontId].texture.id;
+            return id != 0 ? id : GetFontDefault().texture.id;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_RECTANGLE:
+        case CLAY_RENDER_COMMAND_TYPE_BORDER:
+            return GetShapesTexture().id;
+        case CLAY_RENDER_COMMAND_TYPE_IMAGE:
+            return ((Texture2D *)renderCommand->renderData.image.imageData)->id;
+        default:
+            return 0;
+    }
+}
+
+static Clay_BoundingBox Clay_Raylib_CommandBounds(Clay_RenderCommand *renderCommand)
+{
+    Clay_BoundingBox box = renderCommand->boundingBox;
+    // Glyphs can reach below a line height smaller than the font size
+    if (renderCommand->commandType == CLAY_RENDER_COMMAND_TYPE_TEXT) {
+        box.height = CLAY__MAX(box.height, (float)renderCommand->renderData.text.fontSize);
+    }
+    return box;
+}
+
+static bool Clay_Raylib_Overlaps(Clay_BoundingBox a, Clay_BoundingBox b)
+{
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+static Clay_BoundingBox Clay_Raylib_Union(Clay_BoundingBox a, Clay_BoundingBox b)
+{
+    float x0 = CLAY__MIN(a.x, b.x), y0 = CLAY__MIN(a.y, b.y);
+    float x1 = CLAY__MAX(a.x + a.width, b.x + b.width), y1 = CLAY__MAX(a.y + a.height, b.y + b.height);
+    return (Clay_BoundingBox) { x0, y0, x1 - x0, y1 - y0 };
+}
+
+// Draws commands [first, end) batch by batch, each batch in command order
+static void Clay_Raylib_FlushBatches(Clay_RenderCommandArray renderCommands, int first, int end, int batchCount, Font* fonts)
+{
+    if (first == end) return;
+    int offset = 0;
+    for (int b = 0; b < batchCount; b++) {
+        int count = batches[b].count;
+        batches[b].count = offset;
+        offset += count;
+    }
+    for (int j = first; j < end; j++) {
+        batch_order[batches[batch_of_command[j - first]].count++] = j;
+    }
+    for (int k = 0; k < end - first; k++) {
+        Clay_Raylib_DrawCommand(renderCommands, Clay_RenderCommandArray_Get(&renderCommands, batch_order[k]), fonts);
+    }
+    render_stats.batches += batchCount;
+}
+
+void Clay_Raylib_Render(Clay_RenderCommandArray renderCommands, Font* fonts)
+{
+    render_stats = (Clay_RaylibRenderStats) {0};
+    render_stats.commands = renderCommands.length;
+    bool batching = Clay_Raylib_ReserveBatches(renderCommands.length);
+
+    int first = 0;
+    int batchCount = 0;
+    unsigned int lastTexture = 0;
+    for (int j = 0; j < renderCommands.length; j++)
+    {
+        Clay_RenderCommand *renderCommand = Clay_RenderCommandArray_Get(&renderCommands, j);
+        unsigned int texture = Clay_Raylib_CommandTexture(renderCommand, fonts);
+        if (texture != 0 && texture != lastTexture) render_stats.unbatchedRuns++;
+        if (texture != 0) lastTexture = texture;
+
+        if (!batching) {
+            Clay_Raylib_DrawCommand(renderCommands, renderCommand, fonts);
+            continue;
+        }
+        if (texture == 0) {
+            Clay_Raylib_FlushBatches(renderCommands, first, j, batchCount, fonts);
+            Clay_Raylib_DrawCommand(renderCommands, renderCommand, fonts);
+            first = j + 1;
+            batchCount = 0;
+            continue;
+        }
+
+        Clay_BoundingBox box = Clay_Raylib_CommandBounds(renderCommand);
+        int batch = -1;
+        for (int b = batchCount - 1; b >= 0; b--) {
+            if (batches[b].texture == texture) { batch = b; break; }
+            if (Clay_Raylib_Overlaps(batches[b].bounds, box)) break;
         }
+        if (batch < 0) {
+            batch = batchCount++;
+            batches[batch] = (Clay_Raylib_Batch) { texture, box, 0 };
+        } else {
+            batches[batch].bounds = Clay_Raylib_Union(batches[batch].bounds, box);
+        }
+        batches[batch].count++;
+        batch_of_command[j - first] = batch;
+    }
+    if (batching) {
+        Clay_Raylib_FlushBatches(renderCommands, first, renderCommands.length, batchCount, fonts);
+    } else {
+        render_stats.batches = render_stats.unbatchedRuns;
     }
 }
+
+Clay_RaylibRenderStats Clay_Raylib_GetRenderStats(void)
+{
+    return render_stats;
+}
@@ -5,8 +5,9 @@
 #include "clay.h"
 
 // This header provides declarations for the Clay ↔ Raylib renderer integration.
-// The implementation is compiled once by including `raylib/clay_renderer_raylib.c`
-// from a single translation unit (currently `src/main.c`).
+// The implementation is compiled once by including `clay_renderer_raylib.c`
+// (next to this header) from a single translation unit; bench_clay_render
+// does, which keeps it building against the current raylib and Clay.
 
 extern Camera Raylib_camera;
 
@@ -14,8 +15,20 @@ Ray GetScreenToWorldPointWithZDistance(Vector2 position, Camera camera, int scre
 
 void Clay_Raylib_Initialize(int width, int height, const char *title, unsigned int flags);
 void Clay_Raylib_Close(void);
+// Draws the commands, regrouping non-overlapping draws between scissor
+// changes so those sharing a texture reach raylib back to back and share a
+// draw call. The picture is the same as drawing them in order.
 void Clay_Raylib_Render(Clay_RenderCommandArray renderCommands, Font* fonts);
 
+// Counts from the last Clay_Raylib_Render
+typedef struct Clay_RaylibRenderStats {
+    int commands;
+    int batches;        // texture runs after regrouping
+    int unbatchedRuns;  // texture runs in Clay's order
+} Clay_RaylibRenderStats;
+
+Clay_RaylibRenderStats Clay_Raylib_GetRenderStats(void);
+
 #endif // CLAY_RENDERER_RAYLIB_H
 
 
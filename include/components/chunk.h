@@ -1,50 +1,144 @@
-// #ifndef CHUNK_H
-// #define CHUNK_H
-
-// #include "tile.h"
-// #include "arena.h"
-// #include "table.h"
-// #include "int_coord_hash.h"
-
-// typedef struct Chunk {
-//     int chunkX, chunkY;
-//     Table_T tileLookup;
-//     Arena_T tileArena;
-//     bool isLoaded;
-// } Chunk;
-
-// /// @brief  Creates a new chunk at the specified coordinates
-// /// @param x 
-// /// @param y 
-// /// @return 
-// Chunk* Chunk_new(int x, int y);
-// /// @brief Loads the chunk data into memory (file, db, etc)
-// /// @param chunk 
-// void Chunk_load(Chunk *chunk);
-// /// @brief Unloads the chunk data from memory and saves it (file, db, etc)
-// /// @param chunk
-// void Chunk_unload(Chunk *chunk);
-// /// @brief Sets a tile at the specified coordinates within the chunk
-// /// @param chunk 
-// /// @param x 
-// /// @param y 
-// /// @param tile_id
-// void Chunk_set_tile(Chunk *chunk, int x, int y, Tile *tile);
-// /// @brief Gets a tile at the specified coordinates within the chunk
-// /// @param chunk 
-// /// @param x 
-// /// @param y 
-// /// @return Tile*
-// Tile* Chunk_get_tile(Chunk *chunk, int x, int y);
-// /// @brief Moves an entity from one chunk to another
-// /// @param fromChunk 
-// /// @param toChunk 
-// /// @param entityId
-// void Chunk_move_entity_to_Chunk(Chunk *fromChunk, Chunk *toChunk, int entityId);
-// /// @brief Offloads an entity from the chunk to the world (removes from chunk)
-// /// @param fromChunk 
-// /// @param entityId
-// void Chunk_offload_entity_to_world(Chunk *fromChunk, int entityId);
-
-
-// #endif //CHUNK_H
\ No newline at end of file
+#ifndef CHUNK_H
+#define CHUNK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "arena.h"
+
+/// Chunks are fixed 64x64 tile squares (same size the chunk renderer caches).
+/// Keeping the size a power of two turns world->chunk conversion into shifts
+/// and masks, which also floor correctly for negative tile coordinates.
+#define CHUNK_SHIFT 6
+#define CHUNK_SIZE (1 << CHUNK_SHIFT)
+#define CHUNK_MASK (CHUNK_SIZE - 1)
+#define CHUNK_AREA (CHUNK_SIZE * CHUNK_SIZE)
+
+/// Dirty tracking splits a chunk into 8x8 blocks of CHUNK_SIZE / 8 tiles,
+/// one bit each in Chunk.dirtyBlocks
+#define CHUNK_DIRTY_SHIFT (CHUNK_SHIFT - 3)
+#define CHUNK_DIRTY_BLOCK (1 << CHUNK_DIRTY_SHIFT)
+#define CHUNK_DIRTY_BLOCKS 8
+#define CHUNK_DIRTY_ALL (~(uint64_t)0)
+
+/// Tile id stored in cells that hold no tile (outside the map, unset)
+#define TILE_NONE ((uint16_t)0xFFFF)
+
+struct RegionStore;
+
+/// @brief Dense block of tiles stored as one contiguous row-major array.
+/// The struct lives in the world's arena for the whole session. While the
+/// chunk is cold its tile array is replaced by a compressed copy (packed) or
+/// paged out to a region file and freed.
+typedef struct Chunk {
+    int chunkX;
+    int chunkY;
+    uint32_t revision;   // bumped whenever tiles change, consumers compare against it
+    uint64_t dirtyBlocks;    // bit blockY * 8 + blockX per block changed since dirtyRevision
+    uint32_t dirtyRevision;  // revision when dirtyBlocks was last cleared (by the map renderer)
+    uint16_t* tiles;     // CHUNK_AREA tile ids, index = localY * CHUNK_SIZE + localX; NULL unless resident
+
+    // Paging state, owned by World
+    bool resident;             // tiles are in memory
+    bool cold;                 // on the World's cold list (aged out, possibly compressed)
+    bool stored;               // the region store holds a copy
+    bool loading;              // handed to an asynchronous loader, not back yet
+    uint32_t storedRevision;   // revision of that copy
+    bool generated;            // produced by the World's generator
+    bool generating;           // first generation handed to the loader: no tiles yet, not in the World's bounds
+    uint32_t generatedRevision; // revision right after generation; while equal the chunk is dropped, not written, on eviction
+    uint8_t* packed;           // ChunkCodec encoding of the tiles while compressed, else NULL
+    uint32_t packedSize;
+    uint32_t lastUsedFrame;    // World frame of the last lookup
+    struct Chunk* lruPrev;     // towards the most recently used chunk of its list
+    struct Chunk* lruNext;     // towards the least recently used chunk of its list
+
+    // Save state, owned by World
+    uint32_t savedRevision;    // revision captured by the last World_freeze
+    bool shared;               // tiles/packed is also referenced by a frozen snapshot; clone before writing
+    bool pinned;               // a frozen snapshot reads the stored copy; it must not be rewritten
+} Chunk;
+
+/// @brief Converts a tile coordinate to the coordinate of its chunk
+static inline int Chunk_coord(int tile) { return tile >> CHUNK_SHIFT; }
+
+/// @brief Converts a tile coordinate to its offset inside its chunk
+static inline int Chunk_local(int tile) { return tile & CHUNK_MASK; }
+
+/// @brief Index of a local tile inside Chunk.tiles
+static inline int Chunk_index(int localX, int localY) { return (localY << CHUNK_SHIFT) | localX; }
+
+/// @brief Marks the dirty block holding a local tile
+static inline void Chunk_mark_dirty(Chunk* chunk, int localX, int localY) {
+    chunk->dirtyBlocks |= (uint64_t)1 << (((localY >> CHUNK_DIRTY_SHIFT) * CHUNK_DIRTY_BLOCKS) + (localX >> CHUNK_DIRTY_SHIFT));
+}
+
+/// @brief Marks every dirty block overlapping a local rectangle
+void Chunk_mark_dirty_rect(Chunk* chunk, int localX, int localY, int width, int height);
+
+/// @brief Forgets the dirty blocks. A consumer that drew the chunk at dirtyRevision
+/// only has to redraw dirtyBlocks to catch up; any other consumer redraws all of it.
+static inline void Chunk_clear_dirty(Chunk* chunk) {
+    chunk->dirtyBlocks = 0;
+    chunk->dirtyRevision = chunk->revision;
+}
+
+/// @brief Creates a new resident chunk at the specified chunk coordinates with every tile set to fill.
+/// The struct is allocated from the arena, the tile array from the heap so it can be paged out.
+/// @param arena NULL allocates the struct from the heap too (the caller frees it)
+/// @param chunkX
+/// @param chunkY
+/// @param fill
+/// @return Chunk*
+Chunk* Chunk_new(Arena_T arena, int chunkX, int chunkY, uint16_t fill);
+/// @brief Sets every tile in the chunk to tile_id
+/// @param chunk
+/// @param tile_id
+void Chunk_fill(Chunk* chunk, uint16_t tile_id);
+
+/// @brief Gives the chunk a private copy of its tiles if a snapshot shares them
+/// @param chunk
+/// @return false if the copy could not be allocated (the chunk must not be written)
+bool Chunk_unshare(Chunk* chunk);
+
+/// @brief Gets a tile at the specified local coordinates within the chunk
+static inline uint16_t Chunk_get_tile(const Chunk* chunk, int localX, int localY) {
+    return chunk->tiles[Chunk_index(localX, localY)];
+}
+
+/// @brief Sets a tile at the specified local coordinates within the chunk
+static inline void Chunk_set_tile(Chunk* chunk, int localX, int localY, uint16_t tile_id) {
+    int index = Chunk_index(localX, localY);
+    if (chunk->tiles[index] == tile_id) return;
+    if (chunk->shared && !Chunk_unshare(chunk)) return;
+    chunk->tiles[index] = tile_id;
+    chunk->revision++;
+    Chunk_mark_dirty(chunk, localX, localY);
+}
+
+/// @brief Releases the tile array and any compressed copy (the struct belongs to the arena).
+/// A buffer shared with a snapshot is left to the snapshot.
+/// @param chunk
+void Chunk_free(Chunk* chunk);
+
+/// @brief Replaces the tile array with its palette/RLE encoding
+/// @param chunk
+/// @return false if the chunk does not compress (it then stays resident)
+bool Chunk_compress(Chunk* chunk);
+/// @brief Restores the tile array from the compressed copy
+/// @param chunk
+/// @return false if the tile array could not be allocated
+bool Chunk_decompress(Chunk* chunk);
+
+/// @brief Loads the chunk data into memory from its compressed copy or the region store
+/// @param chunk
+/// @param store
+/// @return false if the tile array could not be allocated or read back
+bool Chunk_load(Chunk* chunk, struct RegionStore* store);
+/// @brief Unloads the chunk data from memory, saving it to the region store first if it changed
+/// @param chunk
+/// @param store
+/// @return false if the save failed; the chunk then stays resident
+bool Chunk_unload(Chunk* chunk, struct RegionStore* store);
+
+#endif // CHUNK_H
@@ -0,0 +1,29 @@
+#ifndef CHUNK_CODEC_H
+#define CHUNK_CODEC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "components/chunk.h"
+
+/// Palette + run-length encoding for a chunk's tile array.
+/// Tiles are mapped to indices into a palette of at most 256 distinct ids,
+/// then stored either as runs (uint8 length - 1, uint8 index) or as indices
+/// bit-packed at 1, 2, 4 or 8 bits, whichever is smaller. Floors of a single
+/// tile collapse to a few dozen bytes; striped or noisy chunks still shrink
+/// to a fraction of the raw 8 KiB through packing.
+///
+/// Layout: uint8 mode, uint8 bitsPerIndex, uint16 paletteCount,
+/// uint16 palette[paletteCount], body.
+#define CHUNK_CODEC_RAW_SIZE ((uint32_t)(CHUNK_AREA * sizeof(uint16_t)))
+#define CHUNK_CODEC_MODE_RLE 1
+#define CHUNK_CODEC_MODE_PACKED 2
+
+/// @brief Encodes a chunk's tiles into out (capacity CHUNK_CODEC_RAW_SIZE)
+/// @return encoded size, 0 if the chunk has more than 256 distinct tiles or would not shrink
+uint32_t ChunkCodec_encode(const uint16_t* tiles, uint8_t* out);
+/// @brief Decodes an encoded chunk into tiles (CHUNK_AREA entries)
+/// @return false if the data is malformed
+bool ChunkCodec_decode(const uint8_t* in, uint32_t size, uint16_t* tiles);
+
+#endif // CHUNK_CODEC_H
@@ -0,0 +1,41 @@
+#ifndef CHUNKMAP_H
+#define CHUNKMAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/// @brief Slot of a ChunkMap. A slot is empty when value is NULL.
+typedef struct ChunkMapEntry {
+    int chunkX;
+    int chunkY;
+    void* value;
+} ChunkMapEntry;
+
+/// @brief Open-addressing hash table keyed by chunk coordinate.
+/// Linear probing over a power-of-two slot array, kept at most 3/4 full,
+/// with backward-shift deletion so lookups never walk tombstones.
+/// Iterate by scanning entries[0..capacity) and skipping NULL values.
+typedef struct ChunkMap {
+    ChunkMapEntry* entries;
+    int capacity;
+    int count;
+} ChunkMap;
+
+/// @brief Initializes an empty map able to hold initialCapacity entries before growing
+/// @param map
+/// @param initialCapacity
+void ChunkMap_init(ChunkMap* map, int initialCapacity);
+/// @brief Releases the slot array (values are not owned by the map)
+/// @param map
+void ChunkMap_free(ChunkMap* map);
+
+/// @brief Gets the value stored at chunk coordinates, NULL if absent
+void* ChunkMap_get(const ChunkMap* map, int chunkX, int chunkY);
+/// @brief Stores value (non-NULL) at chunk coordinates, replacing any previous value
+void ChunkMap_put(ChunkMap* map, int chunkX, int chunkY, void* value);
+/// @brief Removes the entry at chunk coordinates
+/// @return the removed value, NULL if absent
+void* ChunkMap_remove(ChunkMap* map, int chunkX, int chunkY);
+
+#endif // CHUNKMAP_H
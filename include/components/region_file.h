@@ -0,0 +1,78 @@
+#ifndef REGION_FILE_H
+#define REGION_FILE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "components/chunk.h"
+
+/// Region files hold a 32x32 block of chunks each, named r.<regionX>.<regionY>.bin.
+/// Layout: 8 byte header ("GRRG" + uint32 version), an index of one uint32
+/// per chunk (row-major by local chunk coordinate), then two fixed-size slots
+/// per chunk. An index entry is the payload length (0 = empty) with
+/// REGION_INDEX_SLOT set when the payload is in the chunk's second slot.
+/// A write fills the slot the index does not point at and only then rewrites
+/// the index entry, so an interrupted write leaves the previous copy readable,
+/// the same way the save manifest is replaced through a temporary file.
+/// Payloads are raw native-endian tile arrays; the files are a page store for
+/// the running world, not a portable save format.
+#define REGION_SHIFT 5
+#define REGION_SIZE (1 << REGION_SHIFT)
+#define REGION_MASK (REGION_SIZE - 1)
+#define REGION_AREA (REGION_SIZE * REGION_SIZE)
+#define REGION_VERSION 2u
+#define REGION_HEADER_SIZE 8
+#define REGION_INDEX_SIZE (REGION_AREA * 4)
+#define REGION_INDEX_SLOT 0x80000000u
+#define REGION_SLOT_PAYLOAD (CHUNK_AREA * (int)sizeof(uint16_t))
+#define REGION_PATH_MAX 512
+
+/// @brief Directory of region files. Keeps the most recently used region file
+/// open, since paging walks neighbouring chunks.
+/// Files are unbuffered so several stores (one per loader thread) on the
+/// same directory always see each other's completed writes.
+typedef struct RegionStore {
+    char directory[REGION_PATH_MAX];
+    bool readOnly;
+    bool scratch;  // page cache: a region file with an unknown header is started over
+    FILE* file;
+    int regionX;
+    int regionY;
+} RegionStore;
+
+/// @brief Opens a region store, creating the directory if needed.
+/// A region file whose header is not this version's is never overwritten:
+/// reads and writes to its chunks fail.
+/// @param store
+/// @param directory
+/// @return false if the directory cannot be created
+bool RegionStore_open(RegionStore* store, const char* directory);
+/// @brief Opens a store for data that can be rebuilt (the World's page cache):
+/// like RegionStore_open, but region files with an unknown header are truncated and started over
+/// @param store
+/// @param directory
+/// @return false if the directory cannot be created
+bool RegionStore_open_scratch(RegionStore* store, const char* directory);
+/// @brief Opens a store that only reads existing region files (for loader threads)
+/// @param store
+/// @param directory
+/// @return false if the path is too long
+bool RegionStore_open_readonly(RegionStore* store, const char* directory);
+/// @brief Flushes and closes the cached region file
+/// @param store
+void RegionStore_close(RegionStore* store);
+
+/// @brief Writes a chunk payload (at most REGION_SLOT_PAYLOAD bytes) into its free slot, then points the index at it
+bool RegionStore_write(RegionStore* store, int chunkX, int chunkY, const void* payload, uint32_t length);
+/// @brief Reads a chunk payload into buffer (REGION_SLOT_PAYLOAD bytes)
+/// @return payload length, 0 if the slot is empty or unreadable
+uint32_t RegionStore_read(RegionStore* store, int chunkX, int chunkY, void* buffer);
+
+/// @brief Writes a chunk's tiles, encoded with ChunkCodec when that is smaller
+bool RegionStore_write_tiles(RegionStore* store, int chunkX, int chunkY, const uint16_t* tiles);
+/// @brief Reads a chunk's tiles (CHUNK_AREA entries), decoding them if needed
+/// @return false if the slot is empty or malformed
+bool RegionStore_read_tiles(RegionStore* store, int chunkX, int chunkY, uint16_t* tiles);
+
+#endif // REGION_FILE_H
@@ -4,8 +4,8 @@
 #include "raylib.h"
 
 typedef struct ScreenBuffer {
-    RenderTexture2D renderFrame;
-    RenderTexture2D renderFrameTemp;
+    RenderTexture2D renderFrame;  // the composited frame, at window size
+    RenderTexture2D worldFrame;   // map and entities at the camera's logical size
 } ScreenBuffer;
 
 #endif // SCREENBUFFER_H
\ No newline at end of file
@@ -0,0 +1,87 @@
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gramarye_ecs/ecs.h"
+#include "components/chunkmap.h"
+
+#define SPATIAL_CELL_SHIFT 4
+#define SPATIAL_CELL_SIZE (1 << SPATIAL_CELL_SHIFT)  // tiles per cell side
+
+/// @brief One indexed entity, identified by the handle SpatialIndex_insert returned
+typedef struct SpatialItem {
+    EntityId entity;
+    int x;          // tile position
+    int y;
+    int cellSlot;   // index in its cell's handle array, -1 when the handle is free
+    int nextFree;
+} SpatialItem;
+
+/// @brief Handles of the items whose position falls in one cell
+typedef struct SpatialCell {
+    int* handles;
+    int count;
+    int capacity;
+    int cellX;
+    int cellY;
+    int occupiedSlot;  // index in SpatialIndex.occupied
+} SpatialCell;
+
+/// @brief Result of a query
+typedef struct SpatialHit {
+    EntityId entity;
+    int handle;
+    int x;
+    int y;
+} SpatialHit;
+
+/// @brief Uniform grid of SPATIAL_CELL_SIZE-tile cells over entity tile
+/// positions. Cells are found through a ChunkMap keyed by cell coordinate,
+/// so the grid is unbounded and only occupied cells use memory. Positions
+/// live in the index, kept in step by calling SpatialIndex_move wherever
+/// Position_set moves an indexed entity (SpatialIndex_set_position does both).
+/// A query looks up each cell overlapping its rectangle, or, when the
+/// rectangle spans more cells than are occupied, scans the occupied cells
+/// instead, so it costs the smaller of the two plus the entities returned.
+typedef struct SpatialIndex {
+    ChunkMap cells;  // (cellX, cellY) -> SpatialCell*
+    SpatialCell** occupied;  // every cell in cells, unordered
+    int occupiedCount;
+    int occupiedCapacity;
+    SpatialItem* items;  // indexed by handle
+    int itemCount;       // live handles
+    int itemEnd;         // handles ever issued; items[itemEnd..] are unused
+    int itemCapacity;
+    int freeHead;        // first released handle, -1 if none
+    uint32_t revision;   // bumped by every insert, remove and position change
+} SpatialIndex;
+
+/// @brief Cell coordinate of a tile coordinate (floors, so negatives work)
+static inline int SpatialIndex_cell(int tile) { return tile >> SPATIAL_CELL_SHIFT; }
+
+void SpatialIndex_init(SpatialIndex* index, int initialCapacity);
+/// @brief Releases cells and items (entities are not touched)
+void SpatialIndex_free(SpatialIndex* index);
+
+/// @brief Adds an entity at a tile position
+/// @return a handle for move/remove, -1 if out of memory
+int SpatialIndex_insert(SpatialIndex* index, EntityId entity, int x, int y);
+/// @brief Moves a handle to a new tile position; changes cells only when it crosses one
+void SpatialIndex_move(SpatialIndex* index, int handle, int x, int y);
+void SpatialIndex_remove(SpatialIndex* index, int handle);
+
+/// @brief Position_set plus SpatialIndex_move, for indexed entities
+void SpatialIndex_set_position(SpatialIndex* index, int handle, ECS* ecs, ComponentTypeId positionTypeId, int x, int y);
+
+/// @brief Entities with x <= tileX < x + width and y <= tileY < y + height, in no particular order
+/// @return the number of matches; at most maxHits are written to hits, so a
+/// caller whose buffer was too small can grow it and query again
+int SpatialIndex_query_rect(const SpatialIndex* index, int x, int y, int width, int height,
+                            SpatialHit* hits, int maxHits);
+/// @brief Entities within radius tiles (Euclidean) of a tile, same contract as query_rect
+int SpatialIndex_query_radius(const SpatialIndex* index, int centerX, int centerY, int radius,
+                              SpatialHit* hits, int maxHits);
+
+#endif // SPATIAL_INDEX_H
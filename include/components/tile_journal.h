@@ -0,0 +1,61 @@
+#ifndef TILE_JOURNAL_H
+#define TILE_JOURNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "components/world.h"
+
+// Record types. Every record is a type byte followed by int32 fields in
+// native byte order, the same convention as region files.
+#define TILE_JOURNAL_SET 1   // x, y, tile
+#define TILE_JOURNAL_FILL 2  // x, y, width, height, tile
+#define TILE_JOURNAL_BLIT 3  // x, y, width, height, then width * height uint16 tiles
+#define TILE_JOURNAL_COPY 4  // srcX, srcY, width, height, dstX, dstY; replayed, no longer written
+
+/// @brief Append-only buffer of encoded tile edits.
+/// Replaying the records in order onto the world they were recorded against
+/// reproduces every edit, so a journal plus the state it started from is a save.
+typedef struct TileJournal {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    long records;
+} TileJournal;
+
+/// @brief Initializes an empty journal
+/// @param journal
+void TileJournal_init(TileJournal* journal);
+/// @brief Releases the journal's buffer
+/// @param journal
+void TileJournal_free(TileJournal* journal);
+/// @brief Drops every record, keeping the buffer
+/// @param journal
+void TileJournal_clear(TileJournal* journal);
+/// @brief Appends raw encoded records (e.g. another journal's data)
+/// @return false if out of memory
+bool TileJournal_append(TileJournal* journal, const uint8_t* data, size_t size);
+
+// Recording, mirroring the World edit functions. Each returns false if out of memory.
+
+/// @brief Records World_set_tile
+bool TileJournal_set(TileJournal* journal, int x, int y, uint16_t tile_id);
+/// @brief Records World_fill_rect
+bool TileJournal_fill(TileJournal* journal, int x, int y, int width, int height, uint16_t tile_id);
+/// @brief Records World_blit (the tiles are copied, so src may be reused)
+bool TileJournal_blit(TileJournal* journal, int x, int y, int width, int height, const uint16_t* src, int srcStride);
+/// @brief Records World_copy_region, after it ran, as a BLIT of the destination.
+/// A COPY record reads tiles that a partly saved snapshot may already have
+/// changed, so replaying it twice could differ; the copied tiles replay the same.
+/// @param world the world the copy was applied to
+bool TileJournal_copy(TileJournal* journal, World* world, int dstX, int dstY, int width, int height);
+
+/// @brief Applies encoded records to the world in order
+/// @param world
+/// @param data
+/// @param size
+/// @return records applied, -1 if the data is truncated or malformed (records before it are applied)
+long TileJournal_replay(World* world, const uint8_t* data, size_t size);
+
+#endif // TILE_JOURNAL_H
@@ -0,0 +1,65 @@
+#ifndef TILE_STORAGE_H
+#define TILE_STORAGE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "arena.h"
+#include "tilemap/tilemap.h"
+#include "components/world.h"
+
+/// @brief Backend holding the map's tiles
+typedef enum TileStorageMode {
+    TILE_STORAGE_TABLE,    // Tilemap: fixed width x height table, drawn by ChunkManagerSystem + ChunkRenderSystem
+    TILE_STORAGE_CHUNKED   // World: sparse 64x64 chunk arrays, drawn by MapRenderSystem
+} TileStorageMode;
+
+/// @brief The map's tiles, in either backend, behind the Tilemap calls.
+/// Table storage is the existing Tilemap. Chunked storage is a World, where
+/// every chunk is one contiguous uint16_t array and a lookup is a chunk
+/// pointer plus an index; streaming, paging, generation and saves only exist
+/// in this mode. Reads outside the map return TILE_NONE, and writes outside
+/// the table are dropped.
+typedef struct TileStorage {
+    TileStorageMode mode;
+    Tilemap* tilemap;  // TILE_STORAGE_TABLE
+    World* world;      // TILE_STORAGE_CHUNKED
+    int width;         // table size in tiles; the world has no fixed size
+    int height;
+} TileStorage;
+
+/// @brief Creates a width x height Tilemap in arena
+/// @return false if it cannot be allocated
+bool TileStorage_init_table(TileStorage* storage, Arena_T arena, int width, int height);
+/// @brief Creates an empty World in arena
+/// @return false if it cannot be allocated
+bool TileStorage_init_chunked(TileStorage* storage, Arena_T arena);
+/// @brief Frees the world; a Tilemap belongs to its arena
+void TileStorage_free(TileStorage* storage);
+
+/// @brief Gets the tile id at tile coordinates, TILE_NONE outside the map
+uint16_t TileStorage_get_tile(TileStorage* storage, int x, int y);
+/// @brief Sets the tile id at tile coordinates
+void TileStorage_set_tile(TileStorage* storage, int x, int y, uint16_t tile_id);
+
+/// @brief Gets the tile-space rectangle the map covers
+/// @return false if there are no tiles yet
+bool TileStorage_get_bounds(const TileStorage* storage, int* outX, int* outY, int* outWidth, int* outHeight);
+/// @brief Clips a rectangle to the tiles a write can reach (the table; the world is unbounded)
+/// @return false if nothing is left
+bool TileStorage_clip(const TileStorage* storage, int* x, int* y, int* width, int* height);
+
+// Bulk region operations, clipped to the map. Each returns the number of
+// CHUNK_SIZE blocks touched; chunked storage bumps each chunk's revision once.
+// The table is written a row at a time and keeps no dirty state of its own:
+// TileUpdateSystem marks the blocks in ChunkManagerSystem.
+
+/// @brief Sets every tile in the rectangle to tile_id
+int TileStorage_fill_rect(TileStorage* storage, int x, int y, int width, int height, uint16_t tile_id);
+/// @brief Copies a width x height block of tile ids from src into the map
+/// @param srcStride tiles between source rows, 0 repeats the first row
+int TileStorage_blit(TileStorage* storage, int x, int y, int width, int height, const uint16_t* src, int srcStride);
+/// @brief Copies a region of the map onto another (overlap safe); source tiles outside the map copy as TILE_NONE
+int TileStorage_copy_region(TileStorage* storage, int srcX, int srcY, int width, int height, int dstX, int dstY);
+
+#endif // TILE_STORAGE_H
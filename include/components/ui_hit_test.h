@@ -0,0 +1,37 @@
+#ifndef UI_HIT_TEST_H
+#define UI_HIT_TEST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "raylib.h"
+
+#define UI_HIT_TEST_MAX_REGIONS 16
+
+/// @brief Screen rectangle of one laid-out UI element
+typedef struct UIHitRegion {
+    uint32_t id;       // Clay element id
+    Rectangle bounds;
+    int16_t zIndex;
+    bool captures;     // false for passthrough elements, which never block the pointer
+} UIHitRegion;
+
+/// @brief Bounding boxes recorded from the last completed UI layout, highest
+/// zIndex first (equal zIndex in the order added). Lets pointer blocking be
+/// answered between layouts without running one.
+typedef struct UIHitTest {
+    UIHitRegion regions[UI_HIT_TEST_MAX_REGIONS];
+    int count;
+} UIHitTest;
+
+/// @brief Drops every region, before recording a new layout
+void UIHitTest_clear(UIHitTest* hits);
+/// @brief Records a region; ignored when the table is full
+void UIHitTest_add(UIHitTest* hits, uint32_t id, Rectangle bounds, int16_t zIndex, bool captures);
+/// @brief Drops the region with this id, e.g. when its element closes before the next layout
+void UIHitTest_remove(UIHitTest* hits, uint32_t id);
+/// @brief Topmost capturing region containing the point
+/// @return the region, or NULL when the point reaches the world
+const UIHitRegion* UIHitTest_find(const UIHitTest* hits, Vector2 point);
+
+#endif // UI_HIT_TEST_H
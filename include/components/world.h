@@ -0,0 +1,234 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "arena.h"
+#include "components/chunk.h"
+#include "components/chunkmap.h"
+#include "components/region_file.h"
+
+/// @brief Memory and paging counters. Chunk/byte counts are current,
+/// the rest are cumulative since World_new.
+typedef struct WorldMemoryStats {
+    int residentChunks;    // chunks with a raw tile array in memory
+    int compressedChunks;  // chunks held only as a palette/RLE encoding
+    long residentBytes;    // raw tile bytes in memory
+    long compressedBytes;  // encoded bytes in memory
+    long compressions;     // chunks compressed after aging out
+    long decompressions;   // compressed chunks decoded on access
+    long pageIns;          // chunks read back from region files
+    long pageOuts;         // chunks evicted (written first if changed)
+    long dropped;          // unedited generated chunks evicted without a write
+    long failures;         // failed region file reads/writes
+    long generated;        // chunks produced by the generator, including dropped ones regenerated
+} WorldMemoryStats;
+
+/// @brief Intrusive list of chunks through Chunk.lruPrev/lruNext, most recently used first
+typedef struct ChunkList {
+    Chunk* head;
+    Chunk* tail;
+} ChunkList;
+
+/// @brief Asynchronous loader for paged-out chunks, and for chunks to generate:
+/// dropped ones passed by World_load_async and new ones requested through
+/// World_request_chunk (chunk->stored is false: generate them with
+/// World_generate_tiles). Called on the main thread; returns true if it
+/// accepted the chunk and will hand the tiles back through World_finish_load.
+typedef bool (*WorldLoadFn)(void* userData, Chunk* chunk);
+
+/// @brief Procedural generator for chunks that do not exist yet.
+/// Writes the chunk's tiles (row-major, CHUNK_AREA entries, preset to TILE_NONE)
+/// from its coordinate and seed alone, so the same world comes out on every run
+/// and in any visiting order. Returns false to leave the chunk nonexistent.
+/// Loader threads call it too (World_generate_tiles), so it must be thread-safe.
+typedef bool (*WorldGenerateFn)(void* userData, int chunkX, int chunkY, uint32_t seed, uint16_t* tiles);
+
+/// @brief Deterministic per-chunk seed: mixes the world seed with the chunk coordinate
+static inline uint32_t World_chunk_seed(uint32_t worldSeed, int chunkX, int chunkY) {
+    uint32_t h = worldSeed ^ ((uint32_t)chunkX * 0x9E3779B1u) ^ ((uint32_t)chunkY * 0x85EBCA77u);
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return h;
+}
+
+/// @brief One chunk of a WorldSnapshot. Exactly one of tiles and packed is
+/// set, or neither when the chunk was paged out: its data is then the slot in
+/// the world's region store, which stays untouched until the snapshot is released.
+typedef struct WorldFrozenChunk {
+    Chunk* chunk;             // for World_release_snapshot, do not touch off the main thread
+    int chunkX;
+    int chunkY;
+    const uint16_t* tiles;    // CHUNK_AREA raw tiles
+    const uint8_t* packed;    // ChunkCodec encoding
+    uint32_t packedSize;
+} WorldFrozenChunk;
+
+/// @brief Immutable view of the chunks changed since the previous freeze.
+/// The buffers are shared with the live chunks copy-on-write, so it can be
+/// read from another thread while play continues.
+typedef struct WorldSnapshot {
+    WorldFrozenChunk* chunks;
+    int count;
+    int capacity;
+} WorldSnapshot;
+
+/// @brief Sparse, unbounded tile storage.
+/// Chunks are created the first time a tile inside them is written and are
+/// found through a ChunkMap keyed by chunk coordinate, so memory grows with
+/// the chunks actually touched. Tile coordinates may be negative. With a
+/// generator registered, a chunk is generated the first time it is requested
+/// or written, so nothing is produced up front.
+///
+/// Chunks in memory sit on one of two LRU lists. Chunks looked up recently
+/// are hot. With compression enabled, World_evict_cold moves chunks untouched
+/// for compressAfter frames to the cold list and replaces their tiles with a
+/// palette/RLE encoding. With paging enabled it then writes least recently
+/// used chunks (cold first) to region files and frees them until tile memory,
+/// raw plus encoded, fits the budget. Chunks looked up during the current
+/// frame are never evicted. Generated chunks that were never edited are not
+/// written at all: they are freed and generated again when looked up. Looking
+/// up a compressed or evicted chunk restores it, so callers always get a raw
+/// tile array. World_peek_chunk instead hands paged-out chunks to the
+/// registered loader and returns NULL until they are back.
+typedef struct World {
+    Arena_T arena;
+    ChunkMap chunks;       // (chunkX, chunkY) -> Chunk*
+    ChunkMap empty;        // coordinates the generator left empty, so it runs once per chunk
+    Chunk* lastChunk;      // most recent lookup, tile access is highly coherent
+
+    // Compression and paging
+    ChunkList hot;
+    ChunkList cold;
+    uint32_t compressAfter; // frames untouched before a chunk goes cold, 0 = never
+    bool paging;
+    RegionStore store;
+    size_t residentBudget;  // bytes of tile data (raw + encoded) allowed after eviction
+    uint32_t frame;         // advanced by World_evict_cold
+    WorldLoadFn loader;     // NULL loads evicted chunks synchronously
+    void* loaderData;
+    Chunk* spare;           // first-generation placeholder the loader turned down, reused next time
+    WorldGenerateFn generator;  // NULL: chunks start out all TILE_NONE
+    void* generatorData;
+    uint32_t seed;              // world seed, mixed into every chunk's seed
+    WorldMemoryStats stats;
+
+    // Extent of every chunk created so far, in chunk coordinates (inclusive)
+    bool hasChunks;
+    int minChunkX;
+    int minChunkY;
+    int maxChunkX;
+    int maxChunkY;
+} World;
+
+/// @brief Creates an empty world
+/// @param arena NULL allocates the world and its chunks from the heap, which World_free releases.
+/// Such a world shares nothing with other threads (e.g. a scratch world for replaying a journal).
+/// @return World*
+World* World_new(Arena_T arena);
+/// @brief Releases tile arrays, the chunk map and the region store (chunk structs belong to the arena, if any)
+/// @param world
+void World_free(World* world);
+
+/// @brief Enables paging cold chunks out to region files in directory
+/// @param world
+/// @param directory created if missing; region files in it are overwritten
+/// @param residentBudget bytes of tile data to keep resident
+/// @return false if the directory cannot be created
+bool World_enable_paging(World* world, const char* directory, size_t residentBudget);
+/// @brief Registers the asynchronous loader used by World_peek_chunk (NULL to load synchronously)
+void World_set_loader(World* world, WorldLoadFn loader, void* userData);
+/// @brief Installs tiles read or generated by the loader (takes ownership).
+/// NULL reports a failed load, or for a first generation that the generator left the chunk empty.
+void World_finish_load(World* world, Chunk* chunk, uint16_t* tiles);
+/// @brief Hands a paged-out or dropped chunk to the loader without restoring it
+/// or counting it as used (prefetch). Chunks in memory or already loading are skipped.
+/// @return true if the loader accepted it
+bool World_load_async(World* world, Chunk* chunk);
+/// @brief Runs the generator for a chunk into tiles (CHUNK_AREA entries), on any thread
+/// @return false if there is no generator or it leaves the chunk empty
+bool World_generate_tiles(const World* world, int chunkX, int chunkY, uint16_t* tiles);
+
+/// @brief Registers the generator run for chunks the first time they are requested or written (NULL disables).
+/// It also regenerates unedited chunks dropped on eviction, so it must give the same tiles every time.
+/// Replacing it forgets which chunks the previous generator left empty.
+/// @param world
+/// @param generator
+/// @param userData passed to every call
+/// @param seed world seed; each chunk gets World_chunk_seed(seed, chunkX, chunkY)
+void World_set_generator(World* world, WorldGenerateFn generator, void* userData, uint32_t seed);
+
+/// @brief Compresses chunks untouched for afterFrames frames (0 disables)
+/// @param world
+/// @param afterFrames
+void World_enable_compression(World* world, uint32_t afterFrames);
+/// @brief Compresses aged-out chunks and pages out least recently used ones until tile memory fits the budget, then starts a new frame.
+/// Call once per frame after every system has looked up the chunks it needs.
+/// @return number of chunks evicted
+int World_evict_cold(World* world);
+
+/// @brief Freezes every chunk whose revision changed since the previous freeze into snapshot.
+/// O(chunks): buffers are shared rather than copied, and the first write to a
+/// frozen chunk gives it a private copy. Release the snapshot before freezing again.
+/// @return number of chunks frozen
+int World_freeze(World* world, WorldSnapshot* snapshot);
+/// @brief Returns a snapshot's buffers to the chunks or frees them (main thread, once nothing reads it)
+void World_release_snapshot(World* world, WorldSnapshot* snapshot);
+/// @brief Frees the snapshot's chunk array (release it first)
+void World_snapshot_free(WorldSnapshot* snapshot);
+
+/// @brief Gets the chunk at chunk coordinates, paging it in if needed; NULL if it was never touched
+Chunk* World_get_chunk(World* world, int chunkX, int chunkY);
+/// @brief Gets the chunk at chunk coordinates without blocking on disk.
+/// Evicted chunks are handed to the loader and NULL is returned until World_finish_load.
+Chunk* World_peek_chunk(World* world, int chunkX, int chunkY);
+/// @brief Gets the chunk at chunk coordinates without restoring it or counting it as used.
+/// Its tiles may be compressed or paged out, but revision is always current.
+Chunk* World_find_chunk(const World* world, int chunkX, int chunkY);
+/// @brief Like World_peek_chunk, but generates chunks that do not exist yet,
+/// on the loader when one is registered (World_find_chunk then sees a chunk
+/// with generating set until it is done).
+/// NULL while the chunk is loading or generating, or if the generator leaves it empty.
+Chunk* World_request_chunk(World* world, int chunkX, int chunkY);
+/// @brief Gets the chunk at chunk coordinates, creating it (generated, else all TILE_NONE) if needed
+Chunk* World_touch_chunk(World* world, int chunkX, int chunkY);
+
+/// @brief Gets the tile id at tile coordinates, TILE_NONE where no chunk exists
+static inline uint16_t World_get_tile(World* world, int x, int y) {
+    int chunkX = Chunk_coord(x), chunkY = Chunk_coord(y);
+    Chunk* chunk = world->lastChunk;
+    // The first read of a frame goes through the lookup, which moves the chunk up the LRU list
+    if (!chunk || chunk->chunkX != chunkX || chunk->chunkY != chunkY || chunk->lastUsedFrame != world->frame) {
+        chunk = World_get_chunk(world, chunkX, chunkY);
+        if (!chunk) return TILE_NONE;
+    }
+    return Chunk_get_tile(chunk, Chunk_local(x), Chunk_local(y));
+}
+
+/// @brief Sets the tile id at tile coordinates, creating the chunk if needed
+void World_set_tile(World* world, int x, int y, uint16_t tile_id);
+
+/// @brief Gets the tile-space rectangle covered by existing chunks
+/// @return false if the world has no chunks yet
+bool World_get_bounds(const World* world, int* outX, int* outY, int* outWidth, int* outHeight);
+
+// Bulk region operations. They work a chunk row span at a time, create the
+// chunks they write into, and bump each affected chunk's revision exactly
+// once. Each returns the number of chunks touched.
+
+/// @brief Sets every tile in the rectangle to tile_id
+int World_fill_rect(World* world, int x, int y, int width, int height, uint16_t tile_id);
+/// @brief Copies a width x height block of tile ids from src into the world
+/// @param srcStride tiles between source rows, 0 repeats the first row
+int World_blit(World* world, int x, int y, int width, int height, const uint16_t* src, int srcStride);
+/// @brief Copies a region of the world onto another (overlap safe); source chunks are generated if needed, else copy as TILE_NONE
+int World_copy_region(World* world, int srcX, int srcY, int width, int height, int dstX, int dstY);
+/// @brief Reads a width x height block of tile ids into dst (row stride = width), generating chunks if needed; TILE_NONE where none exists
+void World_read_rect(World* world, int x, int y, int width, int height, uint16_t* dst);
+
+#endif // WORLD_H
@@ -0,0 +1,31 @@
+#ifndef INPUT_SCRIPTED_H
+#define INPUT_SCRIPTED_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gramarye_renderer/input_provider.h"
+
+// One input event on a given frame. A key or button is pressed (and held)
+// for that frame only; the mouse stays where the last event put it.
+typedef struct InputScriptEvent {
+    uint32_t frame;
+    int key;             // INPUT_KEY_*, 0 for none
+    int mouseButton;     // INPUT_MOUSE_BUTTON_*, -1 for none
+    float wheel;         // wheel movement this frame
+    bool moveMouse;
+    RenderVector2 mousePos;
+} InputScriptEvent;
+
+// InputProvider that replays a script instead of reading a device, for
+// running GameSystem_frame without a window. Events must be sorted by
+// frame. With a non-zero period the script repeats every period frames.
+// The provider copies the events.
+InputProvider* InputProviderScripted_create(const InputScriptEvent* events, int eventCount, uint32_t period);
+void InputProviderScripted_destroy(InputProvider* provider);
+
+// Moves to the next frame; call once per frame after GameSystem_frame
+void InputProviderScripted_advance(InputProvider* provider);
+uint32_t InputProviderScripted_frame(const InputProvider* provider);
+
+#endif // INPUT_SCRIPTED_H
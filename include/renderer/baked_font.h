@@ -0,0 +1,60 @@
+#ifndef BAKED_FONT_H
+#define BAKED_FONT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "raylib.h"
+
+// Font atlas baked offline by tools/font_baker.c, so startup maps a file
+// and uploads its pixels instead of rasterizing TrueType.
+//
+// Layout, native byte order, every section 16-byte aligned:
+//   BakedFontHeader
+//   BakedGlyph[glyphCount]
+//   atlas pixels (atlasWidth * atlasHeight in `format`, ready to upload)
+#define BAKED_FONT_MAGIC "GFNT"
+#define BAKED_FONT_VERSION 1u
+#define BAKED_FONT_ALIGN 16u
+
+#define BAKED_FONT_SDF 0x1u  // distance field glyphs; draw with raylib's SDF shader
+
+typedef struct BakedFontHeader {
+    char magic[4];
+    uint32_t version;
+    int32_t baseSize;
+    int32_t glyphCount;
+    int32_t glyphPadding;
+    int32_t atlasWidth;
+    int32_t atlasHeight;
+    int32_t format;        // PixelFormat of the atlas
+    uint32_t flags;        // BAKED_FONT_*
+    uint32_t glyphOffset;  // bytes from the start of the file
+    uint32_t pixelOffset;
+    uint32_t pixelBytes;
+} BakedFontHeader;
+
+typedef struct BakedGlyph {
+    int32_t value;  // codepoint
+    int32_t offsetX;
+    int32_t offsetY;
+    int32_t advanceX;
+    float x;        // atlas rectangle
+    float y;
+    float width;
+    float height;
+} BakedGlyph;
+
+// Rounds a section offset up to BAKED_FONT_ALIGN
+static inline uint32_t BakedFont_align(uint32_t offset) {
+    return (offset + BAKED_FONT_ALIGN - 1u) & ~(BAKED_FONT_ALIGN - 1u);
+}
+
+// Maps the file, uploads the atlas and fills a raylib Font whose glyph and
+// rectangle arrays are heap copies, so UnloadFont releases it as usual.
+// The mapping is released before returning. Needs a window for the
+// texture upload. Returns false, leaving *font zeroed, when the file is
+// missing, truncated or from another format version.
+bool BakedFont_load(const char* path, Font* font, uint32_t* flags);
+
+#endif // BAKED_FONT_H
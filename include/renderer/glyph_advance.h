@@ -0,0 +1,28 @@
+#ifndef GLYPH_ADVANCE_H
+#define GLYPH_ADVANCE_H
+
+#include "raylib.h"
+
+// Printable ASCII advances of one font, looked up once when the font is
+// loaded so that measuring a string is a table sum instead of a glyph
+// search per character. Advances are kept at the font's baseSize; raylib
+// scales glyphs linearly with the font size, so one table serves every
+// size the font is drawn at.
+//
+// Bytes outside printable ASCII (UTF-8 sequences) fall back to
+// GetGlyphIndex on the font, which must outlive the table. Control
+// characters other than '\n' have no width.
+typedef struct GlyphAdvanceTable {
+    Font font;
+    float advances[128];  // indexed by byte, at baseSize
+    float baseSize;       // 0 when the font has no glyphs; everything then measures 0
+} GlyphAdvanceTable;
+
+void GlyphAdvanceTable_build(GlyphAdvanceTable* table, Font font);
+
+// Size of text drawn at fontSize with spacing pixels between characters:
+// the widest '\n'-separated line, and fontSize high (as Raylib_MeasureText)
+Vector2 GlyphAdvanceTable_measure(const GlyphAdvanceTable* table, const char* text, int length,
+                                  float fontSize, float spacing);
+
+#endif // GLYPH_ADVANCE_H
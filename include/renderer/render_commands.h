@@ -0,0 +1,63 @@
+#ifndef RENDER_COMMANDS_H
+#define RENDER_COMMANDS_H
+
+#include "gramarye_renderer/renderer.h"
+
+// Builders for the RenderCommands the game issues through Renderer_execute_command.
+// Texture handles are backend textures (Texture2D* for the raylib renderer);
+// the headless renderer only compares them.
+
+static inline RenderCommand RenderCommand_rectangle(RenderRect bounds, RenderColor color) {
+    RenderCommand cmd = {0};
+    cmd.type = RENDER_COMMAND_TYPE_RECTANGLE;
+    cmd.bounds = bounds;
+    cmd.color = color;
+    return cmd;
+}
+
+static inline RenderCommand RenderCommand_rectangle_lines(RenderRect bounds, float thickness, RenderColor color) {
+    RenderCommand cmd = RenderCommand_rectangle(bounds, color);
+    cmd.type = RENDER_COMMAND_TYPE_RECTANGLE_LINES;
+    cmd.thickness = thickness;
+    return cmd;
+}
+
+// source may have a negative height to flip vertically (render textures are stored bottom-up)
+static inline RenderCommand RenderCommand_texture(void* texture, RenderRect source, RenderRect bounds, RenderColor tint) {
+    RenderCommand cmd = RenderCommand_rectangle(bounds, tint);
+    cmd.type = RENDER_COMMAND_TYPE_TEXTURE_PRO;
+    cmd.texture = texture;
+    cmd.source = source;
+    return cmd;
+}
+
+// text is read when the command executes (the headless renderer keeps a copy)
+static inline RenderCommand RenderCommand_text(const char* text, float x, float y, float fontSize, RenderColor color) {
+    RenderCommand cmd = RenderCommand_rectangle((RenderRect){ x, y, 0.0f, fontSize }, color);
+    cmd.type = RENDER_COMMAND_TYPE_TEXT;
+    cmd.text = text;
+    cmd.fontSize = fontSize;
+    return cmd;
+}
+
+// Texture state a command draws with. raylib batches shapes on its default
+// texture and text on the font atlas, so each gets a key of its own; a
+// clear uses none. Commands with equal keys can share a batch.
+#define RENDER_TEXTURE_KEY_SHAPES ((const void*)1)
+#define RENDER_TEXTURE_KEY_TEXT ((const void*)2)
+
+static inline const void* RenderCommand_texture_key(const RenderCommand* cmd) {
+    switch (cmd->type) {
+        case RENDER_COMMAND_TYPE_TEXTURE:
+        case RENDER_COMMAND_TYPE_TEXTURE_PRO:
+            return cmd->texture;
+        case RENDER_COMMAND_TYPE_TEXT:
+            return RENDER_TEXTURE_KEY_TEXT;
+        case RENDER_COMMAND_TYPE_CLEAR:
+            return NULL;
+        default:
+            return RENDER_TEXTURE_KEY_SHAPES;
+    }
+}
+
+#endif // RENDER_COMMANDS_H
@@ -1,22 +1,49 @@
 #ifndef RENDER_LAYER_H
 #define RENDER_LAYER_H
 
-#include "renderer.h"
+#include "gramarye_renderer/renderer.h"
 #include "arena.h"
 
+// Commands queued for one layer of a frame. Order between commands that
+// draw with different textures is not kept: the pipeline groups a layer's
+// commands by texture state before submitting them, so anything that must
+// draw on top of something else belongs in a higher layer.
+//
+// Text is not copied; it must stay valid until the pipeline executes.
 typedef struct RenderLayer {
     RenderCommand* commands;
     size_t commandCount;
     size_t commandCapacity;
     Arena_T arena;
     int layerIndex;
+
+    // Sorting scratch, sized with commands
+    RenderCommand* sorted;
+    int* groups;             // texture state group of each command
+    const void** groupKeys;  // texture key of each group
+    int* groupOffsets;
 } RenderLayer;
 
+// Submission counts for one execute. A run is a stretch of consecutive
+// commands that share a texture state, i.e. what the backend can draw as
+// one batch; unsortedRuns is what the same commands would have cost in
+// the order they were added.
+typedef struct RenderPipelineStats {
+    long commands;
+    long runs;
+    long unsortedRuns;
+} RenderPipelineStats;
+
+// Layers run in ascending layerIndex. Within a layer, commands are stably
+// sorted by texture state, each state in the order it was first used, so
+// every quad drawn from one atlas is submitted back to back and the
+// backend batches them into a single draw.
 typedef struct RenderPipeline {
-    RenderLayer* layers;
+    RenderLayer** layers;
     size_t layerCount;
     size_t layerCapacity;
     Arena_T arena;
+    RenderPipelineStats stats;  // since the last clear or full execute
 } RenderPipeline;
 
 // Layer functions
@@ -28,6 +55,10 @@ void RenderLayer_clear(RenderLayer* layer);
 RenderPipeline* RenderPipeline_create(Arena_T arena);
 void RenderPipeline_add_layer(RenderPipeline* pipeline, RenderLayer* layer);
 void RenderPipeline_execute(RenderPipeline* pipeline, Renderer* renderer);
+// Executes only the layers with firstLayerIndex <= layerIndex <= lastLayerIndex,
+// so a frame can send some layers to another render target. Stats add up
+// over the calls until the next clear.
+void RenderPipeline_execute_layers(RenderPipeline* pipeline, Renderer* renderer, int firstLayerIndex, int lastLayerIndex);
 void RenderPipeline_clear(RenderPipeline* pipeline);
 
-#endif // RENDER_LAYER_H
\ No newline at end of file
+#endif // RENDER_LAYER_H
@@ -0,0 +1,58 @@
+#ifndef RENDER_TEXTURE_POOL_H
+#define RENDER_TEXTURE_POOL_H
+
+#include <stdbool.h>
+
+#include "raylib.h"
+
+// Fixed-size square slots carved out of a few large render textures
+// (pages). Slots are handed out from a free list and go back on it when
+// released, so once the pool has grown to its high-water mark acquiring a
+// slot never creates a texture. Pages are only unloaded by
+// RenderTexturePool_free. Page textures are allocated individually, so a
+// page's address stays valid while the pool grows.
+//
+// Without a window (drawTextures false) slots are still tracked but the
+// pages hold no GPU texture.
+typedef struct RenderTexturePool {
+    int slotSize;      // pixels per slot side
+    int pageSize;      // pixels per page side
+    int slotsPerSide;
+    int slotsPerPage;
+    bool drawTextures;
+
+    RenderTexture2D** pages;
+    int pageCount;
+    int pageCapacity;
+
+    int* freeSlots;    // stack of free slot ids, sized for every slot of every page
+    int freeCount;
+} RenderTexturePool;
+
+// pageSize is rounded up to at least one slot
+void RenderTexturePool_init(RenderTexturePool* pool, int slotSize, int pageSize, bool drawTextures);
+void RenderTexturePool_free(RenderTexturePool* pool);
+
+// Adds pages until at least slotCount slots are free
+bool RenderTexturePool_reserve(RenderTexturePool* pool, int slotCount);
+
+// Returns a free slot id, adding a page when none is left; -1 if that fails
+int RenderTexturePool_acquire(RenderTexturePool* pool);
+void RenderTexturePool_release(RenderTexturePool* pool, int slot);
+
+RenderTexture2D* RenderTexturePool_page(const RenderTexturePool* pool, int slot);
+// Slot rectangle in page drawing coordinates (y down, as inside BeginTextureMode)
+Rectangle RenderTexturePool_slot_rect(const RenderTexturePool* pool, int slot);
+// Source rectangle that draws the slot upright; render textures are stored
+// bottom-up, so it is flipped (negative height)
+Rectangle RenderTexturePool_slot_source(const RenderTexturePool* pool, int slot);
+
+// Puts the slot's page in texture mode; draw with RenderTexturePool_slot_rect
+// offsets and finish with RenderTexturePool_end_slot
+void RenderTexturePool_begin_slot(RenderTexturePool* pool, int slot);
+// Clears part of the slot (slot-local pixels) to transparent, leaving the
+// rest of the page alone; call between begin_slot and end_slot
+void RenderTexturePool_clear_slot_rect(RenderTexturePool* pool, int slot, Rectangle local);
+void RenderTexturePool_end_slot(RenderTexturePool* pool);
+
+#endif // RENDER_TEXTURE_POOL_H
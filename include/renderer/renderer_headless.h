@@ -0,0 +1,37 @@
+#ifndef RENDERER_HEADLESS_H
+#define RENDERER_HEADLESS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gramarye_renderer/renderer.h"
+
+// Counters for the commands executed by a headless renderer
+typedef struct RendererHeadlessStats {
+    long commands;      // every executed command, clears included
+    long drawCalls;     // rectangles, outlines, textures and text
+    long textureBinds;  // draws whose texture differs from the previous draw's
+    long bytes;         // command structs plus copied text recorded
+} RendererHeadlessStats;
+
+// Renderer that opens no window and touches no GPU. Every command executed
+// between begin_frame and end_frame is copied into a buffer in the
+// renderer's own arena, which is reset at the next begin_frame. Binds are
+// counted on RenderCommand_texture_key, so textureBinds approximates the
+// batch breaks the raylib backend would see.
+//
+// Delta time is fixed, so frames are reproducible. The renderer reports
+// should_close after frameLimit frames (0 = never) or Renderer_close.
+Renderer* RendererHeadless_create(int width, int height, float deltaTime, uint32_t frameLimit);
+void RendererHeadless_destroy(Renderer* renderer);
+
+// Commands recorded so far in the current (or last finished) frame. Text
+// pointers point at the renderer's copies and stay valid until the next
+// begin_frame.
+const RenderCommand* RendererHeadless_commands(const Renderer* renderer, long* outCount);
+
+RendererHeadlessStats RendererHeadless_frame_stats(const Renderer* renderer);
+RendererHeadlessStats RendererHeadless_total_stats(const Renderer* renderer);
+uint32_t RendererHeadless_frame_count(const Renderer* renderer);
+
+#endif // RENDERER_HEADLESS_H
@@ -0,0 +1,105 @@
+#ifndef CHUNK_STREAM_SYSTEM_H
+#define CHUNK_STREAM_SYSTEM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "components/world.h"
+#include "components/region_file.h"
+
+#ifdef USE_THREADING
+#include <pthread.h>
+#endif
+
+#define CHUNK_STREAM_MAX_WORKERS 4
+#define CHUNK_STREAM_JOB_CAPACITY 256        // pending loads (power of two)
+#define CHUNK_STREAM_COMPLETION_CAPACITY 512 // finished loads not yet installed (power of two)
+#define CHUNK_STREAM_SYNC_PER_FRAME 2        // loads run per frame when there are no workers
+
+typedef struct ChunkLoadJob {
+    Chunk* chunk;
+    int chunkX;
+    int chunkY;
+    bool generate;  // new or dropped chunk: run the world's generator instead of reading the region store
+} ChunkLoadJob;
+
+typedef struct ChunkLoadResult {
+    Chunk* chunk;
+    uint16_t* tiles;  // NULL if the load failed
+} ChunkLoadResult;
+
+typedef struct ChunkCompletionSlot {
+    uint32_t sequence;
+    ChunkLoadResult result;
+} ChunkCompletionSlot;
+
+// Bounded lock-free queue (per-slot sequence numbers). Workers push
+// concurrently, only the main thread pops.
+typedef struct ChunkCompletionQueue {
+    ChunkCompletionSlot slots[CHUNK_STREAM_COMPLETION_CAPACITY];
+    uint32_t enqueuePos;
+    uint32_t dequeuePos;
+} ChunkCompletionQueue;
+
+typedef struct ChunkStreamSystem ChunkStreamSystem;
+
+typedef struct ChunkStreamWorker {
+    ChunkStreamSystem* sys;
+    RegionStore store;  // each worker reads region files through its own handle
+#ifdef USE_THREADING
+    pthread_t thread;
+#endif
+} ChunkStreamWorker;
+
+// Loads paged-out chunks and generates new ones off the main thread.
+// Registered as the World's loader, so World_peek_chunk queues a job instead
+// of blocking on disk, and World_request_chunk one instead of generating;
+// finished tiles come back through a lock-free completion queue and are
+// installed by ChunkStreamSystem_update. No more loads are accepted than
+// the completion queue holds, so workers never wait for room in it. Also prefetches chunks ahead of
+// the observer along its recent movement direction: paged-out chunks are read
+// and dropped or new ones generated on the workers, never on the main thread.
+struct ChunkStreamSystem {
+    World* world;
+    int loadRadius;     // observer load radius in chunks, prefetch covers the window ahead of it
+    int prefetchDepth;  // how many chunks ahead the prefetch window is centred
+
+    ChunkLoadJob jobs[CHUNK_STREAM_JOB_CAPACITY];
+    int jobHead;
+    int jobCount;
+    ChunkCompletionQueue done;
+    int outstanding;  // loads accepted and not installed yet, at most the completion capacity (main thread)
+
+    ChunkStreamWorker workers[CHUNK_STREAM_MAX_WORKERS];
+    int workerCount;
+    RegionStore store;  // main-thread loads when there are no workers
+#ifdef USE_THREADING
+    pthread_mutex_t lock;  // guards jobs/jobHead/jobCount and running
+    pthread_cond_t wake;
+    bool running;
+#endif
+
+    // Movement tracking for prefetch
+    bool hasLastPos;
+    int lastTileX;
+    int lastTileY;
+    float dirX;
+    float dirY;
+    bool prefetching;
+
+    long requested;
+    long installed;
+    long prefetched;
+};
+
+void ChunkStreamSystem_init(ChunkStreamSystem* sys, World* world, int workerCount, int loadRadius, int prefetchDepth);
+// Stops the workers and installs or drops whatever is still in flight
+void ChunkStreamSystem_shutdown(ChunkStreamSystem* sys);
+
+// Installs finished chunks into the world, returns how many
+int ChunkStreamSystem_update(ChunkStreamSystem* sys);
+
+// Feeds the observer's tile position and requests the chunks it is heading towards
+void ChunkStreamSystem_prefetch(ChunkStreamSystem* sys, int tileX, int tileY);
+
+#endif // CHUNK_STREAM_SYSTEM_H
@@ -0,0 +1,60 @@
+#ifndef DUNGEON_SYSTEM_H
+#define DUNGEON_SYSTEM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "systems/floor_system.h"
+
+#ifdef USE_THREADING
+#include <pthread.h>
+#endif
+
+#define DUNGEON_MAX_WORKERS 8
+
+typedef struct DungeonSystem DungeonSystem;
+
+typedef struct DungeonWorker {
+    DungeonSystem* sys;
+    int index;  // regions index, index + participants, ... of every pass are this worker's
+#ifdef USE_THREADING
+    pthread_t thread;
+#endif
+} DungeonWorker;
+
+// Generates floors on a pool of worker threads. Each FloorSystem pass is
+// split across the workers and the calling thread by region, with a barrier
+// between passes; since regions are seeded independently, the result is
+// identical to FloorSystem_generate for any worker count.
+struct DungeonSystem {
+    uint32_t seed;  // dungeon seed, floors derive theirs with FloorSystem_floor_seed
+
+    DungeonWorker workers[DUNGEON_MAX_WORKERS];
+    int workerCount;
+#ifdef USE_THREADING
+    pthread_mutex_t lock;  // guards the pass fields below and running
+    pthread_cond_t wake;   // a new pass was posted
+    pthread_cond_t done;   // a worker finished its share of the pass
+    bool running;
+#endif
+
+    // Current pass, posted by the calling thread
+    Floor* floor;
+    void (*pass)(Floor* floor, int region);
+    uint32_t passNumber;
+    int finished;  // workers done with passNumber
+
+    long floors;
+    long regions;
+};
+
+// workerCount threads besides the caller (0, or no USE_THREADING: generate on the calling thread)
+void DungeonSystem_init(DungeonSystem* sys, uint32_t seed, int workerCount);
+// Joins the workers; call it once the floors are built. Safe to call again,
+// and DungeonSystem_generate keeps working on the calling thread afterwards.
+void DungeonSystem_shutdown(DungeonSystem* sys);
+
+// Generates floor depth into floor (FloorSystem_init'd to the wanted size)
+void DungeonSystem_generate(DungeonSystem* sys, Floor* floor, int depth, const FloorTiles* palette);
+
+#endif // DUNGEON_SYSTEM_H
@@ -0,0 +1,85 @@
+#ifndef FLOOR_SYSTEM_H
+#define FLOOR_SYSTEM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "systems/room_system.h"
+
+#ifdef USE_THREADING
+#include <pthread.h>
+#endif
+
+// Floors are split into square regions of this many tiles, one room each
+#define FLOOR_REGION_SIZE 32
+// Regions a streamed floor keeps after generating them, direct-mapped by coordinate
+#define FLOOR_REGION_CACHE 64
+
+typedef struct FloorRegion {
+    int regionX, regionY;
+    bool valid;
+    uint16_t tiles[FLOOR_REGION_SIZE * FLOOR_REGION_SIZE];  // row-major, FLOOR_REGION_SIZE wide
+} FloorRegion;
+
+typedef struct FloorTiles {
+    uint16_t wall;
+    uint16_t room;
+    uint16_t corridor;
+    uint16_t stairsUp;
+    uint16_t stairsDown;
+} FloorTiles;
+
+// One dungeon floor, generated in two passes over its regions:
+//   1. FloorSystem_place_rooms: fill the region with wall and carve its room
+//   2. FloorSystem_connect: carve the part of every corridor that crosses the region
+// A region's room depends only on World_chunk_seed(seed, regionX, regionY),
+// and each pass writes nothing outside its region, so regions can be
+// generated in any order on any number of threads with identical output.
+// Corridors join every region to its right and lower neighbours.
+//
+// A streamed floor (FloorSystem_init_streamed) has no tiles or rooms arrays:
+// FloorSystem_generate_chunk generates the regions a chunk overlaps from
+// their seeds when the world asks for it, with the same result.
+typedef struct Floor {
+    int width;
+    int height;
+    uint16_t* tiles;   // width * height, row-major, tile (0, 0) is the world origin; NULL when streamed
+    int regionsX;
+    int regionsY;
+    Room* rooms;       // regionsX * regionsY, row-major; NULL when streamed
+    FloorRegion* cache;  // FLOOR_REGION_CACHE recently generated regions of a streamed floor
+#ifdef USE_THREADING
+    pthread_mutex_t cacheLock;  // the world's generator runs on the chunk stream workers
+#endif
+
+    uint32_t seed;
+    FloorTiles palette;
+    int upX, upY;      // stairs, placed by FloorSystem_finish; the player arrives at upX, upY
+    int downX, downY;
+} Floor;
+
+bool FloorSystem_init(Floor* floor, int width, int height);
+// Floor whose regions are only generated as chunks are requested; the stairs are known up front
+bool FloorSystem_init_streamed(Floor* floor, int width, int height, uint32_t seed, const FloorTiles* palette);
+void FloorSystem_free(Floor* floor);
+
+// Seed of floor depth within a dungeon
+uint32_t FloorSystem_floor_seed(uint32_t dungeonSeed, int depth);
+
+// Single-threaded generation, the reference DungeonSystem must match
+void FloorSystem_generate(Floor* floor, uint32_t seed, const FloorTiles* palette);
+
+// The steps of FloorSystem_generate. Each pass must finish on every region
+// before the next one starts; regions within a pass are independent.
+void FloorSystem_begin(Floor* floor, uint32_t seed, const FloorTiles* palette);
+int FloorSystem_region_count(const Floor* floor);
+void FloorSystem_place_rooms(Floor* floor, int region);
+void FloorSystem_connect(Floor* floor, int region);
+void FloorSystem_finish(Floor* floor);
+
+// WorldGenerateFn over a streamed Floor (userData): generates the regions the
+// chunk overlaps, or takes them from the cache, and copies the chunk's part.
+// Chunks outside the floor do not exist. Thread-safe.
+bool FloorSystem_generate_chunk(void* userData, int chunkX, int chunkY, uint32_t seed, uint16_t* tiles);
+
+#endif // FLOOR_SYSTEM_H
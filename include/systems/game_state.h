@@ -7,7 +7,6 @@
 #include "raylib.h"
 
 #include "textures/atlas_table.h"
-#include "tilemap/tilemap.h"
 #include "camera.h"
 #include "gramarye_ecs/ecs.h"
 #include "gramarye_ecs/entity.h"
@@ -26,13 +25,80 @@
 // Full Atlas API with raylib types (from gramarye-component-functions)
 #include "textures/atlas.h"  // Full definition with Texture2D, Rectangle
 
-#include "gramarye_chunk_renderer/chunk_render_system.h"
 #include "gramarye_renderer/renderer.h"  // Renderer interface
+#include "gramarye_renderer/input_provider.h"  // Input provider interface
+#include "renderer/render_layer.h"  // RenderPipeline, RenderLayer
+#include "renderer/glyph_advance.h"  // Text measurement tables for UI fonts
 #include "gramarye_ui/ui_provider.h"  // UI provider interface
 #include "camera.h"  // Required for Camera2DEx and AspectFit used by chunk renderer
 #include "gramarye_event_bus/event_bus.h"  // EventBus
 #include "gramarye_chunk_controller/tile_update_queue.h"  // TileUpdateQueue
-#include "gramarye_chunk_controller/chunk_manager_system.h"  // ChunkManagerSystem
+#include "gramarye_chunk_controller/chunk_manager_system.h"  // ChunkManagerSystem (table storage)
+#include "gramarye_chunk_renderer/chunk_render_system.h"  // ChunkRenderSystem (table storage)
+
+#include "components/tile_storage.h"  // Tilemap or sparse chunked World
+#include "components/spatial_index.h"  // Entity positions by grid cell
+#include "components/screenbuffer.h"  // Last composited frame
+#include "components/ui_hit_test.h"  // UI bounds for pointer blocking
+#include "systems/tile_update_system.h"
+#include "systems/map_render_system.h"
+#include "systems/sprite_render_system.h"
+#include "systems/chunk_stream_system.h"
+#include "systems/save_system.h"
+#include "systems/floor_system.h"
+
+// Layers of the world pipeline, drawn bottom to top
+typedef enum {
+    RENDER_LAYER_WORLD,     // chunk textures
+    RENDER_LAYER_ENTITIES,  // sprites
+    RENDER_LAYER_OVERLAY,   // debug shapes and text
+    RENDER_LAYER_COUNT
+} GameRenderLayer;
+
+// Everything a frame's image depends on; when it matches the previous
+// frame's and no input arrived, the previous image is presented again
+typedef struct FrameSignature {
+    Vector2 camPos;
+    float camZoom;
+    AspectFit fit;
+    int renderWidth;
+    int renderHeight;
+    uint32_t entityRevision;  // SpatialIndex.revision
+    uint32_t mapRevision;     // MapRenderSystem.imageRevision
+    uint32_t turnCount;
+    float health;             // the HUD's health bar
+    float maxHealth;
+    Vector2 mousePos;
+    bool mouseDown;
+    bool popupVisible;
+} FrameSignature;
+
+// Inputs of each UI section. Clay lays the whole tree out at once, so any
+// section changing means a new layout; when none did, the last layout's
+// render commands are drawn again (see UISystem_replay)
+typedef struct UIHudInputs {
+    uint32_t turnCount;
+    float health;
+    float maxHealth;
+} UIHudInputs;
+
+typedef struct UIPopupInputs {
+    bool visible;
+    float offsetX;
+    float offsetY;
+    bool closeHovered;
+} UIPopupInputs;
+
+typedef struct UILayoutCache {
+    bool valid;                 // commands are from a layout with these inputs
+    float width;
+    float height;
+    UIHudInputs hud;
+    UIPopupInputs popup;
+    UIRenderCommands commands;  // in Clay's arena, intact until the next layout begins
+    long layouts;
+    long replays;
+} UILayoutCache;
 
 typedef struct GameState {
     Arena_T arena;
@@ -41,23 +107,35 @@ typedef struct GameState {
 
     AtlasTable atlasTable;  // From textures/atlas_table.h
     Atlas* atlas;
-    Tilemap* tilemap;
+    TileStorage map;        // table or chunked, picked by GameSystem_create
+    World* tiles;           // map.world; NULL with table storage, which has no streaming, paging or saves
+    Floor floor;            // current floor, streamed: the world's generator builds the regions under each chunk
 
     ECS* ecs;
     ComponentTypeId positionTypeId;
     ComponentTypeId healthTypeId;
     ComponentTypeId spriteTypeId;
     EntityId player;
+    SpatialIndex entities;  // every positioned entity; move them with SpatialIndex_set_position
+    int playerHandle;       // player's handle in entities
 
     Renderer* renderer;  // Renderer interface
+    InputProvider* inputProvider;  // also owned by the InputSystem, read for pointer state
+    RenderPipeline* pipeline;  // world draws, batched by texture and executed before the UI
+    RenderLayer* layers[RENDER_LAYER_COUNT];
     UIProvider* uiProvider;  // UI provider interface
     Camera2DEx cam;
-    ChunkRenderSystem chunkRenderer;
+    ChunkRenderSystem chunkRenderer;  // table storage
+    MapRenderSystem mapRenderer;      // chunked storage
+    SpriteRenderSystem sprites;  // every Position + Sprite entity, batched per atlas
+    ChunkStreamSystem chunkStream;  // loads paged-out chunks off the main thread
     
     // Event and update systems
     EventBus* eventBus;
     TileUpdateQueue tileUpdateQueue;
-    ChunkManagerSystem chunkManager;
+    ChunkManagerSystem chunkManager;  // drains the queue with table storage
+    TileUpdateSystem tileUpdates;     // bulk edits; drains the queue with chunked storage
+    SaveSystem save;  // journals tile edits and autosaves chunk snapshots
 
     bool debug;
 
@@ -75,9 +153,21 @@ typedef struct GameState {
     // UI fonts (array of Font, allocated in arena)
     Font* uiFonts;
     int uiFontCount;
+    GlyphAdvanceTable* uiGlyphs;  // one per font, used to measure UI text
     
     // UI click blocking
     bool uiBlockingClick;
+    UIHitTest uiHits;  // element bounds from the last UI layout
+    UILayoutCache uiCache;
+
+    // Frame composition and reuse, see RenderSystem_render
+    ScreenBuffer screen;        // renderFrame holds the last composited frame
+    bool logicalTarget;         // draw the world into screen.worldFrame and upscale it; set when LOGICAL_SCALE > 1
+    bool frameCacheEnabled;     // needs a window to create the render texture
+    bool frameCached;           // renderFrame matches lastFrame
+    FrameSignature lastFrame;
+    bool frameInput;            // input commands arrived this frame
+    long framesReused;
 } GameState;
 
 #endif // GAME_STATE_H
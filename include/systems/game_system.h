@@ -8,11 +8,15 @@
 #include "gramarye_renderer/input_provider.h"
 #include "gramarye_renderer/renderer.h"
 #include "gramarye_ui/ui_provider.h"
+#include "components/tile_storage.h"
 
 typedef struct GameSystem GameSystem;
 
 // Owns all game state: tilemap, entities, camera, render targets, etc.
-GameSystem* GameSystem_create(Arena_T arena, int mapSize, int tileSize, Vector2 logicalSize, Renderer* renderer, InputProvider* inputProvider, UIProvider* uiProvider);
+// storageMode picks the tile backend: TILE_STORAGE_CHUNKED (World, with streaming,
+// paging and saves) or TILE_STORAGE_TABLE (the Tilemap, drawn by the chunk
+// controller/renderer libraries)
+GameSystem* GameSystem_create(Arena_T arena, int mapSize, int tileSize, TileStorageMode storageMode, Vector2 logicalSize, Renderer* renderer, InputProvider* inputProvider, UIProvider* uiProvider);
 void GameSystem_destroy(GameSystem* game);
 
 // Called once per-frame (handles input/movement/camera + rendering)
@@ -0,0 +1,150 @@
+#ifndef MAP_RENDER_SYSTEM_H
+#define MAP_RENDER_SYSTEM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "raylib.h"
+#include "arena.h"
+#include "camera.h"
+#include "gramarye_ecs/ecs.h"
+#include "textures/atlas.h"
+#include "components/world.h"
+#include "components/chunkmap.h"
+#include "renderer/render_layer.h"
+#include "renderer/render_texture_pool.h"
+
+#define MAP_RENDER_MAX_OBSERVERS 8
+#define MAP_RENDER_PAGE_SIZE 4096  // pixels per side of a pooled chunk texture page
+#define MAP_RENDER_LOD_LEVELS 3    // level L merges 2^L x 2^L chunks into one chunk-sized image
+#define MAP_RENDER_REBUILD_BUDGET_MS 4.0  // default time per update for redrawing stale chunks
+#define MAP_RENDER_LOD_MAX_CHILDREN ((1 << (MAP_RENDER_LOD_LEVELS - 1)) * (1 << (MAP_RENDER_LOD_LEVELS - 1)))
+
+// Cached image of one chunk of the world, a slot of the texture pool
+typedef struct MapChunkView {
+    int chunkX;
+    int chunkY;
+    int slot;
+    uint32_t renderedRevision;  // Chunk.revision the texture was drawn from
+    bool rendered;
+} MapChunkView;
+
+// Downsampled image of a 2^level x 2^level block of chunk views (a super-chunk)
+typedef struct MapLodView {
+    int level;
+    int superX;  // chunk coordinate >> level
+    int superY;
+    int slot;    // in MapRenderSystem.lodPool
+    uint32_t childMask;  // children drawn in, bit dy * 2^level + dx
+    uint32_t childRevisions[MAP_RENDER_LOD_MAX_CHILDREN];  // renderedRevision of each child when drawn
+    bool rendered;
+} MapLodView;
+
+// A stale view waiting for a redraw; lower priority goes first
+typedef struct MapRebuildEntry {
+    int view;
+    float priority;
+} MapRebuildEntry;
+
+// Chunk redraws of the last update
+typedef struct MapRebuildStats {
+    int queued;           // views that needed a redraw
+    int rebuilt;          // redrawn
+    int deferred;         // left for a later update, still drawing their old image
+    long deferredTotal;   // deferrals summed over every update
+    double milliseconds;  // spent redrawing
+} MapRebuildStats;
+
+typedef struct MapObserver {
+    ECS* ecs;
+    EntityId entity;
+    ComponentTypeId positionTypeId;
+} MapObserver;
+
+// Renders the world through per-chunk cached images. Existing chunks within
+// loadRadius (in chunks) of an observer get a view, views beyond
+// unloadRadius are released. A view is redrawn when its chunk's revision
+// moves past the one it was drawn from; if it was drawn at the chunk's
+// dirtyRevision, only the chunk's dirty blocks are redrawn. Finding stale
+// views reads revisions without counting the chunks as used, so views
+// between the load and unload radius can still age out and be paged.
+// Without a window views are tracked but never drawn, and render still
+// issues one command per visible chunk.
+//
+// Views are slots of a few large pooled render textures, reserved for the
+// whole load window at init, so streaming reuses released slots instead of
+// creating and destroying a texture per chunk. Chunks on the same page also
+// batch into one texture run.
+//
+// Redraws are budgeted: each update redraws stale views until
+// rebuildBudgetMs has passed (at least one per update), in priority order.
+// Views inside the last rendered camera view come first, then the rest,
+// each nearest to the view centre first, and never-drawn views ahead of
+// stale ones. The rest wait for the next update and keep drawing their old
+// image meanwhile.
+//
+// Zoomed out far enough that a chunk covers half its pixels or less, render
+// draws super-chunks instead: images of 2x2 (or 4x4) chunk views scaled
+// into one chunk-sized slot, so the number of draws and texels fetched
+// stays about what it is at zoom 1. A super-chunk is rebuilt from its
+// children's images when one of them is redrawn, loaded or unloaded.
+typedef struct MapRenderSystem {
+    World* world;
+    Atlas* atlas;
+    int tileSize;
+    int loadRadius;
+    int unloadRadius;
+    bool drawTextures;  // false when there is no window to create render textures on
+
+    // Atlas source rects indexed by tile id, so chunk redraws skip the atlas table
+    Rectangle* tileRects;
+    int tileRectCount;
+
+    RenderTexturePool texturePool;  // one CHUNK_SIZE * tileSize slot per view
+    long tilesRedrawn;              // tiles drawn into slots so far
+    uint32_t imageRevision;         // bumped whenever a view is redrawn or unloaded
+
+    double rebuildBudgetMs;         // MAP_RENDER_REBUILD_BUDGET_MS, <= 0 for no limit
+    MapRebuildEntry* rebuildQueue;  // scratch, viewCapacity entries
+    MapRebuildStats rebuild;
+    Rectangle lastView;             // world pixels seen by the last render
+    bool hasLastView;
+
+    // Super-chunks of the level in use, built from the chunk slots; a separate
+    // pool so a super-chunk is never drawn into the page it samples from
+    RenderTexturePool lodPool;
+    MapLodView* lodViews;
+    int lodViewCount;
+    int lodViewCapacity;
+    ChunkMap lodLookup[MAP_RENDER_LOD_LEVELS - 1];  // level L at [L - 1]: (superX, superY) -> MapLodView*
+    int lodLevel;  // level chosen by the last render, 0 draws chunk views
+
+    MapChunkView* views;
+    int viewCount;
+    int viewCapacity;
+    ChunkMap viewLookup;  // (chunkX, chunkY) -> MapChunkView*
+
+    MapObserver observers[MAP_RENDER_MAX_OBSERVERS];
+    int observerCount;
+} MapRenderSystem;
+
+void MapRenderSystem_init(MapRenderSystem* sys, Arena_T arena, World* world, Atlas* atlas,
+                          int tileSize, int loadRadius, int unloadRadius);
+void MapRenderSystem_cleanup(MapRenderSystem* sys);
+
+bool MapRenderSystem_add_entity_observer(MapRenderSystem* sys, ECS* ecs, EntityId entity, ComponentTypeId positionTypeId);
+
+// Loads/unloads chunk views around observers and redraws stale ones
+void MapRenderSystem_update(MapRenderSystem* sys);
+
+// Queues a draw of every loaded chunk (or super-chunk, by zoom) that intersects the camera view
+void MapRenderSystem_render(MapRenderSystem* sys, RenderLayer* layer, const Camera2DEx* cam, AspectFit fit);
+
+// Detail level for a zoom: the largest L with zoom * 2^L <= 1
+int MapRenderSystem_lod_level(float zoom);
+
+// Converts a screen position to tile coordinates (floors, so negatives work)
+bool MapRenderSystem_screen_to_tile(const MapRenderSystem* sys, const Camera2DEx* cam, AspectFit fit,
+                                    Vector2 screenPos, int* outTileX, int* outTileY);
+
+#endif // MAP_RENDER_SYSTEM_H
@@ -3,6 +3,27 @@
 
 #include "systems/game_state.h"
 
+// Background of the composited frame, the colour main.c clears the screen to
+#define RENDER_FRAME_BACKGROUND (Color){ 255, 0, 0, 255 }
+
+// Creates the world pipeline and its layers
+void RenderSystem_init(GameState* state);
+// Releases the frame and world render textures
+void RenderSystem_cleanup(GameState* state);
+
+// Queues the map, entities and debug overlay into the pipeline, executes
+// it, then lays out and draws the UI.
+//
+// With a window the frame is composited into state->screen.renderFrame and
+// then drawn to the screen. When no input arrived and the FrameSignature
+// (camera, fit, entity and chunk image revisions, turn, health, pointer, popup)
+// matches the one the cached frame was drawn from, the cached frame is
+// drawn again instead, which skips the pipeline and the UI layout.
+//
+// With state->logicalTarget (off unless main.c's LOGICAL_SCALE is above 1)
+// and a fit that scales up, the world and entity layers are drawn at
+// cam.logicalSize into state->screen.worldFrame and blitted once into
+// fit.dest; the overlay and UI stay at window resolution.
 void RenderSystem_render(GameState* state, AspectFit fit);
 
 #endif // RENDER_SYSTEM_H
@@ -0,0 +1,50 @@
+#ifndef ROOM_SYSTEM_H
+#define ROOM_SYSTEM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Smallest room interior; cells that cannot fit one get a junction instead
+#define ROOM_MIN_SIZE 4
+// One in this many cells gets a junction even when a room would fit
+#define ROOM_JUNCTION_CHANCE 8
+
+// Axis-aligned room interior in tile coordinates. A 1x1 room is a corridor
+// junction: it only gives the corridors of an empty cell something to meet at.
+typedef struct Room {
+    int x;
+    int y;
+    int width;
+    int height;
+} Room;
+
+// xorshift32; a generator state must never be 0
+static inline uint32_t RoomSystem_rand(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static inline int Room_center_x(const Room* room) { return room->x + room->width / 2; }
+static inline int Room_center_y(const Room* room) { return room->y + room->height / 2; }
+
+// Places a room inside the cell, leaving at least one tile of wall to the
+// cell border. Depends only on seed and the cell, so cells can be placed in
+// any order and on any thread.
+Room RoomSystem_place(uint32_t seed, int cellX, int cellY, int cellWidth, int cellHeight);
+
+// Writes tile_id over the part of rect that lies inside the clip rect.
+// tiles is a row-major grid of stride columns whose origin is tile (0, 0).
+void RoomSystem_carve(uint16_t* tiles, int stride, Room rect, Room clip, uint16_t tile_id);
+
+// Carves an L-shaped corridor between two points, clipped like RoomSystem_carve.
+// Only tiles equal to wall are replaced, so rooms keep their floor and
+// overlapping corridors give the same result in any order.
+void RoomSystem_carve_corridor(uint16_t* tiles, int stride, Room clip,
+                               int x0, int y0, int x1, int y1, bool horizontalFirst,
+                               uint16_t wall, uint16_t tile_id);
+
+#endif // ROOM_SYSTEM_H
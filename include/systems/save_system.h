@@ -0,0 +1,96 @@
+#ifndef SAVE_SYSTEM_H
+#define SAVE_SYSTEM_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "components/world.h"
+#include "components/region_file.h"
+#include "components/tile_journal.h"
+
+#ifdef USE_THREADING
+#include <pthread.h>
+#endif
+
+// A snapshot is saved once the journal segment grows past this, or after
+// SAVE_AUTOSAVE_FRAMES frames with unsaved edits
+#define SAVE_COMPACT_BYTES (256u * 1024u)
+#define SAVE_AUTOSAVE_FRAMES 3600
+// stdio buffer of the open journal segment
+#define SAVE_JOURNAL_BUFFER (64u * 1024u)
+
+// Persists tile edits. TileUpdateSystem records every edit it applies into
+// `journal`; once per frame SaveSystem_update hands the records to a writer
+// thread that appends them to the current journal segment
+// (journal.<n>.bin) with buffered I/O.
+//
+// Autosave seals the segment and freezes the world in the same frame
+// (World_freeze: copy-on-write, so O(chunks) and no tile copies). The writer
+// streams the frozen chunks into snapshots (region files in the save
+// directory) while play continues, then records the sealed segment in a
+// manifest and deletes every segment up to it. Loading generates chunks
+// from their snapshots and replays only the segments after the manifest's.
+typedef struct SaveSystem {
+    World* world;
+    char directory[REGION_PATH_MAX];
+    bool open;
+
+    // Main thread
+    TileJournal journal;    // edits recorded since the last update
+    uint32_t segment;       // segment new records belong to
+    size_t segmentBytes;
+    RegionStore readStore;  // snapshot reads for chunks generated by the chunk stream workers
+#ifdef USE_THREADING
+    pthread_mutex_t readLock;   // guards readStore; the workers generate concurrently
+#endif
+    WorldGenerateFn generator;  // the world's own generator, used where no snapshot exists
+    void* generatorData;
+    uint32_t seed;
+
+    WorldSnapshot frozen;   // chunks changed up to the sealed segment, read by the writer
+    bool saving;            // frozen is in flight
+    uint32_t framesSinceSave;
+
+    // Handed from the main thread to the writer
+    TileJournal pending;    // records for the open segment
+    TileJournal sealed;     // last records of the segment being closed by an autosave
+    bool sealRequested;
+    bool saveDone;          // writer finished with frozen
+#ifdef USE_THREADING
+    pthread_t thread;
+    pthread_mutex_t lock;   // guards pending, sealed, sealRequested, saveDone, saveFailed and running
+    pthread_cond_t wake;
+    bool running;
+    bool threaded;
+#endif
+
+    // Writer
+    FILE* file;
+    uint32_t fileSegment;   // segment the open file belongs to
+    uint32_t closedSegment; // newest segment that is complete on disk
+    uint32_t savedSegment;  // newest segment covered by the snapshots
+    bool saveFailed;        // stop autosaving; the segments stay on disk and are replayed on load
+    RegionStore snapshots;
+    RegionStore pages;      // the world's paging store, for frozen chunks that were paged out
+    TileJournal writing;    // records taken from pending, being written
+    TileJournal closing;    // records taken from sealed, being written
+
+    long replayed;          // records replayed by SaveSystem_open
+    long bytesWritten;
+    long saves;
+    long savedChunks;
+    long failures;
+} SaveSystem;
+
+// Restores the save in directory (created if missing) into world and starts
+// journaling. Register the world's generator first and open the save before
+// anything else touches the world.
+bool SaveSystem_open(SaveSystem* sys, World* world, const char* directory);
+// Writes out every recorded edit and stops the writer; segments after the last save are replayed next time
+void SaveSystem_close(SaveSystem* sys);
+
+// Hands this frame's records to the writer and seals the segment when it is due for compaction
+void SaveSystem_update(SaveSystem* sys);
+
+#endif // SAVE_SYSTEM_H
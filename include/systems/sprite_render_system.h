@@ -0,0 +1,47 @@
+#ifndef SPRITE_RENDER_SYSTEM_H
+#define SPRITE_RENDER_SYSTEM_H
+
+#include <stdbool.h>
+
+#include "camera.h"
+#include "gramarye_ecs/ecs.h"
+#include "textures/atlas.h"
+#include "components/spatial_index.h"
+#include "renderer/render_layer.h"
+
+// Draws the entities of a SpatialIndex that have a Sprite. Each frame it
+// asks the index for the tiles under the camera view, gathers those with a
+// Sprite into flat arrays, transforms them to screen space in one pass, and
+// queues them grouped by atlas, so each atlas texture is one contiguous
+// batch. Entities off screen are never visited.
+typedef struct SpriteRenderSystem {
+    ECS* ecs;
+    const SpatialIndex* index;
+    ComponentTypeId spriteTypeId;
+    int tileSize;
+
+    // Visible sprites of the current frame, grown to the largest query seen
+    int capacity;
+    SpatialHit* hits;
+    float* x;           // world, then screen position
+    float* y;
+    Atlas** atlases;
+    int* tileIds;
+    int* batchOf;       // batch index of each visible sprite
+    int* order;         // visible sprite indices grouped by batch
+    Atlas** batchAtlases;
+    int* batchOffsets;  // batch b is order[batchOffsets[b], batchOffsets[b + 1])
+
+    // Last render
+    int visibleCount;
+    int batchCount;
+} SpriteRenderSystem;
+
+void SpriteRenderSystem_init(SpriteRenderSystem* sys, ECS* ecs, const SpatialIndex* index,
+                             ComponentTypeId spriteTypeId, int tileSize);
+void SpriteRenderSystem_cleanup(SpriteRenderSystem* sys);
+
+// Queues one texture command per visible sprite into layer, grouped by atlas
+void SpriteRenderSystem_render(SpriteRenderSystem* sys, RenderLayer* layer, const Camera2DEx* cam, AspectFit fit);
+
+#endif // SPRITE_RENDER_SYSTEM_H
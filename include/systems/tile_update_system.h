@@ -0,0 +1,47 @@
+#ifndef TILE_UPDATE_SYSTEM_H
+#define TILE_UPDATE_SYSTEM_H
+
+#include "components/tile_storage.h"
+#include "components/tile_journal.h"
+#include "gramarye_event_bus/event_bus.h"
+#include "gramarye_chunk_controller/tile_update_queue.h"
+#include "gramarye_chunk_controller/chunk_manager_system.h"
+
+// Published once per processed queue batch and once per bulk edit,
+// with a TileRegionEvent payload covering every tile that was written:
+// bulk edits report their rectangle clipped to the map.
+#define EVENT_TILE_REGION_UPDATED 0x0201
+
+typedef struct TileRegionEvent {
+    int x;
+    int y;
+    int width;
+    int height;
+} TileRegionEvent;
+
+// Applies tile edits to the map. World chunks record their own revision,
+// so renderers pick up the change without a separate dirty list; a table's
+// chunks are marked dirty in the ChunkManagerSystem that drains its queue.
+// Edits outside a table map are dropped.
+typedef struct TileUpdateSystem {
+    TileStorage* map;
+    EventBus* eventBus;
+    TileJournal* journal;             // every applied edit is recorded here when set
+    ChunkManagerSystem* chunkManager; // table storage: bulk edits mark each chunk they cover once
+} TileUpdateSystem;
+
+void TileUpdateSystem_init(TileUpdateSystem* sys, TileStorage* map, EventBus* eventBus);
+// Records applied edits into journal (NULL stops recording)
+void TileUpdateSystem_set_journal(TileUpdateSystem* sys, TileJournal* journal);
+// Marks bulk edits dirty in chunkManager, for table storage (NULL stops marking)
+void TileUpdateSystem_set_chunk_manager(TileUpdateSystem* sys, ChunkManagerSystem* chunkManager);
+
+// Drains the queue, returns the number of updates applied
+int TileUpdateSystem_process_updates(TileUpdateSystem* sys, TileUpdateQueue* queue);
+
+// Bulk edits, applied immediately. Each returns the number of chunks touched.
+int TileUpdateSystem_fill_rect(TileUpdateSystem* sys, int x, int y, int width, int height, uint16_t tile_id);
+int TileUpdateSystem_blit(TileUpdateSystem* sys, int x, int y, int width, int height, const uint16_t* src, int srcStride);
+int TileUpdateSystem_copy_region(TileUpdateSystem* sys, int srcX, int srcY, int width, int height, int dstX, int dstY);
+
+#endif // TILE_UPDATE_SYSTEM_H
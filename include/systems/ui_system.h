@@ -8,9 +8,19 @@ void UISystem_set_pointer_state(GameState* state, Vector2 mousePos, bool mouseDo
 void UISystem_draw_hud(GameState* state);
 void UISystem_draw_popup(GameState* state);
 void UISystem_update_popup_interactions(GameState* state, bool mousePressedThisFrame);
+// Sets the pointer state, then draws the cached render commands again if
+// no input of any UI section (render size, HUD values, popup visibility,
+// offset and hover) changed since they were laid out. Returns false when
+// a layout is needed, i.e. begin, draw_hud, draw_popup, end_and_render.
+bool UISystem_replay(GameState* state, Vector2 mousePos, bool mouseDown);
+// Ends the layout, records its hit regions into state->uiHits, caches its
+// render commands for UISystem_replay, and draws it
 void UISystem_end_and_render(GameState* state);
 bool UISystem_is_pointer_over_ui(GameState* state);
-bool UISystem_check_ui_blocking(GameState* state, Vector2 mousePos, bool mouseDown);
+// Whether a click at mousePos lands on UI that captures the pointer. Looks
+// the point up in the regions of the last completed layout, so it costs no
+// layout pass however many clicks arrive in a frame.
+bool UISystem_check_ui_blocking(const GameState* state, Vector2 mousePos);
 
 #endif // UI_SYSTEM_H
 
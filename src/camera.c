@@ -59,11 +59,15 @@ Vector2 Camera_ScreenToWorld(const Camera2DEx *cam, AspectFit fit, Vector2 scree
 }
 
 void Camera_ClampToBounds(Camera2DEx *cam, Vector2 mapPixelSize, AspectFit fit) {
+    Camera_ClampToRect(cam, (Rectangle){ 0.0f, 0.0f, mapPixelSize.x, mapPixelSize.y }, fit);
+}
+
+void Camera_ClampToRect(Camera2DEx *cam, Rectangle worldRect, AspectFit fit) {
     // Visible size in world pixels under current zoom
     float vw = cam->logicalSize.x / cam->zoom;
     float vh = cam->logicalSize.y / cam->zoom;
-    float maxX = mapPixelSize.x - vw;
-    float maxY = mapPixelSize.y - vh;
-    cam->pos.x = clampf(cam->pos.x, 0.0f, maxX > 0 ? maxX : 0.0f);
-    cam->pos.y = clampf(cam->pos.y, 0.0f, maxY > 0 ? maxY : 0.0f);
+    float maxX = worldRect.x + worldRect.width - vw;
+    float maxY = worldRect.y + worldRect.height - vh;
+    cam->pos.x = clampf(cam->pos.x, worldRect.x, maxX > worldRect.x ? maxX : worldRect.x);
+    cam->pos.y = clampf(cam->pos.y, worldRect.y, maxY > worldRect.y ? maxY : worldRect.y);
 }
@@ -1,41 +1,155 @@
-// #include "chunk.h"
-
-
-// Chunk* Chunk_new(int x, int y) {
-//     Chunk* chunk = (Chunk*)Arena_alloc(arena, sizeof(Chunk), __FILE__, __LINE__);
-//     chunk->x = x;
-//     chunk->y = y;
-//     chunk->data = (ChunkData*)Arena_alloc(arena, sizeof(ChunkData), __FILE__, __LINE__);
-//     chunk->data->entityArena = Arena_new();
-//     chunk->data->itemArena = Arena_new();
-//     chunk->data->tileArena = Arena_new();
-//     return chunk;
-// }
-
-// void Chunk_load(Chunk *chunk) {
-//     chunk->data->entityArena = Arena_new();
-//     chunk->data->itemArena = Arena_new();
-//     chunk->data->tileArena = Arena_new();
-// }
-// void Chunk_unload(Chunk *chunk);
-// /// @brief Sets a tile at the specified coordinates within the chunk
-// /// @param chunk 
-// /// @param x 
-// /// @param y 
-// /// @param tile_id
-// void Chunk_set_tile(Chunk *chunk, int x, int y, Tile *tile);
-// /// @brief Gets a tile at the specified coordinates within the chunk
-// /// @param chunk 
-// /// @param x 
-// /// @param y 
-// /// @return Tile*
-// Tile* Chunk_get_tile(Chunk *chunk, int x, int y);
-// /// @brief Moves an entity from one chunk to another
-// /// @param fromChunk 
-// /// @param toChunk 
-// /// @param entityId
-// void Chunk_move_entity_to_Chunk(Chunk *fromChunk, Chunk *toChunk, int entityId);
-// /// @brief Offloads an entity from the chunk to the world (removes from chunk)
-// /// @param fromChunk 
-// /// @param entityId
-// void Chunk_offload_entity_to_world(Chunk *fromChunk, int entityId);
\ No newline at end of file
+#include "components/chunk.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "components/chunk_codec.h"
+#include "components/region_file.h"
+
+Chunk* Chunk_new(Arena_T arena, int chunkX, int chunkY, uint16_t fill) {
+    Chunk* chunk = arena ? (Chunk*)Arena_alloc(arena, sizeof(Chunk), __FILE__, __LINE__)
+                         : (Chunk*)malloc(sizeof(Chunk));
+    if (!chunk) return NULL;
+    chunk->chunkX = chunkX;
+    chunk->chunkY = chunkY;
+    chunk->revision = 0;
+    chunk->tiles = (uint16_t*)malloc(sizeof(uint16_t) * CHUNK_AREA);
+    chunk->resident = chunk->tiles != NULL;
+    chunk->cold = false;
+    chunk->stored = false;
+    chunk->loading = false;
+    chunk->storedRevision = 0;
+    chunk->generated = false;
+    chunk->generating = false;
+    chunk->generatedRevision = 0;
+    chunk->packed = NULL;
+    chunk->packedSize = 0;
+    chunk->lastUsedFrame = 0;
+    chunk->lruPrev = NULL;
+    chunk->lruNext = NULL;
+    chunk->shared = false;
+    chunk->pinned = false;
+    if (chunk->tiles) Chunk_fill(chunk, fill);
+    chunk->savedRevision = chunk->revision;
+    Chunk_clear_dirty(chunk);
+    return chunk;
+}
+
+void Chunk_fill(Chunk* chunk, uint16_t tile_id) {
+    if (chunk->shared && !Chunk_unshare(chunk)) return;
+    for (int i = 0; i < CHUNK_AREA; i++) {
+        chunk->tiles[i] = tile_id;
+    }
+    chunk->revision++;
+    chunk->dirtyBlocks = CHUNK_DIRTY_ALL;
+}
+
+void Chunk_mark_dirty_rect(Chunk* chunk, int localX, int localY, int width, int height) {
+    if (!chunk || width <= 0 || height <= 0) return;
+    int bx0 = localX >> CHUNK_DIRTY_SHIFT, bx1 = (localX + width - 1) >> CHUNK_DIRTY_SHIFT;
+    int by0 = localY >> CHUNK_DIRTY_SHIFT, by1 = (localY + height - 1) >> CHUNK_DIRTY_SHIFT;
+    // Bits bx0..bx1 of one block row, then repeated for each row
+    uint64_t row = ((((uint64_t)1 << (bx1 - bx0 + 1)) - 1) << bx0);
+    for (int by = by0; by <= by1; by++) {
+        chunk->dirtyBlocks |= row << (by * CHUNK_DIRTY_BLOCKS);
+    }
+}
+
+bool Chunk_unshare(Chunk* chunk) {
+    // A shared encoding is never written in place, decompressing replaces it
+    if (!chunk || !chunk->shared || !chunk->tiles) return true;
+    uint16_t* tiles = (uint16_t*)malloc(sizeof(uint16_t) * CHUNK_AREA);
+    if (!tiles) return false;
+    memcpy(tiles, chunk->tiles, sizeof(uint16_t) * CHUNK_AREA);
+    chunk->tiles = tiles;  // the old array now belongs to the snapshot alone
+    chunk->shared = false;
+    return true;
+}
+
+// Drops the chunk's current buffer, unless a snapshot still needs it
+static void release_buffer(Chunk* chunk, void* buffer) {
+    if (chunk->shared) {
+        chunk->shared = false;
+    } else {
+        free(buffer);
+    }
+}
+
+void Chunk_free(Chunk* chunk) {
+    if (!chunk) return;
+    release_buffer(chunk, chunk->tiles ? (void*)chunk->tiles : (void*)chunk->packed);
+    chunk->tiles = NULL;
+    chunk->packed = NULL;
+    chunk->packedSize = 0;
+    chunk->resident = false;
+}
+
+bool Chunk_compress(Chunk* chunk) {
+    if (!chunk || !chunk->resident) return false;
+
+    uint8_t scratch[CHUNK_CODEC_RAW_SIZE];
+    uint32_t size = ChunkCodec_encode(chunk->tiles, scratch);
+    if (size == 0) return false;
+    uint8_t* packed = (uint8_t*)malloc(size);
+    if (!packed) return false;
+    memcpy(packed, scratch, size);
+
+    release_buffer(chunk, chunk->tiles);
+    chunk->tiles = NULL;
+    chunk->resident = false;
+    chunk->packed = packed;
+    chunk->packedSize = size;
+    return true;
+}
+
+bool Chunk_decompress(Chunk* chunk) {
+    if (!chunk) return false;
+    if (chunk->resident) return true;
+    if (!chunk->packed) return false;
+
+    uint16_t* tiles = (uint16_t*)malloc(sizeof(uint16_t) * CHUNK_AREA);
+    if (!tiles) return false;
+    if (!ChunkCodec_decode(chunk->packed, chunk->packedSize, tiles)) {
+        free(tiles);
+        return false;
+    }
+    release_buffer(chunk, chunk->packed);
+    chunk->packed = NULL;
+    chunk->packedSize = 0;
+    chunk->tiles = tiles;
+    chunk->resident = true;
+    return true;
+}
+
+bool Chunk_load(Chunk* chunk, RegionStore* store) {
+    if (!chunk) return false;
+    if (chunk->resident) return true;
+    if (chunk->packed) return Chunk_decompress(chunk);
+    if (!chunk->stored) return false;
+
+    uint16_t* tiles = (uint16_t*)malloc(sizeof(uint16_t) * CHUNK_AREA);
+    if (!tiles) return false;
+    if (!RegionStore_read_tiles(store, chunk->chunkX, chunk->chunkY, tiles)) {
+        free(tiles);
+        return false;
+    }
+    chunk->tiles = tiles;
+    chunk->resident = true;
+    return true;
+}
+
+bool Chunk_unload(Chunk* chunk, RegionStore* store) {
+    if (!chunk) return false;
+    if (!chunk->resident && !chunk->packed) return true;
+
+    // An unchanged chunk already has an up to date copy on disk
+    if (!chunk->stored || chunk->storedRevision != chunk->revision) {
+        bool written = chunk->packed
+            ? RegionStore_write(store, chunk->chunkX, chunk->chunkY, chunk->packed, chunk->packedSize)
+            : RegionStore_write_tiles(store, chunk->chunkX, chunk->chunkY, chunk->tiles);
+        if (!written) return false;
+        chunk->stored = true;
+        chunk->storedRevision = chunk->revision;
+    }
+    Chunk_free(chunk);
+    return true;
+}
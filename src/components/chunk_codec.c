@@ -0,0 +1,145 @@
+#include "components/chunk_codec.h"
+
+#include <string.h>
+
+#define CODEC_HEADER_SIZE 4
+#define PALETTE_MAX 256
+#define PALETTE_SLOTS 512  // open-addressing lookup, twice the palette limit
+
+// Maps every tile to a palette index, returns the palette size or 0 past PALETTE_MAX
+static int build_palette(const uint16_t* tiles, uint16_t* palette, uint8_t* indices) {
+    uint16_t slotKey[PALETTE_SLOTS];
+    int16_t slotIndex[PALETTE_SLOTS];
+    memset(slotIndex, 0xFF, sizeof(slotIndex));
+
+    int count = 0;
+    uint16_t lastTile = 0;
+    int lastIndex = -1;
+    for (int i = 0; i < CHUNK_AREA; i++) {
+        uint16_t tile = tiles[i];
+        if (tile == lastTile && lastIndex >= 0) {
+            indices[i] = (uint8_t)lastIndex;
+            continue;
+        }
+        uint32_t slot = ((uint32_t)tile * 0x9E37u) & (PALETTE_SLOTS - 1);
+        while (slotIndex[slot] >= 0 && slotKey[slot] != tile) slot = (slot + 1) & (PALETTE_SLOTS - 1);
+        if (slotIndex[slot] < 0) {
+            if (count == PALETTE_MAX) return 0;
+            slotKey[slot] = tile;
+            slotIndex[slot] = (int16_t)count;
+            palette[count++] = tile;
+        }
+        lastTile = tile;
+        lastIndex = slotIndex[slot];
+        indices[i] = (uint8_t)lastIndex;
+    }
+    return count;
+}
+
+static int count_runs(const uint8_t* indices) {
+    int runs = 0;
+    for (int i = 0; i < CHUNK_AREA; ) {
+        int len = 1;
+        while (i + len < CHUNK_AREA && len < 256 && indices[i + len] == indices[i]) len++;
+        i += len;
+        runs++;
+    }
+    return runs;
+}
+
+static int bits_for_palette(int count) {
+    if (count <= 2) return 1;
+    if (count <= 4) return 2;
+    if (count <= 16) return 4;
+    return 8;
+}
+
+uint32_t ChunkCodec_encode(const uint16_t* tiles, uint8_t* out) {
+    if (!tiles || !out) return 0;
+
+    uint16_t palette[PALETTE_MAX];
+    uint8_t indices[CHUNK_AREA];
+    int paletteCount = build_palette(tiles, palette, indices);
+    if (paletteCount == 0) return 0;
+
+    uint32_t prefix = CODEC_HEADER_SIZE + (uint32_t)paletteCount * sizeof(uint16_t);
+    uint32_t rleSize = prefix + (uint32_t)count_runs(indices) * 2;
+    int bits = bits_for_palette(paletteCount);
+    uint32_t packedSize = prefix + (uint32_t)(CHUNK_AREA * bits / 8);
+
+    bool useRle = rleSize <= packedSize;
+    uint32_t size = useRle ? rleSize : packedSize;
+    if (size >= CHUNK_CODEC_RAW_SIZE) return 0;
+
+    uint16_t count16 = (uint16_t)paletteCount;
+    out[0] = useRle ? CHUNK_CODEC_MODE_RLE : CHUNK_CODEC_MODE_PACKED;
+    out[1] = (uint8_t)(useRle ? 8 : bits);
+    memcpy(&out[2], &count16, sizeof(count16));
+    memcpy(&out[CODEC_HEADER_SIZE], palette, (size_t)paletteCount * sizeof(uint16_t));
+
+    uint8_t* body = out + prefix;
+    if (useRle) {
+        for (int i = 0; i < CHUNK_AREA; ) {
+            int len = 1;
+            while (i + len < CHUNK_AREA && len < 256 && indices[i + len] == indices[i]) len++;
+            *body++ = (uint8_t)(len - 1);
+            *body++ = indices[i];
+            i += len;
+        }
+    } else {
+        int perByte = 8 / bits;
+        for (int i = 0; i < CHUNK_AREA; i += perByte) {
+            uint8_t packed = 0;
+            for (int k = 0; k < perByte; k++) packed |= (uint8_t)(indices[i + k] << (k * bits));
+            *body++ = packed;
+        }
+    }
+    return size;
+}
+
+bool ChunkCodec_decode(const uint8_t* in, uint32_t size, uint16_t* tiles) {
+    if (!in || !tiles || size < CODEC_HEADER_SIZE) return false;
+
+    uint16_t paletteCount;
+    memcpy(&paletteCount, &in[2], sizeof(paletteCount));
+    if (paletteCount == 0 || paletteCount > PALETTE_MAX) return false;
+    uint32_t prefix = CODEC_HEADER_SIZE + (uint32_t)paletteCount * sizeof(uint16_t);
+    if (size < prefix) return false;
+
+    uint16_t palette[PALETTE_MAX];
+    memcpy(palette, &in[CODEC_HEADER_SIZE], (size_t)paletteCount * sizeof(uint16_t));
+    const uint8_t* body = in + prefix;
+    uint32_t bodySize = size - prefix;
+
+    if (in[0] == CHUNK_CODEC_MODE_RLE) {
+        if (bodySize % 2 != 0) return false;
+        int i = 0;
+        for (uint32_t p = 0; p < bodySize; p += 2) {
+            int len = body[p] + 1;
+            uint8_t index = body[p + 1];
+            if (index >= paletteCount || i + len > CHUNK_AREA) return false;
+            uint16_t tile = palette[index];
+            for (int k = 0; k < len; k++) tiles[i + k] = tile;
+            i += len;
+        }
+        return i == CHUNK_AREA;
+    }
+
+    if (in[0] == CHUNK_CODEC_MODE_PACKED) {
+        int bits = in[1];
+        if (bits != 1 && bits != 2 && bits != 4 && bits != 8) return false;
+        if (bodySize != (uint32_t)(CHUNK_AREA * bits / 8)) return false;
+        int perByte = 8 / bits;
+        uint8_t mask = (uint8_t)((1u << bits) - 1);
+        for (int i = 0; i < CHUNK_AREA; i += perByte) {
+            uint8_t packed = body[i / perByte];
+            for (int k = 0; k < perByte; k++) {
+                uint8_t index = (uint8_t)((packed >> (k * bits)) & mask);
+                if (index >= paletteCount) return false;
+                tiles[i + k] = palette[index];
+            }
+        }
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,92 @@
+#include "components/chunkmap.h"
+
+#include <stdlib.h>
+
+static uint32_t chunk_hash(int chunkX, int chunkY) {
+    uint32_t h = (uint32_t)chunkX * 0x9E3779B1u ^ (uint32_t)chunkY * 0x85EBCA77u;
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    return h;
+}
+
+static int find_slot(const ChunkMap* map, int chunkX, int chunkY) {
+    int mask = map->capacity - 1;
+    int i = (int)(chunk_hash(chunkX, chunkY) & (uint32_t)mask);
+    while (map->entries[i].value) {
+        if (map->entries[i].chunkX == chunkX && map->entries[i].chunkY == chunkY) return i;
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static void resize(ChunkMap* map, int capacity) {
+    ChunkMapEntry* old = map->entries;
+    int oldCapacity = map->capacity;
+
+    map->entries = (ChunkMapEntry*)calloc((size_t)capacity, sizeof(ChunkMapEntry));
+    map->capacity = capacity;
+    for (int i = 0; i < oldCapacity; i++) {
+        if (!old[i].value) continue;
+        map->entries[find_slot(map, old[i].chunkX, old[i].chunkY)] = old[i];
+    }
+    free(old);
+}
+
+void ChunkMap_init(ChunkMap* map, int initialCapacity) {
+    int capacity = 16;
+    while (capacity * 3 / 4 < initialCapacity) capacity <<= 1;
+    map->entries = (ChunkMapEntry*)calloc((size_t)capacity, sizeof(ChunkMapEntry));
+    map->capacity = capacity;
+    map->count = 0;
+}
+
+void ChunkMap_free(ChunkMap* map) {
+    if (!map) return;
+    free(map->entries);
+    map->entries = NULL;
+    map->capacity = 0;
+    map->count = 0;
+}
+
+void* ChunkMap_get(const ChunkMap* map, int chunkX, int chunkY) {
+    if (!map || map->capacity == 0) return NULL;
+    return map->entries[find_slot(map, chunkX, chunkY)].value;
+}
+
+void ChunkMap_put(ChunkMap* map, int chunkX, int chunkY, void* value) {
+    if (!map || !value) return;
+    if ((map->count + 1) * 4 > map->capacity * 3) resize(map, map->capacity * 2);
+
+    ChunkMapEntry* entry = &map->entries[find_slot(map, chunkX, chunkY)];
+    if (!entry->value) map->count++;
+    entry->chunkX = chunkX;
+    entry->chunkY = chunkY;
+    entry->value = value;
+}
+
+void* ChunkMap_remove(ChunkMap* map, int chunkX, int chunkY) {
+    if (!map || map->capacity == 0) return NULL;
+    int mask = map->capacity - 1;
+    int hole = find_slot(map, chunkX, chunkY);
+    void* removed = map->entries[hole].value;
+    if (!removed) return NULL;
+
+    // Backward-shift: pull later entries of the probe run into the hole
+    // whenever the hole lies between their home slot and where they sit.
+    int i = hole;
+    for (;;) {
+        i = (i + 1) & mask;
+        ChunkMapEntry* e = &map->entries[i];
+        if (!e->value) break;
+        int home = (int)(chunk_hash(e->chunkX, e->chunkY) & (uint32_t)mask);
+        bool movable = hole <= i ? (home <= hole || home > i) : (home <= hole && home > i);
+        if (movable) {
+            map->entries[hole] = *e;
+            hole = i;
+        }
+    }
+    map->entries[hole].value = NULL;
+    map->count--;
+    return removed;
+}
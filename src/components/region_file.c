@@ -0,0 +1,181 @@
+#include "components/region_file.h"
+#include "components/chunk_codec.h"
+
+#include <string.h>
+#include <errno.h>
+
+#include "raylib.h"
+#ifdef _WIN32
+#include <direct.h>
+#define make_dir(path) _mkdir(path)
+#else
+#include <sys/stat.h>
+#define make_dir(path) mkdir(path, 0755)
+#endif
+
+static const char REGION_MAGIC[4] = { 'G', 'R', 'R', 'G' };
+
+// mkdir -p: creates every missing component of path
+static bool make_dirs(const char* path) {
+    char buffer[REGION_PATH_MAX];
+    size_t len = strlen(path);
+    if (len == 0 || len >= sizeof(buffer)) return false;
+    memcpy(buffer, path, len + 1);
+
+    for (size_t i = 1; i <= len; i++) {
+        if (buffer[i] != '/' && buffer[i] != '\\' && buffer[i] != '\0') continue;
+        char saved = buffer[i];
+        buffer[i] = '\0';
+        if (make_dir(buffer) != 0 && errno != EEXIST) return false;
+        buffer[i] = saved;
+    }
+    return true;
+}
+
+static FILE* open_region(RegionStore* store, int regionX, int regionY) {
+    if (store->file && store->regionX == regionX && store->regionY == regionY) return store->file;
+    RegionStore_close(store);
+
+    char path[REGION_PATH_MAX];
+    int n = snprintf(path, sizeof(path), "%s/r.%d.%d.bin", store->directory, regionX, regionY);
+    if (n < 0 || n >= (int)sizeof(path)) return NULL;
+
+    FILE* file = fopen(path, store->readOnly ? "rb" : "r+b");
+    if (file) {
+        setvbuf(file, NULL, _IONBF, 0);
+        char magic[4];
+        uint32_t version = 0;
+        size_t headerBytes = fread(magic, 1, 4, file);
+        if (headerBytes != 4 || memcmp(magic, REGION_MAGIC, 4) != 0 ||
+            fread(&version, sizeof(version), 1, file) != 1 || version != REGION_VERSION) {
+            fclose(file);
+            file = NULL;
+            // Unknown layout: never misread it, and only a page cache may throw it away.
+            // An empty file was cut short before its header, so it holds nothing.
+            if (!store->scratch && headerBytes != 0) {
+                TraceLog(LOG_WARNING, "RegionStore: %s is not a version %u region file, leaving it untouched",
+                         path, REGION_VERSION);
+                return NULL;
+            }
+        }
+    }
+    if (!file && store->readOnly) return NULL;
+    if (!file) {
+        file = fopen(path, "w+b");
+        if (!file) return NULL;
+        setvbuf(file, NULL, _IONBF, 0);
+        uint32_t version = REGION_VERSION;
+        if (fwrite(REGION_MAGIC, 1, 4, file) != 4 || fwrite(&version, sizeof(version), 1, file) != 1) {
+            fclose(file);
+            return NULL;
+        }
+    }
+
+    store->file = file;
+    store->regionX = regionX;
+    store->regionY = regionY;
+    return file;
+}
+
+static int chunk_index(int chunkX, int chunkY) {
+    return ((chunkY & REGION_MASK) << REGION_SHIFT) | (chunkX & REGION_MASK);
+}
+
+static long index_offset(int chunkX, int chunkY) {
+    return REGION_HEADER_SIZE + (long)chunk_index(chunkX, chunkY) * 4;
+}
+
+static long slot_offset(int chunkX, int chunkY, int slot) {
+    return REGION_HEADER_SIZE + REGION_INDEX_SIZE +
+           ((long)chunk_index(chunkX, chunkY) * 2 + slot) * REGION_SLOT_PAYLOAD;
+}
+
+// Index entry of a chunk; past the end of a new file every entry is empty
+static uint32_t read_entry(FILE* file, int chunkX, int chunkY) {
+    uint32_t entry = 0;
+    if (fseek(file, index_offset(chunkX, chunkY), SEEK_SET) != 0) return 0;
+    if (fread(&entry, sizeof(entry), 1, file) != 1) return 0;
+    return entry;
+}
+
+static bool init_store(RegionStore* store, const char* directory, bool readOnly, bool scratch) {
+    if (!store || !directory) return false;
+    size_t len = strlen(directory);
+    if (len == 0 || len >= sizeof(store->directory)) return false;
+    memcpy(store->directory, directory, len + 1);
+    store->readOnly = readOnly;
+    store->scratch = scratch;
+    store->file = NULL;
+    store->regionX = store->regionY = 0;
+    return true;
+}
+
+bool RegionStore_open(RegionStore* store, const char* directory) {
+    return init_store(store, directory, false, false) && make_dirs(store->directory);
+}
+
+bool RegionStore_open_scratch(RegionStore* store, const char* directory) {
+    return init_store(store, directory, false, true) && make_dirs(store->directory);
+}
+
+bool RegionStore_open_readonly(RegionStore* store, const char* directory) {
+    return init_store(store, directory, true, false);
+}
+
+void RegionStore_close(RegionStore* store) {
+    if (!store || !store->file) return;
+    fclose(store->file);
+    store->file = NULL;
+}
+
+bool RegionStore_write(RegionStore* store, int chunkX, int chunkY, const void* payload, uint32_t length) {
+    if (!store || store->readOnly || !payload || length == 0 || length > REGION_SLOT_PAYLOAD) return false;
+    FILE* file = open_region(store, chunkX >> REGION_SHIFT, chunkY >> REGION_SHIFT);
+    if (!file) return false;
+
+    // The current copy stays intact until the new one is complete
+    uint32_t entry = read_entry(file, chunkX, chunkY);
+    int slot = (entry & ~REGION_INDEX_SLOT) != 0 && !(entry & REGION_INDEX_SLOT);
+    if (fseek(file, slot_offset(chunkX, chunkY, slot), SEEK_SET) != 0) return false;
+    if (fwrite(payload, 1, length, file) != length) return false;
+    if (fflush(file) != 0) return false;
+
+    entry = length | (slot ? REGION_INDEX_SLOT : 0u);
+    if (fseek(file, index_offset(chunkX, chunkY), SEEK_SET) != 0) return false;
+    if (fwrite(&entry, sizeof(entry), 1, file) != 1) return false;
+    return fflush(file) == 0;
+}
+
+uint32_t RegionStore_read(RegionStore* store, int chunkX, int chunkY, void* buffer) {
+    if (!store || !buffer) return 0;
+    FILE* file = open_region(store, chunkX >> REGION_SHIFT, chunkY >> REGION_SHIFT);
+    if (!file) return 0;
+
+    uint32_t entry = read_entry(file, chunkX, chunkY);
+    uint32_t length = entry & ~REGION_INDEX_SLOT;
+    if (length == 0 || length > REGION_SLOT_PAYLOAD) return 0;
+    if (fseek(file, slot_offset(chunkX, chunkY, (entry & REGION_INDEX_SLOT) != 0), SEEK_SET) != 0) return 0;
+    if (fread(buffer, 1, length, file) != length) return 0;
+    return length;
+}
+
+bool RegionStore_write_tiles(RegionStore* store, int chunkX, int chunkY, const uint16_t* tiles) {
+    if (!tiles) return false;
+    uint8_t packed[CHUNK_CODEC_RAW_SIZE];
+    uint32_t size = ChunkCodec_encode(tiles, packed);
+    if (size > 0) return RegionStore_write(store, chunkX, chunkY, packed, size);
+    return RegionStore_write(store, chunkX, chunkY, tiles, REGION_SLOT_PAYLOAD);
+}
+
+bool RegionStore_read_tiles(RegionStore* store, int chunkX, int chunkY, uint16_t* tiles) {
+    if (!tiles) return false;
+    // Slots hold either the raw tile array or, when smaller, its encoding
+    uint8_t payload[REGION_SLOT_PAYLOAD];
+    uint32_t length = RegionStore_read(store, chunkX, chunkY, payload);
+    if (length == 0) return false;
+    if (length == REGION_SLOT_PAYLOAD) {
+        memcpy(tiles, payload, length);
+        return true;
+    }
+    return ChunkCodec_decode(payload, length, tiles);
+}
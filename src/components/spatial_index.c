@@ -0,0 +1,265 @@
+#include "components/spatial_index.h"
+
+#include <stdlib.h>
+
+#include "core/position.h"
+
+#define SPATIAL_CELL_INITIAL_CAPACITY 8
+
+static SpatialCell* cell_at(const SpatialIndex* index, int cellX, int cellY) {
+    return (SpatialCell*)ChunkMap_get(&index->cells, cellX, cellY);
+}
+
+// Frees an empty cell and drops it from the map and the occupied list
+static void cell_release(SpatialIndex* index, SpatialCell* cell) {
+    ChunkMap_remove(&index->cells, cell->cellX, cell->cellY);
+    SpatialCell* moved = index->occupied[--index->occupiedCount];
+    index->occupied[cell->occupiedSlot] = moved;
+    moved->occupiedSlot = cell->occupiedSlot;
+    free(cell->handles);
+    free(cell);
+}
+
+static SpatialCell* cell_create(SpatialIndex* index, int cellX, int cellY) {
+    if (index->occupiedCount == index->occupiedCapacity) {
+        int capacity = index->occupiedCapacity > 0 ? index->occupiedCapacity * 2 : 64;
+        SpatialCell** occupied = (SpatialCell**)realloc(index->occupied, sizeof(SpatialCell*) * capacity);
+        if (!occupied) return NULL;
+        index->occupied = occupied;
+        index->occupiedCapacity = capacity;
+    }
+    SpatialCell* cell = (SpatialCell*)calloc(1, sizeof(SpatialCell));
+    if (!cell) return NULL;
+    cell->cellX = cellX;
+    cell->cellY = cellY;
+    cell->occupiedSlot = index->occupiedCount;
+    index->occupied[index->occupiedCount++] = cell;
+    ChunkMap_put(&index->cells, cellX, cellY, cell);
+    return cell;
+}
+
+static bool cell_add(SpatialIndex* index, int cellX, int cellY, int handle) {
+    SpatialCell* cell = cell_at(index, cellX, cellY);
+    if (!cell) cell = cell_create(index, cellX, cellY);
+    if (!cell) return false;
+    if (cell->count == cell->capacity) {
+        int capacity = cell->capacity > 0 ? cell->capacity * 2 : SPATIAL_CELL_INITIAL_CAPACITY;
+        int* handles = (int*)realloc(cell->handles, sizeof(int) * capacity);
+        if (!handles) {
+            if (cell->count == 0) cell_release(index, cell);
+            return false;
+        }
+        cell->handles = handles;
+        cell->capacity = capacity;
+    }
+    index->items[handle].cellSlot = cell->count;
+    cell->handles[cell->count++] = handle;
+    return true;
+}
+
+// Swap-removes the handle; an emptied cell is released
+static void cell_remove(SpatialIndex* index, int cellX, int cellY, int handle) {
+    SpatialCell* cell = cell_at(index, cellX, cellY);
+    if (!cell) return;
+    int slot = index->items[handle].cellSlot;
+    int moved = cell->handles[--cell->count];
+    cell->handles[slot] = moved;
+    index->items[moved].cellSlot = slot;
+    index->items[handle].cellSlot = -1;
+
+    if (cell->count == 0) cell_release(index, cell);
+}
+
+static bool valid(const SpatialIndex* index, int handle) {
+    return handle >= 0 && handle < index->itemEnd && index->items[handle].cellSlot >= 0;
+}
+
+void SpatialIndex_init(SpatialIndex* index, int initialCapacity) {
+    if (!index) return;
+    ChunkMap_init(&index->cells, 64);
+    index->occupied = NULL;
+    index->occupiedCount = 0;
+    index->occupiedCapacity = 0;
+    index->itemCapacity = initialCapacity > 0 ? initialCapacity : 64;
+    index->items = (SpatialItem*)malloc(sizeof(SpatialItem) * index->itemCapacity);
+    if (!index->items) index->itemCapacity = 0;
+    index->itemCount = 0;
+    index->itemEnd = 0;
+    index->freeHead = -1;
+    index->revision = 0;
+}
+
+void SpatialIndex_free(SpatialIndex* index) {
+    if (!index) return;
+    for (int i = 0; i < index->occupiedCount; i++) {
+        free(index->occupied[i]->handles);
+        free(index->occupied[i]);
+    }
+    free(index->occupied);
+    index->occupied = NULL;
+    index->occupiedCount = index->occupiedCapacity = 0;
+    ChunkMap_free(&index->cells);
+    free(index->items);
+    index->items = NULL;
+    index->itemCount = 0;
+    index->itemEnd = 0;
+    index->itemCapacity = 0;
+    index->freeHead = -1;
+}
+
+int SpatialIndex_insert(SpatialIndex* index, EntityId entity, int x, int y) {
+    if (!index) return -1;
+
+    int handle = index->freeHead;
+    if (handle < 0) {
+        if (index->itemEnd == index->itemCapacity) {
+            int capacity = index->itemCapacity > 0 ? index->itemCapacity * 2 : 64;
+            SpatialItem* items = (SpatialItem*)realloc(index->items, sizeof(SpatialItem) * capacity);
+            if (!items) return -1;
+            index->items = items;
+            index->itemCapacity = capacity;
+        }
+        handle = index->itemEnd;
+    }
+
+    SpatialItem* item = &index->items[handle];
+    item->entity = entity;
+    item->x = x;
+    item->y = y;
+    int nextFree = handle == index->freeHead ? item->nextFree : -1;
+    if (!cell_add(index, SpatialIndex_cell(x), SpatialIndex_cell(y), handle)) {
+        item->cellSlot = -1;
+        return -1;
+    }
+
+    if (handle == index->freeHead) index->freeHead = nextFree;
+    else index->itemEnd++;
+    index->itemCount++;
+    index->revision++;
+    return handle;
+}
+
+void SpatialIndex_move(SpatialIndex* index, int handle, int x, int y) {
+    if (!index || !valid(index, handle)) return;
+    SpatialItem* item = &index->items[handle];
+    if (item->x == x && item->y == y) return;
+    int oldCellX = SpatialIndex_cell(item->x), oldCellY = SpatialIndex_cell(item->y);
+    int cellX = SpatialIndex_cell(x), cellY = SpatialIndex_cell(y);
+    if (cellX != oldCellX || cellY != oldCellY) {
+        cell_remove(index, oldCellX, oldCellY, handle);
+        if (!cell_add(index, cellX, cellY, handle)) {
+            // Out of memory: keep it where it was rather than lose it
+            cell_add(index, oldCellX, oldCellY, handle);
+            return;
+        }
+    }
+    item->x = x;
+    item->y = y;
+    index->revision++;
+}
+
+void SpatialIndex_remove(SpatialIndex* index, int handle) {
+    if (!index || !valid(index, handle)) return;
+    SpatialItem* item = &index->items[handle];
+    cell_remove(index, SpatialIndex_cell(item->x), SpatialIndex_cell(item->y), handle);
+    item->nextFree = index->freeHead;
+    index->freeHead = handle;
+    index->itemCount--;
+    index->revision++;
+}
+
+void SpatialIndex_set_position(SpatialIndex* index, int handle, ECS* ecs, ComponentTypeId positionTypeId, int x, int y) {
+    if (!index || !valid(index, handle)) return;
+    Position_set(ecs, index->items[handle].entity, positionTypeId, x, y);
+    SpatialIndex_move(index, handle, x, y);
+}
+
+// Cell rectangle of a query and where its matches go
+typedef struct SpatialQuery {
+    int cellX0, cellY0, cellX1, cellY1;
+    SpatialHit* hits;
+    int maxHits;
+    int found;
+} SpatialQuery;
+
+typedef void (*SpatialCellFn)(const SpatialIndex* index, const SpatialCell* cell, SpatialQuery* query, void* userData);
+
+// Calls fn for every occupied cell in the query's cell rectangle: through a
+// lookup per cell when the rectangle is small, else by scanning the occupied
+// cells, so a wide query over a sparse index does not probe empty cells
+static void for_each_cell(const SpatialIndex* index, SpatialQuery* query, SpatialCellFn fn, void* userData) {
+    long spanned = ((long)query->cellX1 - query->cellX0 + 1) * ((long)query->cellY1 - query->cellY0 + 1);
+    if (spanned > index->occupiedCount) {
+        for (int i = 0; i < index->occupiedCount; i++) {
+            const SpatialCell* cell = index->occupied[i];
+            if (cell->cellX < query->cellX0 || cell->cellX > query->cellX1 ||
+                cell->cellY < query->cellY0 || cell->cellY > query->cellY1) continue;
+            fn(index, cell, query, userData);
+        }
+        return;
+    }
+    for (int cy = query->cellY0; cy <= query->cellY1; cy++) {
+        for (int cx = query->cellX0; cx <= query->cellX1; cx++) {
+            const SpatialCell* cell = cell_at(index, cx, cy);
+            if (cell) fn(index, cell, query, userData);
+        }
+    }
+}
+
+static void add_hit(const SpatialIndex* index, SpatialQuery* query, int handle) {
+    const SpatialItem* item = &index->items[handle];
+    if (query->found < query->maxHits) query->hits[query->found] = (SpatialHit){ item->entity, handle, item->x, item->y };
+    query->found++;
+}
+
+typedef struct RectBounds {
+    int x, y, maxX, maxY;
+} RectBounds;
+
+static void rect_cell(const SpatialIndex* index, const SpatialCell* cell, SpatialQuery* query, void* userData) {
+    const RectBounds* rect = (const RectBounds*)userData;
+    // Interior cells lie wholly inside the rectangle; only edge cells need the test
+    bool edge = cell->cellX == query->cellX0 || cell->cellX == query->cellX1 ||
+                cell->cellY == query->cellY0 || cell->cellY == query->cellY1;
+    for (int i = 0; i < cell->count; i++) {
+        const SpatialItem* item = &index->items[cell->handles[i]];
+        if (edge && (item->x < rect->x || item->x > rect->maxX || item->y < rect->y || item->y > rect->maxY)) continue;
+        add_hit(index, query, cell->handles[i]);
+    }
+}
+
+int SpatialIndex_query_rect(const SpatialIndex* index, int x, int y, int width, int height,
+                            SpatialHit* hits, int maxHits) {
+    if (!index || width <= 0 || height <= 0) return 0;
+    RectBounds rect = { x, y, x + width - 1, y + height - 1 };
+    SpatialQuery query = { SpatialIndex_cell(x), SpatialIndex_cell(y),
+                           SpatialIndex_cell(rect.maxX), SpatialIndex_cell(rect.maxY), hits, maxHits, 0 };
+    for_each_cell(index, &query, rect_cell, &rect);
+    return query.found;
+}
+
+typedef struct RadiusBounds {
+    int centerX, centerY;
+    long radiusSq;
+} RadiusBounds;
+
+static void radius_cell(const SpatialIndex* index, const SpatialCell* cell, SpatialQuery* query, void* userData) {
+    const RadiusBounds* circle = (const RadiusBounds*)userData;
+    for (int i = 0; i < cell->count; i++) {
+        const SpatialItem* item = &index->items[cell->handles[i]];
+        long dx = item->x - circle->centerX;
+        long dy = item->y - circle->centerY;
+        if (dx * dx + dy * dy > circle->radiusSq) continue;
+        add_hit(index, query, cell->handles[i]);
+    }
+}
+
+int SpatialIndex_query_radius(const SpatialIndex* index, int centerX, int centerY, int radius,
+                              SpatialHit* hits, int maxHits) {
+    if (!index || radius < 0) return 0;
+    RadiusBounds circle = { centerX, centerY, (long)radius * radius };
+    SpatialQuery query = { SpatialIndex_cell(centerX - radius), SpatialIndex_cell(centerY - radius),
+                           SpatialIndex_cell(centerX + radius), SpatialIndex_cell(centerY + radius), hits, maxHits, 0 };
+    for_each_cell(index, &query, radius_cell, &circle);
+    return query.found;
+}
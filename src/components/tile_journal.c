@@ -0,0 +1,138 @@
+#include "components/tile_journal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static bool reserve(TileJournal* journal, size_t extra) {
+    if (journal->size + extra <= journal->capacity) return true;
+    size_t capacity = journal->capacity ? journal->capacity : 4096;
+    while (capacity < journal->size + extra) capacity *= 2;
+    uint8_t* data = (uint8_t*)realloc(journal->data, capacity);
+    if (!data) return false;
+    journal->data = data;
+    journal->capacity = capacity;
+    return true;
+}
+
+static void put_i32(TileJournal* journal, int32_t value) {
+    memcpy(journal->data + journal->size, &value, sizeof(value));
+    journal->size += sizeof(value);
+}
+
+// Reserves room for a record and writes its type and int32 fields
+static bool begin_record(TileJournal* journal, uint8_t type, const int32_t* fields, int count, size_t payload) {
+    if (!journal || !reserve(journal, 1 + sizeof(int32_t) * (size_t)count + payload)) return false;
+    journal->data[journal->size++] = type;
+    for (int i = 0; i < count; i++) put_i32(journal, fields[i]);
+    journal->records++;
+    return true;
+}
+
+void TileJournal_init(TileJournal* journal) {
+    if (!journal) return;
+    journal->data = NULL;
+    journal->size = 0;
+    journal->capacity = 0;
+    journal->records = 0;
+}
+
+void TileJournal_free(TileJournal* journal) {
+    if (!journal) return;
+    free(journal->data);
+    TileJournal_init(journal);
+}
+
+void TileJournal_clear(TileJournal* journal) {
+    if (!journal) return;
+    journal->size = 0;
+    journal->records = 0;
+}
+
+bool TileJournal_append(TileJournal* journal, const uint8_t* data, size_t size) {
+    if (!journal || (!data && size > 0)) return false;
+    if (size == 0) return true;
+    if (!reserve(journal, size)) return false;
+    memcpy(journal->data + journal->size, data, size);
+    journal->size += size;
+    return true;
+}
+
+bool TileJournal_set(TileJournal* journal, int x, int y, uint16_t tile_id) {
+    int32_t fields[] = { x, y, tile_id };
+    return begin_record(journal, TILE_JOURNAL_SET, fields, 3, 0);
+}
+
+bool TileJournal_fill(TileJournal* journal, int x, int y, int width, int height, uint16_t tile_id) {
+    if (width <= 0 || height <= 0) return true;
+    int32_t fields[] = { x, y, width, height, tile_id };
+    return begin_record(journal, TILE_JOURNAL_FILL, fields, 5, 0);
+}
+
+bool TileJournal_blit(TileJournal* journal, int x, int y, int width, int height, const uint16_t* src, int srcStride) {
+    if (width <= 0 || height <= 0) return true;
+    if (!src || srcStride < 0) return false;
+    // Rows are stored packed, so a stride-0 source is written out in full
+    size_t rowBytes = sizeof(uint16_t) * (size_t)width;
+    int32_t fields[] = { x, y, width, height };
+    if (!begin_record(journal, TILE_JOURNAL_BLIT, fields, 4, rowBytes * (size_t)height)) return false;
+    for (int row = 0; row < height; row++) {
+        memcpy(journal->data + journal->size, src + (long)row * srcStride, rowBytes);
+        journal->size += rowBytes;
+    }
+    return true;
+}
+
+bool TileJournal_copy(TileJournal* journal, World* world, int dstX, int dstY, int width, int height) {
+    if (width <= 0 || height <= 0) return true;
+    if (!world) return false;
+    uint16_t* tiles = (uint16_t*)malloc(sizeof(uint16_t) * (size_t)width * (size_t)height);
+    if (!tiles) return false;
+    World_read_rect(world, dstX, dstY, width, height, tiles);
+    bool recorded = TileJournal_blit(journal, dstX, dstY, width, height, tiles, width);
+    free(tiles);
+    return recorded;
+}
+
+long TileJournal_replay(World* world, const uint8_t* data, size_t size) {
+    if (!world || (!data && size > 0)) return -1;
+
+    static const int fieldCounts[] = { 0, 3, 5, 4, 6 };
+    long applied = 0;
+    size_t pos = 0;
+    while (pos < size) {
+        uint8_t type = data[pos++];
+        if (type < TILE_JOURNAL_SET || type > TILE_JOURNAL_COPY) return -1;
+        int32_t f[6];
+        size_t fieldBytes = sizeof(int32_t) * (size_t)fieldCounts[type];
+        if (size - pos < fieldBytes) return -1;
+        memcpy(f, data + pos, fieldBytes);
+        pos += fieldBytes;
+
+        switch (type) {
+            case TILE_JOURNAL_SET:
+                World_set_tile(world, f[0], f[1], (uint16_t)f[2]);
+                break;
+            case TILE_JOURNAL_FILL:
+                World_fill_rect(world, f[0], f[1], f[2], f[3], (uint16_t)f[4]);
+                break;
+            case TILE_JOURNAL_BLIT: {
+                if (f[2] <= 0 || f[3] <= 0) return -1;
+                size_t tileBytes = sizeof(uint16_t) * (size_t)f[2] * (size_t)f[3];
+                if (size - pos < tileBytes) return -1;
+                // Records are byte packed; copy the tiles out to an aligned buffer
+                uint16_t* tiles = (uint16_t*)malloc(tileBytes);
+                if (!tiles) return -1;
+                memcpy(tiles, data + pos, tileBytes);
+                pos += tileBytes;
+                World_blit(world, f[0], f[1], f[2], f[3], tiles, f[2]);
+                free(tiles);
+                break;
+            }
+            case TILE_JOURNAL_COPY:
+                World_copy_region(world, f[0], f[1], f[2], f[3], f[4], f[5]);
+                break;
+        }
+        applied++;
+    }
+    return applied;
+}
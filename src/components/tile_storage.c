@@ -0,0 +1,132 @@
+#include "components/tile_storage.h"
+
+#include <stdlib.h>
+
+bool TileStorage_init_table(TileStorage* storage, Arena_T arena, int width, int height) {
+    if (!storage || width <= 0 || height <= 0) return false;
+    storage->mode = TILE_STORAGE_TABLE;
+    storage->world = NULL;
+    storage->tilemap = Tilemap_new(width, height, arena);
+    storage->width = width;
+    storage->height = height;
+    return storage->tilemap != NULL;
+}
+
+bool TileStorage_init_chunked(TileStorage* storage, Arena_T arena) {
+    if (!storage) return false;
+    storage->mode = TILE_STORAGE_CHUNKED;
+    storage->tilemap = NULL;
+    storage->world = World_new(arena);
+    storage->width = storage->height = 0;
+    return storage->world != NULL;
+}
+
+void TileStorage_free(TileStorage* storage) {
+    if (!storage) return;
+    World_free(storage->world);
+    storage->world = NULL;
+    storage->tilemap = NULL;
+}
+
+static bool in_table(const TileStorage* storage, int x, int y) {
+    return x >= 0 && y >= 0 && x < storage->width && y < storage->height;
+}
+
+uint16_t TileStorage_get_tile(TileStorage* storage, int x, int y) {
+    if (!storage) return TILE_NONE;
+    if (storage->mode == TILE_STORAGE_CHUNKED) return World_get_tile(storage->world, x, y);
+    if (!in_table(storage, x, y)) return TILE_NONE;
+    Tile* tile = Tilemap_get_tile(storage->tilemap, x, y);
+    return tile ? tile->tile_id : TILE_NONE;
+}
+
+void TileStorage_set_tile(TileStorage* storage, int x, int y, uint16_t tile_id) {
+    if (!storage) return;
+    if (storage->mode == TILE_STORAGE_CHUNKED) {
+        World_set_tile(storage->world, x, y, tile_id);
+    } else if (in_table(storage, x, y)) {
+        Tilemap_set_tile(storage->tilemap, x, y, tile_id);
+    }
+}
+
+bool TileStorage_get_bounds(const TileStorage* storage, int* outX, int* outY, int* outWidth, int* outHeight) {
+    if (!storage) return false;
+    if (storage->mode == TILE_STORAGE_CHUNKED) return World_get_bounds(storage->world, outX, outY, outWidth, outHeight);
+    if (outX) *outX = 0;
+    if (outY) *outY = 0;
+    if (outWidth) *outWidth = storage->width;
+    if (outHeight) *outHeight = storage->height;
+    return true;
+}
+
+bool TileStorage_clip(const TileStorage* storage, int* x, int* y, int* width, int* height) {
+    if (!storage || *width <= 0 || *height <= 0) return false;
+    if (storage->mode == TILE_STORAGE_CHUNKED) return true;
+    int x0 = *x > 0 ? *x : 0;
+    int y0 = *y > 0 ? *y : 0;
+    int x1 = *x + *width < storage->width ? *x + *width : storage->width;
+    int y1 = *y + *height < storage->height ? *y + *height : storage->height;
+    if (x1 <= x0 || y1 <= y0) return false;
+    *x = x0;
+    *y = y0;
+    *width = x1 - x0;
+    *height = y1 - y0;
+    return true;
+}
+
+// Tilemap keeps its tiles row-major, so a clipped row is one run of Tiles
+static Tile* table_row(TileStorage* storage, int x, int y) {
+    return Tilemap_get_tile(storage->tilemap, x, y);
+}
+
+// CHUNK_SIZE blocks overlapping an already clipped rectangle
+static int blocks_touched(int x, int y, int width, int height) {
+    int columns = Chunk_coord(x + width - 1) - Chunk_coord(x) + 1;
+    int rows = Chunk_coord(y + height - 1) - Chunk_coord(y) + 1;
+    return columns * rows;
+}
+
+int TileStorage_fill_rect(TileStorage* storage, int x, int y, int width, int height, uint16_t tile_id) {
+    if (!storage) return 0;
+    if (storage->mode == TILE_STORAGE_CHUNKED) return World_fill_rect(storage->world, x, y, width, height, tile_id);
+    if (!TileStorage_clip(storage, &x, &y, &width, &height)) return 0;
+    for (int row = y; row < y + height; row++) {
+        Tile* tiles = table_row(storage, x, row);
+        if (!tiles) continue;
+        for (int col = 0; col < width; col++) tiles[col].tile_id = tile_id;
+    }
+    return blocks_touched(x, y, width, height);
+}
+
+int TileStorage_blit(TileStorage* storage, int x, int y, int width, int height, const uint16_t* src, int srcStride) {
+    if (!storage || !src || srcStride < 0) return 0;
+    if (storage->mode == TILE_STORAGE_CHUNKED) return World_blit(storage->world, x, y, width, height, src, srcStride);
+    int cx = x, cy = y;
+    if (!TileStorage_clip(storage, &cx, &cy, &width, &height)) return 0;
+    const uint16_t* srcRow = src + (long)(cy - y) * srcStride + (cx - x);
+    for (int row = 0; row < height; row++, srcRow += srcStride) {
+        Tile* tiles = table_row(storage, cx, cy + row);
+        if (!tiles) continue;
+        for (int col = 0; col < width; col++) tiles[col].tile_id = srcRow[col];
+    }
+    return blocks_touched(cx, cy, width, height);
+}
+
+int TileStorage_copy_region(TileStorage* storage, int srcX, int srcY, int width, int height, int dstX, int dstY) {
+    if (!storage || width <= 0 || height <= 0) return 0;
+    if (storage->mode == TILE_STORAGE_CHUNKED) {
+        return World_copy_region(storage->world, srcX, srcY, width, height, dstX, dstY);
+    }
+
+    // Staging the whole source keeps overlapping copies correct
+    uint16_t* staging = (uint16_t*)malloc(sizeof(uint16_t) * (size_t)width * (size_t)height);
+    if (!staging) return 0;
+    for (int row = 0; row < height; row++) {
+        for (int col = 0; col < width; col++) {
+            staging[(long)row * width + col] = TileStorage_get_tile(storage, srcX + col, srcY + row);
+        }
+    }
+    int touched = TileStorage_blit(storage, dstX, dstY, width, height, staging, width);
+    free(staging);
+    return touched;
+}
@@ -0,0 +1,41 @@
+#include "components/ui_hit_test.h"
+
+#include <string.h>
+
+void UIHitTest_clear(UIHitTest* hits) {
+    if (hits) hits->count = 0;
+}
+
+void UIHitTest_add(UIHitTest* hits, uint32_t id, Rectangle bounds, int16_t zIndex, bool captures) {
+    if (!hits || hits->count == UI_HIT_TEST_MAX_REGIONS) return;
+    // Insertion keeps the array in descending zIndex, so a lookup can stop at the first hit
+    int i = hits->count++;
+    while (i > 0 && hits->regions[i - 1].zIndex < zIndex) {
+        hits->regions[i] = hits->regions[i - 1];
+        i--;
+    }
+    hits->regions[i] = (UIHitRegion){ id, bounds, zIndex, captures };
+}
+
+void UIHitTest_remove(UIHitTest* hits, uint32_t id) {
+    if (!hits) return;
+    for (int i = 0; i < hits->count; i++) {
+        if (hits->regions[i].id != id) continue;
+        memmove(&hits->regions[i], &hits->regions[i + 1], sizeof(UIHitRegion) * (hits->count - i - 1));
+        hits->count--;
+        return;
+    }
+}
+
+const UIHitRegion* UIHitTest_find(const UIHitTest* hits, Vector2 point) {
+    if (!hits) return NULL;
+    for (int i = 0; i < hits->count; i++) {
+        const UIHitRegion* region = &hits->regions[i];
+        if (!region->captures) continue;
+        const Rectangle* b = &region->bounds;
+        if (point.x >= b->x && point.x < b->x + b->width && point.y >= b->y && point.y < b->y + b->height) {
+            return region;
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,619 @@
+#include "components/world.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define CHUNK_TILE_BYTES (sizeof(uint16_t) * CHUNK_AREA)
+
+static void list_unlink(ChunkList* list, Chunk* chunk) {
+    if (chunk->lruPrev) chunk->lruPrev->lruNext = chunk->lruNext;
+    else list->head = chunk->lruNext;
+    if (chunk->lruNext) chunk->lruNext->lruPrev = chunk->lruPrev;
+    else list->tail = chunk->lruPrev;
+    chunk->lruPrev = chunk->lruNext = NULL;
+}
+
+static void list_push_front(ChunkList* list, Chunk* chunk) {
+    chunk->lruPrev = NULL;
+    chunk->lruNext = list->head;
+    if (list->head) list->head->lruPrev = chunk;
+    list->head = chunk;
+    if (!list->tail) list->tail = chunk;
+}
+
+// Memory counters follow the chunk's current form; call untrack before and
+// track after any transition
+static void track(World* world, const Chunk* chunk, int sign) {
+    if (chunk->resident) {
+        world->stats.residentChunks += sign;
+        world->stats.residentBytes += sign * (long)CHUNK_TILE_BYTES;
+    } else if (chunk->packed) {
+        world->stats.compressedChunks += sign;
+        world->stats.compressedBytes += sign * (long)chunk->packedSize;
+    }
+}
+
+static void mark_used(World* world, Chunk* chunk) {
+    chunk->lastUsedFrame = world->frame;
+    world->lastChunk = chunk;
+    if (chunk->cold) {
+        list_unlink(&world->cold, chunk);
+        chunk->cold = false;
+        list_push_front(&world->hot, chunk);
+    } else if (world->hot.head != chunk) {
+        list_unlink(&world->hot, chunk);
+        list_push_front(&world->hot, chunk);
+    }
+}
+
+World* World_new(Arena_T arena) {
+    World* world = arena ? (World*)Arena_alloc(arena, sizeof(World), __FILE__, __LINE__)
+                         : (World*)malloc(sizeof(World));
+    if (!world) return NULL;
+    world->arena = arena;
+    ChunkMap_init(&world->chunks, 64);
+    ChunkMap_init(&world->empty, 64);
+    world->lastChunk = NULL;
+    world->paging = false;
+    world->residentBudget = 0;
+    world->compressAfter = 0;
+    world->frame = 0;
+    world->loader = NULL;
+    world->loaderData = NULL;
+    world->spare = NULL;
+    world->generator = NULL;
+    world->generatorData = NULL;
+    world->seed = 0;
+    world->hot = (ChunkList){ NULL, NULL };
+    world->cold = (ChunkList){ NULL, NULL };
+    memset(&world->stats, 0, sizeof(world->stats));
+    world->hasChunks = false;
+    world->minChunkX = world->minChunkY = 0;
+    world->maxChunkX = world->maxChunkY = -1;
+    return world;
+}
+
+void World_free(World* world) {
+    if (!world) return;
+    for (int i = 0; i < world->chunks.capacity; i++) {
+        Chunk* chunk = (Chunk*)world->chunks.entries[i].value;
+        if (!chunk) continue;
+        Chunk_free(chunk);
+        if (!world->arena) free(chunk);
+    }
+    ChunkMap_free(&world->chunks);
+    ChunkMap_free(&world->empty);
+    if (!world->arena) free(world->spare);
+    world->spare = NULL;
+    if (world->paging) RegionStore_close(&world->store);
+    world->paging = false;
+    world->lastChunk = NULL;
+    world->hot = (ChunkList){ NULL, NULL };
+    world->cold = (ChunkList){ NULL, NULL };
+    world->stats.residentChunks = world->stats.compressedChunks = 0;
+    world->stats.residentBytes = world->stats.compressedBytes = 0;
+    if (!world->arena) free(world);
+}
+
+bool World_enable_paging(World* world, const char* directory, size_t residentBudget) {
+    if (!world || world->paging) return false;
+    // Paged-out chunks only live for the session, so a stale file may be started over
+    if (!RegionStore_open_scratch(&world->store, directory)) return false;
+    world->paging = true;
+    world->residentBudget = residentBudget;
+    return true;
+}
+
+void World_enable_compression(World* world, uint32_t afterFrames) {
+    if (!world) return;
+    world->compressAfter = afterFrames;
+}
+
+// Moves chunks untouched for compressAfter frames to the cold list, compressed where they shrink.
+// Recently used chunks are stepped over, not taken as the end of the aged ones.
+static void age_out(World* world) {
+    Chunk* chunk = world->hot.tail;
+    while (chunk) {
+        Chunk* prev = chunk->lruPrev;
+        if (world->frame - chunk->lastUsedFrame < world->compressAfter) {
+            chunk = prev;
+            continue;
+        }
+        list_unlink(&world->hot, chunk);
+        track(world, chunk, -1);
+        if (Chunk_compress(chunk)) world->stats.compressions++;
+        track(world, chunk, 1);
+        chunk->cold = true;
+        list_push_front(&world->cold, chunk);
+        if (world->lastChunk == chunk) world->lastChunk = NULL;
+        chunk = prev;
+    }
+}
+
+static bool over_budget(const World* world) {
+    return (size_t)(world->stats.residentBytes + world->stats.compressedBytes) > world->residentBudget;
+}
+
+int World_evict_cold(World* world) {
+    if (!world) return 0;
+    if (world->compressAfter > 0) age_out(world);
+
+    // Least recently used first, cold list before hot. Chunks in this frame's
+    // working set are stepped over rather than ending the walk, and so are
+    // slots being read elsewhere (an async load, a frozen snapshot).
+    int evicted = 0;
+    ChunkList* lists[2] = { &world->cold, &world->hot };
+    for (int i = 0; i < 2 && world->paging && over_budget(world); i++) {
+        Chunk* victim = lists[i]->tail;
+        while (victim && over_budget(world)) {
+            Chunk* prev = victim->lruPrev;
+            // A pinned chunk would overwrite the slot a snapshot still reads
+            bool rewritesPinned = victim->pinned && victim->revision != victim->storedRevision;
+            if (victim->lastUsedFrame == world->frame || victim->loading || rewritesPinned) {
+                victim = prev;
+                continue;
+            }
+
+            // The generator can rebuild an unedited chunk, so it never needs a region slot
+            bool pristine = victim->generated && victim->revision == victim->generatedRevision && !victim->shared;
+            track(world, victim, -1);
+            if (pristine) {
+                Chunk_free(victim);
+                world->stats.dropped++;
+            } else if (!Chunk_unload(victim, &world->store)) {
+                track(world, victim, 1);
+                world->stats.failures++;
+                world->frame++;
+                return evicted;
+            } else {
+                world->stats.pageOuts++;
+            }
+            list_unlink(lists[i], victim);
+            victim->cold = false;
+            if (world->lastChunk == victim) world->lastChunk = NULL;
+            evicted++;
+            victim = prev;
+        }
+    }
+    world->frame++;
+    return evicted;
+}
+
+static void extend_bounds(World* world, int chunkX, int chunkY) {
+    if (!world->hasChunks) {
+        world->minChunkX = world->maxChunkX = chunkX;
+        world->minChunkY = world->maxChunkY = chunkY;
+        world->hasChunks = true;
+    } else {
+        if (chunkX < world->minChunkX) world->minChunkX = chunkX;
+        if (chunkX > world->maxChunkX) world->maxChunkX = chunkX;
+        if (chunkY < world->minChunkY) world->minChunkY = chunkY;
+        if (chunkY > world->maxChunkY) world->maxChunkY = chunkY;
+    }
+}
+
+// Runs the generator into a TILE_NONE-filled array
+static bool run_generator(const World* world, int chunkX, int chunkY, uint16_t* tiles) {
+    for (int i = 0; i < CHUNK_AREA; i++) tiles[i] = TILE_NONE;
+    uint32_t seed = World_chunk_seed(world->seed, chunkX, chunkY);
+    return world->generator(world->generatorData, chunkX, chunkY, seed, tiles);
+}
+
+bool World_generate_tiles(const World* world, int chunkX, int chunkY, uint16_t* tiles) {
+    if (!world || !world->generator || !tiles) return false;
+    return run_generator(world, chunkX, chunkY, tiles);
+}
+
+// Evicted without a write: not compressed, and the region store has no copy
+static bool dropped(const Chunk* chunk) {
+    return !chunk->resident && !chunk->packed && !chunk->stored && chunk->generated;
+}
+
+// Rebuilds a dropped chunk's tiles; it was never edited, so this is the same tiles
+static bool regenerate(World* world, Chunk* chunk) {
+    if (!world->generator) return false;
+    uint16_t* tiles = (uint16_t*)malloc(CHUNK_TILE_BYTES);
+    if (!tiles) return false;
+    run_generator(world, chunk->chunkX, chunk->chunkY, tiles);
+    chunk->tiles = tiles;
+    chunk->resident = true;
+    return true;
+}
+
+// Restores a compressed, paged-out or dropped chunk's tile array on the calling thread
+static bool restore(World* world, Chunk* chunk) {
+    // Compressed chunks are still on a list, the others rejoin at the front
+    bool compressed = chunk->packed != NULL;
+    bool rebuild = dropped(chunk);
+    track(world, chunk, -1);
+    bool loaded = rebuild ? regenerate(world, chunk) : Chunk_load(chunk, &world->store);
+    track(world, chunk, 1);
+    if (!loaded) {
+        world->stats.failures++;
+        return false;
+    }
+    if (compressed) {
+        world->stats.decompressions++;
+    } else {
+        if (rebuild) world->stats.generated++;
+        else world->stats.pageIns++;
+        list_push_front(&world->hot, chunk);
+    }
+    // Needed before the loader finished its first generation; it now exists even if the generator left it empty
+    if (chunk->generating) {
+        chunk->generating = false;
+        extend_bounds(world, chunk->chunkX, chunk->chunkY);
+    }
+    return true;
+}
+
+static Chunk* lookup(World* world, int chunkX, int chunkY, bool wait) {
+    if (!world) return NULL;
+    Chunk* chunk = world->lastChunk;
+    if (chunk && chunk->chunkX == chunkX && chunk->chunkY == chunkY) {
+        mark_used(world, chunk);
+        return chunk;
+    }
+    chunk = (Chunk*)ChunkMap_get(&world->chunks, chunkX, chunkY);
+    if (!chunk) return NULL;
+
+    if (!chunk->resident) {
+        // On its way back from the loader, read or generated
+        if (!wait && chunk->loading) return NULL;
+        if (!wait && !chunk->packed && !dropped(chunk)) {
+            // Paged out: leave it to the loader if there is one
+            if (world->loader && world->loader(world->loaderData, chunk)) {
+                chunk->loading = true;
+                return NULL;
+            }
+        }
+        if (!restore(world, chunk)) return NULL;
+    }
+    mark_used(world, chunk);
+    return chunk;
+}
+
+Chunk* World_get_chunk(World* world, int chunkX, int chunkY) {
+    return lookup(world, chunkX, chunkY, true);
+}
+
+Chunk* World_peek_chunk(World* world, int chunkX, int chunkY) {
+    return lookup(world, chunkX, chunkY, false);
+}
+
+Chunk* World_find_chunk(const World* world, int chunkX, int chunkY) {
+    return world ? (Chunk*)ChunkMap_get(&world->chunks, chunkX, chunkY) : NULL;
+}
+
+void World_set_loader(World* world, WorldLoadFn loader, void* userData) {
+    if (!world) return;
+    world->loader = loader;
+    world->loaderData = userData;
+}
+
+bool World_load_async(World* world, Chunk* chunk) {
+    if (!world || !chunk || !world->loader) return false;
+    if (chunk->resident || chunk->packed || chunk->loading) return false;
+    if (!chunk->stored && !dropped(chunk)) return false;
+    if (!world->loader(world->loaderData, chunk)) return false;
+    chunk->loading = true;
+    return true;
+}
+
+void World_finish_load(World* world, Chunk* chunk, uint16_t* tiles) {
+    if (!world || !chunk) return;
+    chunk->loading = false;
+    if (!tiles && chunk->generating) {
+        // The generator left it empty: forget the placeholder and remember the answer
+        ChunkMap_remove(&world->chunks, chunk->chunkX, chunk->chunkY);
+        ChunkMap_put(&world->empty, chunk->chunkX, chunk->chunkY, world);
+        if (!world->arena) free(chunk);
+        return;
+    }
+    if (!tiles) {
+        world->stats.failures++;
+        return;
+    }
+    // Someone needed it first and loaded it synchronously
+    if (chunk->resident || chunk->packed) {
+        free(tiles);
+        return;
+    }
+    bool rebuilt = dropped(chunk);
+    chunk->tiles = tiles;
+    chunk->resident = true;
+    chunk->lastUsedFrame = world->frame;
+    track(world, chunk, 1);
+    list_push_front(&world->hot, chunk);
+    if (rebuilt) world->stats.generated++;
+    else world->stats.pageIns++;
+    if (chunk->generating) {
+        chunk->generating = false;
+        extend_bounds(world, chunk->chunkX, chunk->chunkY);
+    }
+}
+
+// Adds a new resident chunk filled with fill; the caller checked it does not exist
+static Chunk* insert(World* world, int chunkX, int chunkY, uint16_t fill) {
+    Chunk* chunk = Chunk_new(world->arena, chunkX, chunkY, fill);
+    if (!chunk) return NULL;
+    if (!chunk->resident) {
+        if (!world->arena) free(chunk);
+        return NULL;
+    }
+    ChunkMap_put(&world->chunks, chunkX, chunkY, chunk);
+    track(world, chunk, 1);
+    list_push_front(&world->hot, chunk);
+    chunk->lastUsedFrame = world->frame;
+    world->lastChunk = chunk;
+    extend_bounds(world, chunkX, chunkY);
+    return chunk;
+}
+
+// Runs the generator for a chunk that does not exist yet; NULL if it leaves the chunk empty.
+// An empty answer is remembered, so requesting the same chunk every frame costs a lookup.
+static Chunk* generate(World* world, int chunkX, int chunkY) {
+    if (!world->generator || ChunkMap_get(&world->empty, chunkX, chunkY)) return NULL;
+    uint16_t tiles[CHUNK_AREA];
+    if (!run_generator(world, chunkX, chunkY, tiles)) {
+        ChunkMap_put(&world->empty, chunkX, chunkY, world);
+        return NULL;
+    }
+
+    Chunk* chunk = insert(world, chunkX, chunkY, TILE_NONE);
+    if (!chunk) return NULL;
+    memcpy(chunk->tiles, tiles, sizeof(tiles));
+    chunk->generated = true;
+    chunk->generatedRevision = chunk->revision;
+    world->stats.generated++;
+    return chunk;
+}
+
+// Hands a chunk that does not exist yet to the loader for its first generation;
+// generates it here if the loader is full. Until the loader is done it waits in
+// the map as a dropped chunk without tiles, so lookups that cannot wait
+// regenerate it themselves.
+static Chunk* generate_async(World* world, int chunkX, int chunkY) {
+    if (!world->generator || ChunkMap_get(&world->empty, chunkX, chunkY)) return NULL;
+    Chunk* chunk = world->spare;
+    world->spare = NULL;
+    if (!chunk) {
+        chunk = Chunk_new(world->arena, chunkX, chunkY, TILE_NONE);
+        if (!chunk) return NULL;
+        Chunk_free(chunk);
+        chunk->generated = true;
+        chunk->generating = true;
+        chunk->generatedRevision = chunk->revision;
+    }
+    chunk->chunkX = chunkX;
+    chunk->chunkY = chunkY;
+    if (!world->loader(world->loaderData, chunk)) {
+        world->spare = chunk;
+        return generate(world, chunkX, chunkY);
+    }
+    chunk->loading = true;
+    ChunkMap_put(&world->chunks, chunkX, chunkY, chunk);
+    return NULL;
+}
+
+Chunk* World_request_chunk(World* world, int chunkX, int chunkY) {
+    Chunk* chunk = World_peek_chunk(world, chunkX, chunkY);
+    if (chunk || !world) return chunk;
+    // Exists but is on its way back from the region store or the generator
+    if (ChunkMap_get(&world->chunks, chunkX, chunkY)) return NULL;
+    if (world->loader) return generate_async(world, chunkX, chunkY);
+    return generate(world, chunkX, chunkY);
+}
+
+Chunk* World_touch_chunk(World* world, int chunkX, int chunkY) {
+    Chunk* chunk = World_get_chunk(world, chunkX, chunkY);
+    if (chunk || !world) return chunk;
+
+    // Never touched, or paged out and failed to come back
+    if (ChunkMap_get(&world->chunks, chunkX, chunkY)) return NULL;
+
+    // Edits land on generated terrain, not on an empty chunk the generator would have filled
+    chunk = generate(world, chunkX, chunkY);
+    return chunk ? chunk : insert(world, chunkX, chunkY, TILE_NONE);
+}
+
+void World_set_generator(World* world, WorldGenerateFn generator, void* userData, uint32_t seed) {
+    if (!world) return;
+    world->generator = generator;
+    world->generatorData = userData;
+    world->seed = seed;
+    ChunkMap_free(&world->empty);
+    ChunkMap_init(&world->empty, 64);
+}
+
+void World_set_tile(World* world, int x, int y, uint16_t tile_id) {
+    Chunk* chunk = World_touch_chunk(world, Chunk_coord(x), Chunk_coord(y));
+    if (chunk) Chunk_set_tile(chunk, Chunk_local(x), Chunk_local(y), tile_id);
+}
+
+bool World_get_bounds(const World* world, int* outX, int* outY, int* outWidth, int* outHeight) {
+    if (!world || !world->hasChunks) return false;
+    if (outX) *outX = world->minChunkX * CHUNK_SIZE;
+    if (outY) *outY = world->minChunkY * CHUNK_SIZE;
+    if (outWidth) *outWidth = (world->maxChunkX - world->minChunkX + 1) * CHUNK_SIZE;
+    if (outHeight) *outHeight = (world->maxChunkY - world->minChunkY + 1) * CHUNK_SIZE;
+    return true;
+}
+
+// Part of a region that falls inside one chunk, in local chunk coordinates
+typedef struct ChunkSpan {
+    int chunkX, chunkY;
+    int localX, localY;
+    int width, height;
+    int offsetX, offsetY;  // position of (localX, localY) relative to the region origin
+} ChunkSpan;
+
+typedef void (*ChunkSpanFn)(Chunk* chunk, const ChunkSpan* span, void* userData);
+
+// Existing chunk, else a freshly generated one; never creates an empty chunk.
+// Reads go through this so a region reads the same before and after it is visited.
+static Chunk* find(World* world, int chunkX, int chunkY) {
+    Chunk* chunk = World_get_chunk(world, chunkX, chunkY);
+    if (chunk || ChunkMap_get(&world->chunks, chunkX, chunkY)) return chunk;
+    return generate(world, chunkX, chunkY);
+}
+
+// Visits every chunk overlapping the region once, chunk by chunk
+static int for_each_chunk_span(World* world, int x, int y, int width, int height, bool create,
+                               ChunkSpanFn fn, void* userData) {
+    if (!world || width <= 0 || height <= 0) return 0;
+    int cx0 = Chunk_coord(x), cx1 = Chunk_coord(x + width - 1);
+    int cy0 = Chunk_coord(y), cy1 = Chunk_coord(y + height - 1);
+
+    int visited = 0;
+    for (int cy = cy0; cy <= cy1; cy++) {
+        int top = cy * CHUNK_SIZE;
+        int y0 = y > top ? y : top;
+        int y1 = y + height < top + CHUNK_SIZE ? y + height : top + CHUNK_SIZE;
+        for (int cx = cx0; cx <= cx1; cx++) {
+            int left = cx * CHUNK_SIZE;
+            int x0 = x > left ? x : left;
+            int x1 = x + width < left + CHUNK_SIZE ? x + width : left + CHUNK_SIZE;
+
+            Chunk* chunk = create ? World_touch_chunk(world, cx, cy) : find(world, cx, cy);
+            if (create && !chunk) continue;
+            ChunkSpan span = { cx, cy, x0 - left, y0 - top, x1 - x0, y1 - y0, x0 - x, y0 - y };
+            fn(chunk, &span, userData);
+            visited++;
+        }
+    }
+    return visited;
+}
+
+static void fill_span(Chunk* chunk, const ChunkSpan* span, void* userData) {
+    if (!Chunk_unshare(chunk)) return;
+    const uint16_t* run = (const uint16_t*)userData;
+    for (int row = 0; row < span->height; row++) {
+        memcpy(&chunk->tiles[Chunk_index(span->localX, span->localY + row)], run, sizeof(uint16_t) * span->width);
+    }
+    chunk->revision++;
+    Chunk_mark_dirty_rect(chunk, span->localX, span->localY, span->width, span->height);
+}
+
+int World_fill_rect(World* world, int x, int y, int width, int height, uint16_t tile_id) {
+    // One chunk-wide run of the tile; every row span is a memcpy out of it
+    uint16_t run[CHUNK_SIZE];
+    for (int i = 0; i < CHUNK_SIZE; i++) run[i] = tile_id;
+    return for_each_chunk_span(world, x, y, width, height, true, fill_span, run);
+}
+
+typedef struct BlitSource {
+    const uint16_t* src;
+    int stride;
+} BlitSource;
+
+static void blit_span(Chunk* chunk, const ChunkSpan* span, void* userData) {
+    if (!Chunk_unshare(chunk)) return;
+    const BlitSource* source = (const BlitSource*)userData;
+    const uint16_t* srcRow = source->src + (long)span->offsetY * source->stride + span->offsetX;
+    for (int row = 0; row < span->height; row++, srcRow += source->stride) {
+        memcpy(&chunk->tiles[Chunk_index(span->localX, span->localY + row)], srcRow, sizeof(uint16_t) * span->width);
+    }
+    chunk->revision++;
+    Chunk_mark_dirty_rect(chunk, span->localX, span->localY, span->width, span->height);
+}
+
+int World_blit(World* world, int x, int y, int width, int height, const uint16_t* src, int srcStride) {
+    if (!src || srcStride < 0) return 0;
+    BlitSource source = { src, srcStride };
+    return for_each_chunk_span(world, x, y, width, height, true, blit_span, &source);
+}
+
+typedef struct ReadTarget {
+    uint16_t* dst;
+    int stride;
+} ReadTarget;
+
+static void read_span(Chunk* chunk, const ChunkSpan* span, void* userData) {
+    const ReadTarget* target = (const ReadTarget*)userData;
+    uint16_t* dstRow = target->dst + (long)span->offsetY * target->stride + span->offsetX;
+    for (int row = 0; row < span->height; row++, dstRow += target->stride) {
+        if (chunk) {
+            memcpy(dstRow, &chunk->tiles[Chunk_index(span->localX, span->localY + row)], sizeof(uint16_t) * span->width);
+        } else {
+            for (int i = 0; i < span->width; i++) dstRow[i] = TILE_NONE;
+        }
+    }
+}
+
+void World_read_rect(World* world, int x, int y, int width, int height, uint16_t* dst) {
+    if (!dst) return;
+    ReadTarget target = { dst, width };
+    for_each_chunk_span(world, x, y, width, height, false, read_span, &target);
+}
+
+int World_copy_region(World* world, int srcX, int srcY, int width, int height, int dstX, int dstY) {
+    if (!world || width <= 0 || height <= 0) return 0;
+
+    // Staging the whole source keeps overlapping copies correct
+    uint16_t* staging = (uint16_t*)malloc(sizeof(uint16_t) * (size_t)width * (size_t)height);
+    if (!staging) return 0;
+    World_read_rect(world, srcX, srcY, width, height, staging);
+    int touched = World_blit(world, dstX, dstY, width, height, staging, width);
+    free(staging);
+    return touched;
+}
+
+void World_snapshot_free(WorldSnapshot* snapshot) {
+    if (!snapshot) return;
+    free(snapshot->chunks);
+    snapshot->chunks = NULL;
+    snapshot->count = snapshot->capacity = 0;
+}
+
+int World_freeze(World* world, WorldSnapshot* snapshot) {
+    if (!world || !snapshot) return 0;
+    snapshot->count = 0;
+    for (int i = 0; i < world->chunks.capacity; i++) {
+        Chunk* chunk = (Chunk*)world->chunks.entries[i].value;
+        if (!chunk || chunk->revision == chunk->savedRevision) continue;
+
+        if (snapshot->count == snapshot->capacity) {
+            int capacity = snapshot->capacity ? snapshot->capacity * 2 : 64;
+            WorldFrozenChunk* chunks = (WorldFrozenChunk*)realloc(snapshot->chunks, sizeof(WorldFrozenChunk) * capacity);
+            if (!chunks) break;  // the rest stay changed and go in the next snapshot
+            snapshot->chunks = chunks;
+            snapshot->capacity = capacity;
+        }
+
+        // Share whatever the chunk holds right now; the first write after this clones it
+        WorldFrozenChunk* frozen = &snapshot->chunks[snapshot->count++];
+        frozen->chunk = chunk;
+        frozen->chunkX = chunk->chunkX;
+        frozen->chunkY = chunk->chunkY;
+        frozen->tiles = chunk->tiles;
+        frozen->packed = chunk->packed;
+        frozen->packedSize = chunk->packedSize;
+        if (chunk->tiles || chunk->packed) {
+            chunk->shared = true;
+        } else {
+            chunk->pinned = true;  // paged out, read back from the region store
+        }
+        chunk->savedRevision = chunk->revision;
+    }
+    return snapshot->count;
+}
+
+void World_release_snapshot(World* world, WorldSnapshot* snapshot) {
+    if (!world || !snapshot) return;
+    for (int i = 0; i < snapshot->count; i++) {
+        WorldFrozenChunk* frozen = &snapshot->chunks[i];
+        Chunk* chunk = frozen->chunk;
+        chunk->pinned = false;
+        const void* buffer = frozen->tiles ? (const void*)frozen->tiles : (const void*)frozen->packed;
+        if (!buffer) continue;
+        // Still the chunk's own buffer: it simply stops being shared. Otherwise
+        // the chunk moved on (cloned, compressed, evicted) and left it to us.
+        if (chunk->shared && (buffer == chunk->tiles || buffer == chunk->packed)) {
+            chunk->shared = false;
+        } else {
+            free((void*)buffer);
+        }
+    }
+    snapshot->count = 0;
+}
@@ -0,0 +1,124 @@
+#include "input/input_scripted.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct ScriptedBackend {
+    InputScriptEvent* events;
+    int eventCount;
+    uint32_t period;
+    uint32_t frame;
+
+    // Events of the current frame are events[first, last)
+    int first;
+    int last;
+    RenderVector2 mousePos;
+} ScriptedBackend;
+
+static ScriptedBackend* backend_of(const InputProvider* provider) {
+    return provider ? (ScriptedBackend*)provider->backendData : NULL;
+}
+
+static uint32_t script_frame(const ScriptedBackend* b) {
+    return b->period > 0 ? b->frame % b->period : b->frame;
+}
+
+static void select_frame(ScriptedBackend* b) {
+    uint32_t frame = script_frame(b);
+    if (frame == 0) b->last = 0;  // start or wrap around
+    b->first = b->last;
+    while (b->first < b->eventCount && b->events[b->first].frame < frame) b->first++;
+    b->last = b->first;
+    while (b->last < b->eventCount && b->events[b->last].frame == frame) {
+        if (b->events[b->last].moveMouse) b->mousePos = b->events[b->last].mousePos;
+        b->last++;
+    }
+}
+
+static bool scripted_is_key_pressed(InputProvider* provider, int key) {
+    ScriptedBackend* b = backend_of(provider);
+    if (!b) return false;
+    for (int i = b->first; i < b->last; i++) {
+        if (b->events[i].key == key) return true;
+    }
+    return false;
+}
+
+static bool scripted_is_mouse_button_pressed(InputProvider* provider, int button) {
+    ScriptedBackend* b = backend_of(provider);
+    if (!b) return false;
+    for (int i = b->first; i < b->last; i++) {
+        if (b->events[i].mouseButton == button) return true;
+    }
+    return false;
+}
+
+static RenderVector2 scripted_get_mouse_position(InputProvider* provider) {
+    ScriptedBackend* b = backend_of(provider);
+    if (!b) return (RenderVector2){ 0.0f, 0.0f };
+    return b->mousePos;
+}
+
+static float scripted_get_mouse_wheel_move(InputProvider* provider) {
+    ScriptedBackend* b = backend_of(provider);
+    if (!b) return 0.0f;
+    float wheel = 0.0f;
+    for (int i = b->first; i < b->last; i++) {
+        wheel += b->events[i].wheel;
+    }
+    return wheel;
+}
+
+// Presses last exactly one frame, so held and pressed agree
+static const InputProviderVTable scriptedVTable = {
+    .is_key_pressed = scripted_is_key_pressed,
+    .is_key_down = scripted_is_key_pressed,
+    .is_mouse_button_pressed = scripted_is_mouse_button_pressed,
+    .is_mouse_button_down = scripted_is_mouse_button_pressed,
+    .get_mouse_position = scripted_get_mouse_position,
+    .get_mouse_wheel_move = scripted_get_mouse_wheel_move,
+};
+
+InputProvider* InputProviderScripted_create(const InputScriptEvent* events, int eventCount, uint32_t period) {
+    InputProvider* provider = (InputProvider*)malloc(sizeof(InputProvider));
+    ScriptedBackend* b = (ScriptedBackend*)calloc(1, sizeof(ScriptedBackend));
+    if (eventCount < 0) eventCount = 0;
+    InputScriptEvent* copy = eventCount > 0 ? (InputScriptEvent*)malloc(sizeof(InputScriptEvent) * eventCount) : NULL;
+    if (!provider || !b || (eventCount > 0 && !copy)) {
+        free(provider);
+        free(b);
+        free(copy);
+        return NULL;
+    }
+    if (eventCount > 0) memcpy(copy, events, sizeof(InputScriptEvent) * eventCount);
+    b->events = copy;
+    b->eventCount = eventCount;
+    b->period = period;
+    select_frame(b);
+
+    provider->vtable = &scriptedVTable;
+    provider->backendData = b;
+    return provider;
+}
+
+void InputProviderScripted_destroy(InputProvider* provider) {
+    if (!provider) return;
+    ScriptedBackend* b = backend_of(provider);
+    if (b) {
+        free(b->events);
+        free(b);
+    }
+    free(provider);
+}
+
+void InputProviderScripted_advance(InputProvider* provider) {
+    ScriptedBackend* b = backend_of(provider);
+    if (!b) return;
+    b->frame++;
+    select_frame(b);
+}
+
+uint32_t InputProviderScripted_frame(const InputProvider* provider) {
+    ScriptedBackend* b = backend_of(provider);
+    return b ? b->frame : 0;
+}
@@ -14,6 +14,13 @@
 
 #define TILE_SIZE 16
 #define MAP_SIZE 128
+// Tile backend, see GameSystem_create
+#define MAP_STORAGE_MODE TILE_STORAGE_CHUNKED
+// Window pixels per logical pixel. This is the switch for the logical
+// render target: above 1 the world is drawn at the smaller logical size and
+// upscaled in one point-filtered blit (GameState.logicalTarget). At 1 the
+// target stays off, even once the window is resized or maximised.
+#define LOGICAL_SCALE 1.0f
 
 const float ScreenWidth = 1600.0f;
 const float ScreenHeight = 900.0f;
@@ -71,7 +78,8 @@ int main(void) {
     }
 
     RenderVector2 windowSize = Renderer_get_window_size(renderer);
-    GameSystem* game = GameSystem_create(arena, MAP_SIZE, TILE_SIZE, (Vector2){ windowSize.x, windowSize.y }, renderer, inputProvider, uiProvider);
+    Vector2 logicalSize = { windowSize.x / LOGICAL_SCALE, windowSize.y / LOGICAL_SCALE };
+    GameSystem* game = GameSystem_create(arena, MAP_SIZE, TILE_SIZE, MAP_STORAGE_MODE, logicalSize, renderer, inputProvider, uiProvider);
 
     while (!Renderer_should_close(renderer)) {
         float dt = Renderer_get_delta_time(renderer);
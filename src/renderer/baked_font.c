@@ -0,0 +1,116 @@
+#include "renderer/baked_font.h"
+
+#include <string.h>
+
+#if !defined(_WIN32) && !defined(PLATFORM_WEB)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BAKED_FONT_MMAP 1
+#endif
+
+typedef struct MappedFile {
+    const unsigned char* data;
+    size_t size;
+} MappedFile;
+
+// Windows and web builds read the file instead of mapping it
+static bool map_file(const char* path, MappedFile* file) {
+#ifdef BAKED_FONT_MMAP
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return false;
+    file->data = (const unsigned char*)data;
+    file->size = (size_t)st.st_size;
+    return true;
+#else
+    int size = 0;
+    file->data = LoadFileData(path, &size);
+    file->size = size > 0 ? (size_t)size : 0;
+    return file->data != NULL;
+#endif
+}
+
+static void unmap_file(MappedFile* file) {
+#ifdef BAKED_FONT_MMAP
+    munmap((void*)file->data, file->size);
+#else
+    UnloadFileData((unsigned char*)file->data);
+#endif
+    file->data = NULL;
+    file->size = 0;
+}
+
+static bool valid_header(const BakedFontHeader* h, size_t fileSize) {
+    if (memcmp(h->magic, BAKED_FONT_MAGIC, 4) != 0 || h->version != BAKED_FONT_VERSION) return false;
+    if (h->baseSize <= 0 || h->glyphCount <= 0 || h->atlasWidth <= 0 || h->atlasHeight <= 0) return false;
+    size_t glyphEnd = (size_t)h->glyphOffset + sizeof(BakedGlyph) * (size_t)h->glyphCount;
+    size_t pixelEnd = (size_t)h->pixelOffset + (size_t)h->pixelBytes;
+    size_t expectedPixels = (size_t)GetPixelDataSize(h->atlasWidth, h->atlasHeight, h->format);
+    return h->glyphOffset >= sizeof(BakedFontHeader) && glyphEnd <= h->pixelOffset &&
+           pixelEnd <= fileSize && h->pixelBytes == expectedPixels;
+}
+
+bool BakedFont_load(const char* path, Font* font, uint32_t* flags) {
+    if (!font) return false;
+    memset(font, 0, sizeof(Font));
+    MappedFile file;
+    if (!path || !map_file(path, &file)) return false;
+
+    const BakedFontHeader* h = (const BakedFontHeader*)file.data;
+    if (file.size < sizeof(BakedFontHeader) || !valid_header(h, file.size)) {
+        TraceLog(LOG_WARNING, "BakedFont: %s is not a version %u font atlas", path, BAKED_FONT_VERSION);
+        unmap_file(&file);
+        return false;
+    }
+
+    // The pixels go to the GPU straight from the mapping
+    Image atlas = {
+        .data = (void*)(file.data + h->pixelOffset),
+        .width = h->atlasWidth,
+        .height = h->atlasHeight,
+        .mipmaps = 1,
+        .format = h->format
+    };
+    Texture2D texture = LoadTextureFromImage(atlas);
+    // raylib's allocator, which UnloadFont frees with
+    GlyphInfo* glyphs = (GlyphInfo*)MemAlloc((unsigned int)(sizeof(GlyphInfo) * (size_t)h->glyphCount));
+    Rectangle* recs = (Rectangle*)MemAlloc((unsigned int)(sizeof(Rectangle) * (size_t)h->glyphCount));
+    if (texture.id == 0 || !glyphs || !recs) {
+        if (texture.id != 0) UnloadTexture(texture);
+        MemFree(glyphs);
+        MemFree(recs);
+        unmap_file(&file);
+        return false;
+    }
+
+    // Distance fields are meant to be sampled between texels
+    if (h->flags & BAKED_FONT_SDF) SetTextureFilter(texture, TEXTURE_FILTER_BILINEAR);
+
+    const BakedGlyph* baked = (const BakedGlyph*)(file.data + h->glyphOffset);
+    for (int i = 0; i < h->glyphCount; i++) {
+        glyphs[i].value = baked[i].value;
+        glyphs[i].offsetX = baked[i].offsetX;
+        glyphs[i].offsetY = baked[i].offsetY;
+        glyphs[i].advanceX = baked[i].advanceX;
+        recs[i] = (Rectangle){ baked[i].x, baked[i].y, baked[i].width, baked[i].height };
+    }
+
+    font->baseSize = h->baseSize;
+    font->glyphCount = h->glyphCount;
+    font->glyphPadding = h->glyphPadding;
+    font->texture = texture;
+    font->recs = recs;
+    font->glyphs = glyphs;
+    if (flags) *flags = h->flags;
+    unmap_file(&file);
+    return true;
+}
@@ -0,0 +1,94 @@
+#include "renderer/glyph_advance.h"
+
+#include <string.h>
+
+// Same rule as Raylib_MeasureText: the advance, or the glyph's extent
+// when the font leaves advanceX at 0
+static float glyph_advance(Font font, int codepoint) {
+    int index = GetGlyphIndex(font, codepoint);
+    if (font.glyphs[index].advanceX != 0) return (float)font.glyphs[index].advanceX;
+    return font.recs[index].width + (float)font.glyphs[index].offsetX;
+}
+
+// Bounded UTF-8 decode; Clay hands out slices of longer strings with no
+// terminator. Malformed bytes come out as '?', one byte each.
+static int next_codepoint(const unsigned char* s, int n, int* bytes) {
+    int count = s[0] >= 0xF0 ? 4 : s[0] >= 0xE0 ? 3 : s[0] >= 0xC0 ? 2 : 0;
+    *bytes = 1;
+    if (count == 0 || count > n) return '?';
+    int codepoint = s[0] & (0x7F >> count);
+    for (int k = 1; k < count; k++) {
+        if ((s[k] & 0xC0) != 0x80) return '?';
+        codepoint = (codepoint << 6) | (s[k] & 0x3F);
+    }
+    *bytes = count;
+    return codepoint;
+}
+
+void GlyphAdvanceTable_build(GlyphAdvanceTable* table, Font font) {
+    if (!table) return;
+    memset(table, 0, sizeof(GlyphAdvanceTable));
+    table->font = font;
+    if (!font.glyphs || font.glyphCount <= 0 || font.baseSize <= 0) return;
+    table->baseSize = (float)font.baseSize;
+    for (int c = 32; c < 127; c++) table->advances[c] = glyph_advance(font, c);
+}
+
+// Characters that end a run of plain ASCII: the line break and every
+// byte of a multi-byte UTF-8 sequence
+static const unsigned char stops[256] = {
+    ['\n'] = 1,
+    [0x80] = 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+};
+
+Vector2 GlyphAdvanceTable_measure(const GlyphAdvanceTable* table, const char* text, int length,
+                                  float fontSize, float spacing) {
+    Vector2 size = { 0.0f, fontSize };
+    if (!table || !text || length <= 0 || table->baseSize <= 0.0f) return size;
+    float scale = fontSize / table->baseSize;
+    const unsigned char* s = (const unsigned char*)text;
+    const float* advances = table->advances;
+
+    // Four independent sums break the add dependency chain, so the lookups
+    // of consecutive characters overlap. Advances are whole pixels in
+    // practice, which float adds exactly in any order.
+    float a0 = 0.0f, a1 = 0.0f, a2 = 0.0f, a3 = 0.0f;
+    int lineStart = 0;
+    int lineChars = 0;  // multi-byte characters add one, not their byte count
+    int i = 0;
+    for (;;) {
+        while (i + 4 <= length && !(stops[s[i]] | stops[s[i + 1]] | stops[s[i + 2]] | stops[s[i + 3]])) {
+            a0 += advances[s[i]];
+            a1 += advances[s[i + 1]];
+            a2 += advances[s[i + 2]];
+            a3 += advances[s[i + 3]];
+            i += 4;
+        }
+        if (i < length && !stops[s[i]]) {
+            a0 += advances[s[i++]];
+            continue;
+        }
+        if (i < length && s[i] >= 0x80) {
+            int bytes;
+            int codepoint = next_codepoint(s + i, length - i, &bytes);
+            a0 += glyph_advance(table->font, codepoint);
+            lineChars -= bytes - 1;
+            i += bytes;
+            continue;
+        }
+
+        // End of a line, or of the text
+        lineChars += i - lineStart;
+        float width = ((a0 + a1) + (a2 + a3)) * scale + (float)lineChars * spacing;
+        if (width > size.x) size.x = width;
+        if (i >= length) break;
+        a0 = a1 = a2 = a3 = 0.0f;
+        i++;
+        lineStart = i;
+        lineChars = 0;
+    }
+    return size;
+}
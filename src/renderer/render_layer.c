@@ -0,0 +1,143 @@
+#include "renderer/render_layer.h"
+
+#include <limits.h>
+#include <string.h>
+
+#include "renderer/render_commands.h"
+
+#define RENDER_LAYER_INITIAL_COMMANDS 256
+#define RENDER_PIPELINE_INITIAL_LAYERS 4
+
+// Grows by doubling inside the arena. Capacity settles after the first
+// busy frames, since clearing a layer keeps its buffers.
+static void layer_reserve(RenderLayer* layer, size_t capacity) {
+    if (capacity <= layer->commandCapacity) return;
+    size_t grown = layer->commandCapacity > 0 ? layer->commandCapacity : RENDER_LAYER_INITIAL_COMMANDS;
+    while (grown < capacity) grown *= 2;
+
+    RenderCommand* commands = (RenderCommand*)Arena_alloc(layer->arena, sizeof(RenderCommand) * grown, __FILE__, __LINE__);
+    if (layer->commandCount > 0) memcpy(commands, layer->commands, sizeof(RenderCommand) * layer->commandCount);
+    layer->commands = commands;
+    layer->sorted = (RenderCommand*)Arena_alloc(layer->arena, sizeof(RenderCommand) * grown, __FILE__, __LINE__);
+    layer->groups = (int*)Arena_alloc(layer->arena, sizeof(int) * grown, __FILE__, __LINE__);
+    layer->groupKeys = (const void**)Arena_alloc(layer->arena, sizeof(const void*) * grown, __FILE__, __LINE__);
+    layer->groupOffsets = (int*)Arena_alloc(layer->arena, sizeof(int) * (grown + 1), __FILE__, __LINE__);
+    layer->commandCapacity = grown;
+}
+
+RenderLayer* RenderLayer_create(Arena_T arena, int layerIndex) {
+    RenderLayer* layer = (RenderLayer*)Arena_alloc(arena, sizeof(RenderLayer), __FILE__, __LINE__);
+    memset(layer, 0, sizeof(RenderLayer));
+    layer->arena = arena;
+    layer->layerIndex = layerIndex;
+    layer_reserve(layer, RENDER_LAYER_INITIAL_COMMANDS);
+    return layer;
+}
+
+void RenderLayer_add_command(RenderLayer* layer, const RenderCommand* cmd) {
+    if (!layer || !cmd) return;
+    layer_reserve(layer, layer->commandCount + 1);
+    layer->commands[layer->commandCount++] = *cmd;
+}
+
+void RenderLayer_clear(RenderLayer* layer) {
+    if (layer) layer->commandCount = 0;
+}
+
+// Stable counting sort on the group each command's texture key first
+// appeared in. Layers rarely use more than a handful of textures, so the
+// group lookup is a scan that checks the previous command's group first.
+static const RenderCommand* sort_layer(RenderLayer* layer) {
+    size_t count = layer->commandCount;
+    int groupCount = 0;
+    int last = -1;
+    for (size_t i = 0; i < count; i++) {
+        const void* key = RenderCommand_texture_key(&layer->commands[i]);
+        int group = last;
+        if (group < 0 || layer->groupKeys[group] != key) {
+            for (group = 0; group < groupCount && layer->groupKeys[group] != key; group++) {}
+            if (group == groupCount) layer->groupKeys[groupCount++] = key;
+        }
+        layer->groups[i] = group;
+        last = group;
+    }
+    if (groupCount <= 1) return layer->commands;
+
+    memset(layer->groupOffsets, 0, sizeof(int) * (groupCount + 1));
+    for (size_t i = 0; i < count; i++) layer->groupOffsets[layer->groups[i] + 1]++;
+    for (int g = 0; g < groupCount; g++) layer->groupOffsets[g + 1] += layer->groupOffsets[g];
+    for (size_t i = 0; i < count; i++) {
+        layer->sorted[layer->groupOffsets[layer->groups[i]]++] = layer->commands[i];
+    }
+    return layer->sorted;
+}
+
+RenderPipeline* RenderPipeline_create(Arena_T arena) {
+    RenderPipeline* pipeline = (RenderPipeline*)Arena_alloc(arena, sizeof(RenderPipeline), __FILE__, __LINE__);
+    memset(pipeline, 0, sizeof(RenderPipeline));
+    pipeline->arena = arena;
+    pipeline->layerCapacity = RENDER_PIPELINE_INITIAL_LAYERS;
+    pipeline->layers = (RenderLayer**)Arena_alloc(arena, sizeof(RenderLayer*) * pipeline->layerCapacity, __FILE__, __LINE__);
+    return pipeline;
+}
+
+// Keeps layers ordered by layerIndex; equal indices run in the order added
+void RenderPipeline_add_layer(RenderPipeline* pipeline, RenderLayer* layer) {
+    if (!pipeline || !layer) return;
+    if (pipeline->layerCount == pipeline->layerCapacity) {
+        size_t capacity = pipeline->layerCapacity * 2;
+        RenderLayer** layers = (RenderLayer**)Arena_alloc(pipeline->arena, sizeof(RenderLayer*) * capacity, __FILE__, __LINE__);
+        memcpy(layers, pipeline->layers, sizeof(RenderLayer*) * pipeline->layerCount);
+        pipeline->layers = layers;
+        pipeline->layerCapacity = capacity;
+    }
+    size_t i = pipeline->layerCount++;
+    while (i > 0 && pipeline->layers[i - 1]->layerIndex > layer->layerIndex) {
+        pipeline->layers[i] = pipeline->layers[i - 1];
+        i--;
+    }
+    pipeline->layers[i] = layer;
+}
+
+void RenderPipeline_execute_layers(RenderPipeline* pipeline, Renderer* renderer, int firstLayerIndex, int lastLayerIndex) {
+    if (!pipeline || !renderer) return;
+    RenderPipelineStats* stats = &pipeline->stats;
+
+    // Runs are counted across layers, as a backend batch carries over a layer
+    // boundary when both sides use the same texture
+    const void* bound = NULL;
+    const void* unsortedBound = NULL;
+    for (size_t l = 0; l < pipeline->layerCount; l++) {
+        RenderLayer* layer = pipeline->layers[l];
+        if (layer->layerIndex < firstLayerIndex || layer->layerIndex > lastLayerIndex) continue;
+        if (layer->commandCount == 0) continue;
+        const RenderCommand* commands = sort_layer(layer);
+
+        for (size_t i = 0; i < layer->commandCount; i++) {
+            const void* key = RenderCommand_texture_key(&commands[i]);
+            if (key && key != bound) stats->runs++;
+            if (key) bound = key;
+
+            const void* unsortedKey = RenderCommand_texture_key(&layer->commands[i]);
+            if (unsortedKey && unsortedKey != unsortedBound) stats->unsortedRuns++;
+            if (unsortedKey) unsortedBound = unsortedKey;
+
+            Renderer_execute_command(renderer, &commands[i]);
+        }
+        stats->commands += (long)layer->commandCount;
+    }
+}
+
+void RenderPipeline_execute(RenderPipeline* pipeline, Renderer* renderer) {
+    if (!pipeline || !renderer) return;
+    pipeline->stats = (RenderPipelineStats){ 0, 0, 0 };
+    RenderPipeline_execute_layers(pipeline, renderer, INT_MIN, INT_MAX);
+}
+
+void RenderPipeline_clear(RenderPipeline* pipeline) {
+    if (!pipeline) return;
+    pipeline->stats = (RenderPipelineStats){ 0, 0, 0 };
+    for (size_t l = 0; l < pipeline->layerCount; l++) {
+        RenderLayer_clear(pipeline->layers[l]);
+    }
+}
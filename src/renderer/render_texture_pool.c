@@ -0,0 +1,108 @@
+#include "renderer/render_texture_pool.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static bool add_page(RenderTexturePool* pool) {
+    if (pool->pageCount == pool->pageCapacity) {
+        int capacity = pool->pageCapacity > 0 ? pool->pageCapacity * 2 : 4;
+        RenderTexture2D** pages = (RenderTexture2D**)realloc(pool->pages, sizeof(RenderTexture2D*) * capacity);
+        if (!pages) return false;
+        pool->pages = pages;
+        int* freeSlots = (int*)realloc(pool->freeSlots, sizeof(int) * capacity * pool->slotsPerPage);
+        if (!freeSlots) return false;
+        pool->freeSlots = freeSlots;
+        pool->pageCapacity = capacity;
+    }
+
+    RenderTexture2D* page = (RenderTexture2D*)calloc(1, sizeof(RenderTexture2D));
+    if (!page) return false;
+    if (pool->drawTextures) {
+        *page = LoadRenderTexture(pool->pageSize, pool->pageSize);
+        if (page->id == 0) {
+            free(page);
+            return false;
+        }
+    }
+
+    // Pushed in reverse so the page fills from its first slot
+    int first = pool->pageCount * pool->slotsPerPage;
+    for (int i = pool->slotsPerPage - 1; i >= 0; i--) {
+        pool->freeSlots[pool->freeCount++] = first + i;
+    }
+    pool->pages[pool->pageCount++] = page;
+    return true;
+}
+
+void RenderTexturePool_init(RenderTexturePool* pool, int slotSize, int pageSize, bool drawTextures) {
+    if (!pool) return;
+    memset(pool, 0, sizeof(RenderTexturePool));
+    pool->slotSize = slotSize > 0 ? slotSize : 1;
+    pool->slotsPerSide = pageSize > pool->slotSize ? pageSize / pool->slotSize : 1;
+    pool->pageSize = pool->slotsPerSide * pool->slotSize;
+    pool->slotsPerPage = pool->slotsPerSide * pool->slotsPerSide;
+    pool->drawTextures = drawTextures;
+}
+
+void RenderTexturePool_free(RenderTexturePool* pool) {
+    if (!pool) return;
+    for (int i = 0; i < pool->pageCount; i++) {
+        if (pool->drawTextures) UnloadRenderTexture(*pool->pages[i]);
+        free(pool->pages[i]);
+    }
+    free(pool->pages);
+    free(pool->freeSlots);
+    RenderTexturePool_init(pool, pool->slotSize, pool->pageSize, pool->drawTextures);
+}
+
+bool RenderTexturePool_reserve(RenderTexturePool* pool, int slotCount) {
+    if (!pool) return false;
+    while (pool->freeCount < slotCount) {
+        if (!add_page(pool)) return false;
+    }
+    return true;
+}
+
+int RenderTexturePool_acquire(RenderTexturePool* pool) {
+    if (!pool) return -1;
+    if (pool->freeCount == 0 && !add_page(pool)) return -1;
+    return pool->freeSlots[--pool->freeCount];
+}
+
+void RenderTexturePool_release(RenderTexturePool* pool, int slot) {
+    if (!pool || slot < 0 || slot >= pool->pageCount * pool->slotsPerPage) return;
+    pool->freeSlots[pool->freeCount++] = slot;
+}
+
+RenderTexture2D* RenderTexturePool_page(const RenderTexturePool* pool, int slot) {
+    return pool->pages[slot / pool->slotsPerPage];
+}
+
+Rectangle RenderTexturePool_slot_rect(const RenderTexturePool* pool, int slot) {
+    int index = slot % pool->slotsPerPage;
+    float size = (float)pool->slotSize;
+    return (Rectangle){ (index % pool->slotsPerSide) * size, (index / pool->slotsPerSide) * size, size, size };
+}
+
+Rectangle RenderTexturePool_slot_source(const RenderTexturePool* pool, int slot) {
+    Rectangle r = RenderTexturePool_slot_rect(pool, slot);
+    // Texture rows run bottom-up: the slot's top edge is pageSize - r.y
+    return (Rectangle){ r.x, pool->pageSize - r.y - r.height, r.width, -r.height };
+}
+
+void RenderTexturePool_begin_slot(RenderTexturePool* pool, int slot) {
+    BeginTextureMode(*RenderTexturePool_page(pool, slot));
+}
+
+void RenderTexturePool_clear_slot_rect(RenderTexturePool* pool, int slot, Rectangle local) {
+    Rectangle r = RenderTexturePool_slot_rect(pool, slot);
+    // The scissor limits the clear, so the rest of the page survives
+    BeginScissorMode((int)(r.x + local.x), (int)(r.y + local.y), (int)local.width, (int)local.height);
+    ClearBackground(BLANK);
+    EndScissorMode();
+}
+
+void RenderTexturePool_end_slot(RenderTexturePool* pool) {
+    (void)pool;
+    EndTextureMode();
+}
@@ -0,0 +1,208 @@
+#include "renderer/renderer_headless.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+#include "renderer/render_commands.h"
+
+#define HEADLESS_INITIAL_COMMANDS 1024
+
+typedef struct HeadlessBackend {
+    int width;
+    int height;
+    float deltaTime;
+    uint32_t frameLimit;
+    uint32_t frame;
+    bool closed;
+
+    Arena_T arena;  // command buffer and text copies, reset every begin_frame
+    RenderCommand* commands;
+    long commandCount;
+    long commandCapacity;
+    const void* boundTexture;
+
+    RendererHeadlessStats frameStats;
+    RendererHeadlessStats totalStats;
+} HeadlessBackend;
+
+static HeadlessBackend* backend_of(const Renderer* renderer) {
+    return renderer ? (HeadlessBackend*)renderer->backendData : NULL;
+}
+
+static void reset_frame(HeadlessBackend* b) {
+    Arena_free(b->arena);
+    b->commandCapacity = HEADLESS_INITIAL_COMMANDS;
+    b->commands = (RenderCommand*)Arena_alloc(b->arena, sizeof(RenderCommand) * b->commandCapacity, __FILE__, __LINE__);
+    b->commandCount = 0;
+    b->boundTexture = NULL;
+    memset(&b->frameStats, 0, sizeof(b->frameStats));
+}
+
+// Grows by doubling inside the arena; the old buffer is reclaimed with the
+// rest of the frame
+static RenderCommand* push_command(HeadlessBackend* b) {
+    if (b->commandCount == b->commandCapacity) {
+        long capacity = b->commandCapacity * 2;
+        RenderCommand* grown = (RenderCommand*)Arena_alloc(b->arena, sizeof(RenderCommand) * capacity, __FILE__, __LINE__);
+        memcpy(grown, b->commands, sizeof(RenderCommand) * b->commandCount);
+        b->commands = grown;
+        b->commandCapacity = capacity;
+    }
+    return &b->commands[b->commandCount++];
+}
+
+static void count(HeadlessBackend* b, long drawCalls, long textureBinds, long bytes) {
+    b->frameStats.commands++;
+    b->frameStats.drawCalls += drawCalls;
+    b->frameStats.textureBinds += textureBinds;
+    b->frameStats.bytes += bytes;
+    b->totalStats.commands++;
+    b->totalStats.drawCalls += drawCalls;
+    b->totalStats.textureBinds += textureBinds;
+    b->totalStats.bytes += bytes;
+}
+
+static void headless_init(Renderer* renderer, int width, int height, const char* title, unsigned int flags) {
+    (void)title;
+    (void)flags;
+    HeadlessBackend* b = backend_of(renderer);
+    if (!b) return;
+    b->width = width;
+    b->height = height;
+    b->closed = false;
+}
+
+static void headless_close(Renderer* renderer) {
+    HeadlessBackend* b = backend_of(renderer);
+    if (b) b->closed = true;
+}
+
+static bool headless_should_close(Renderer* renderer) {
+    HeadlessBackend* b = backend_of(renderer);
+    if (!b) return true;
+    return b->closed || (b->frameLimit > 0 && b->frame >= b->frameLimit);
+}
+
+static void headless_begin_frame(Renderer* renderer) {
+    HeadlessBackend* b = backend_of(renderer);
+    if (b) reset_frame(b);
+}
+
+static void headless_end_frame(Renderer* renderer) {
+    HeadlessBackend* b = backend_of(renderer);
+    if (b) b->frame++;
+}
+
+static void headless_execute_command(Renderer* renderer, const RenderCommand* cmd) {
+    HeadlessBackend* b = backend_of(renderer);
+    if (!b || !cmd) return;
+
+    RenderCommand* recorded = push_command(b);
+    *recorded = *cmd;
+    long bytes = (long)sizeof(RenderCommand);
+    if (cmd->type == RENDER_COMMAND_TYPE_TEXT && cmd->text) {
+        // The caller's string is usually a reused format buffer
+        size_t length = strlen(cmd->text) + 1;
+        char* copy = (char*)Arena_alloc(b->arena, length, __FILE__, __LINE__);
+        memcpy(copy, cmd->text, length);
+        recorded->text = copy;
+        bytes += (long)length;
+    }
+
+    const void* texture = RenderCommand_texture_key(cmd);
+    if (!texture) {
+        count(b, 0, 0, bytes);
+        return;
+    }
+    long bind = texture != b->boundTexture ? 1 : 0;
+    b->boundTexture = texture;
+    count(b, 1, bind, bytes);
+}
+
+static float headless_get_delta_time(Renderer* renderer) {
+    HeadlessBackend* b = backend_of(renderer);
+    return b ? b->deltaTime : 0.0f;
+}
+
+static int headless_get_render_width(Renderer* renderer) {
+    HeadlessBackend* b = backend_of(renderer);
+    return b ? b->width : 0;
+}
+
+static int headless_get_render_height(Renderer* renderer) {
+    HeadlessBackend* b = backend_of(renderer);
+    return b ? b->height : 0;
+}
+
+static RenderVector2 headless_get_window_size(Renderer* renderer) {
+    HeadlessBackend* b = backend_of(renderer);
+    if (!b) return (RenderVector2){ 0.0f, 0.0f };
+    return (RenderVector2){ (float)b->width, (float)b->height };
+}
+
+static const RendererVTable headlessVTable = {
+    .init = headless_init,
+    .close = headless_close,
+    .should_close = headless_should_close,
+    .begin_frame = headless_begin_frame,
+    .end_frame = headless_end_frame,
+    .execute_command = headless_execute_command,
+    .get_delta_time = headless_get_delta_time,
+    .get_render_width = headless_get_render_width,
+    .get_render_height = headless_get_render_height,
+    .get_window_size = headless_get_window_size,
+};
+
+Renderer* RendererHeadless_create(int width, int height, float deltaTime, uint32_t frameLimit) {
+    Renderer* renderer = (Renderer*)malloc(sizeof(Renderer));
+    HeadlessBackend* b = (HeadlessBackend*)calloc(1, sizeof(HeadlessBackend));
+    if (!renderer || !b) {
+        free(renderer);
+        free(b);
+        return NULL;
+    }
+    b->width = width;
+    b->height = height;
+    b->deltaTime = deltaTime;
+    b->frameLimit = frameLimit;
+    b->arena = Arena_new();
+    reset_frame(b);
+
+    renderer->vtable = &headlessVTable;
+    renderer->backendData = b;
+    return renderer;
+}
+
+void RendererHeadless_destroy(Renderer* renderer) {
+    if (!renderer) return;
+    HeadlessBackend* b = backend_of(renderer);
+    if (b) {
+        Arena_dispose(&b->arena);
+        free(b);
+    }
+    free(renderer);
+}
+
+const RenderCommand* RendererHeadless_commands(const Renderer* renderer, long* outCount) {
+    HeadlessBackend* b = backend_of(renderer);
+    if (outCount) *outCount = b ? b->commandCount : 0;
+    return b ? b->commands : NULL;
+}
+
+RendererHeadlessStats RendererHeadless_frame_stats(const Renderer* renderer) {
+    HeadlessBackend* b = backend_of(renderer);
+    RendererHeadlessStats none = { 0, 0, 0, 0 };
+    return b ? b->frameStats : none;
+}
+
+RendererHeadlessStats RendererHeadless_total_stats(const Renderer* renderer) {
+    HeadlessBackend* b = backend_of(renderer);
+    RendererHeadlessStats none = { 0, 0, 0, 0 };
+    return b ? b->totalStats : none;
+}
+
+uint32_t RendererHeadless_frame_count(const Renderer* renderer) {
+    HeadlessBackend* b = backend_of(renderer);
+    return b ? b->frame : 0;
+}
@@ -37,7 +37,11 @@ AspectFit CameraSystem_compute_fit(GameState* state) {
 }
 
 void CameraSystem_clamp(GameState* state, AspectFit fit) {
-    Camera_ClampToBounds(&state->cam, (Vector2){ state->mapSize * state->tileSize, state->mapSize * state->tileSize }, fit);
+    // The world has no fixed size; keep the view over the table, or the chunks that exist
+    int x, y, w, h;
+    if (!TileStorage_get_bounds(&state->map, &x, &y, &w, &h)) return;
+    float ts = (float)state->tileSize;
+    Camera_ClampToRect(&state->cam, (Rectangle){ x * ts, y * ts, w * ts, h * ts }, fit);
 }
 
 
@@ -0,0 +1,302 @@
+#include "systems/chunk_stream_system.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "raylib.h"
+
+#ifdef USE_THREADING
+#define load_acquire(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define load_relaxed(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#define store_release(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define cas_weak(p, expected, desired) \
+    __atomic_compare_exchange_n((p), (expected), (desired), true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#else
+#define load_acquire(p) (*(p))
+#define load_relaxed(p) (*(p))
+#define store_release(p, v) (*(p) = (v))
+static bool cas_weak(uint32_t* p, uint32_t* expected, uint32_t desired) {
+    if (*p != *expected) {
+        *expected = *p;
+        return false;
+    }
+    *p = desired;
+    return true;
+}
+#endif
+
+#define COMPLETION_MASK (CHUNK_STREAM_COMPLETION_CAPACITY - 1)
+#define JOB_MASK (CHUNK_STREAM_JOB_CAPACITY - 1)
+
+static void completion_init(ChunkCompletionQueue* q) {
+    for (uint32_t i = 0; i < CHUNK_STREAM_COMPLETION_CAPACITY; i++) {
+        q->slots[i].sequence = i;
+    }
+    q->enqueuePos = 0;
+    q->dequeuePos = 0;
+}
+
+// Any thread. A slot is free for position pos when its sequence equals pos.
+static bool completion_push(ChunkCompletionQueue* q, ChunkLoadResult result) {
+    uint32_t pos = load_relaxed(&q->enqueuePos);
+    for (;;) {
+        ChunkCompletionSlot* slot = &q->slots[pos & COMPLETION_MASK];
+        int32_t diff = (int32_t)(load_acquire(&slot->sequence) - pos);
+        if (diff == 0) {
+            if (cas_weak(&q->enqueuePos, &pos, pos + 1)) {
+                slot->result = result;
+                store_release(&slot->sequence, pos + 1);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;  // full
+        } else {
+            pos = load_relaxed(&q->enqueuePos);
+        }
+    }
+}
+
+// Main thread only. A slot holds a result for pos when its sequence is pos + 1.
+static bool completion_pop(ChunkCompletionQueue* q, ChunkLoadResult* out) {
+    uint32_t pos = q->dequeuePos;
+    ChunkCompletionSlot* slot = &q->slots[pos & COMPLETION_MASK];
+    if ((int32_t)(load_acquire(&slot->sequence) - (pos + 1)) < 0) return false;
+    *out = slot->result;
+    q->dequeuePos = pos + 1;
+    store_release(&slot->sequence, pos + CHUNK_STREAM_COMPLETION_CAPACITY);
+    return true;
+}
+
+static uint16_t* read_tiles(ChunkStreamSystem* sys, RegionStore* store, const ChunkLoadJob* job) {
+    uint16_t* tiles = (uint16_t*)malloc(sizeof(uint16_t) * CHUNK_AREA);
+    if (!tiles) return NULL;
+    bool ok = job->generate ? World_generate_tiles(sys->world, job->chunkX, job->chunkY, tiles)
+                            : RegionStore_read_tiles(store, job->chunkX, job->chunkY, tiles);
+    if (!ok) {
+        free(tiles);
+        tiles = NULL;
+    }
+    return tiles;
+}
+
+// The push cannot fail: enqueue_load keeps the loads in flight within the
+// queue's capacity, so a worker never waits on the main thread (which may be
+// joining it) for a slot
+static void finish_job(ChunkStreamSystem* sys, RegionStore* store, const ChunkLoadJob* job) {
+    ChunkLoadResult result = { job->chunk, read_tiles(sys, store, job) };
+    completion_push(&sys->done, result);
+}
+
+static void lock_jobs(ChunkStreamSystem* sys) {
+#ifdef USE_THREADING
+    pthread_mutex_lock(&sys->lock);
+#else
+    (void)sys;
+#endif
+}
+
+static void unlock_jobs(ChunkStreamSystem* sys) {
+#ifdef USE_THREADING
+    pthread_mutex_unlock(&sys->lock);
+#else
+    (void)sys;
+#endif
+}
+
+static ChunkLoadJob pop_job(ChunkStreamSystem* sys) {
+    ChunkLoadJob job = sys->jobs[sys->jobHead];
+    sys->jobHead = (sys->jobHead + 1) & JOB_MASK;
+    sys->jobCount--;
+    return job;
+}
+
+// Main thread. Workers only take jobs, so a load that fits now is still accepted when queued
+static bool has_room(ChunkStreamSystem* sys) {
+    if (sys->outstanding == CHUNK_STREAM_COMPLETION_CAPACITY) return false;
+    lock_jobs(sys);
+    bool room = sys->jobCount < CHUNK_STREAM_JOB_CAPACITY;
+    unlock_jobs(sys);
+    return room;
+}
+
+// WorldLoadFn, main thread
+static bool enqueue_load(void* userData, Chunk* chunk) {
+    ChunkStreamSystem* sys = (ChunkStreamSystem*)userData;
+    // World_peek_chunk asks again next frame
+    if (sys->outstanding == CHUNK_STREAM_COMPLETION_CAPACITY) return false;
+    lock_jobs(sys);
+    if (sys->jobCount == CHUNK_STREAM_JOB_CAPACITY) {
+        unlock_jobs(sys);
+        return false;
+    }
+    sys->jobs[(sys->jobHead + sys->jobCount) & JOB_MASK] = (ChunkLoadJob){ chunk, chunk->chunkX, chunk->chunkY, !chunk->stored };
+    sys->jobCount++;
+#ifdef USE_THREADING
+    pthread_cond_signal(&sys->wake);
+#endif
+    unlock_jobs(sys);
+
+    sys->outstanding++;
+    sys->requested++;
+    if (sys->prefetching) sys->prefetched++;
+    return true;
+}
+
+#ifdef USE_THREADING
+static void* worker_main(void* arg) {
+    ChunkStreamWorker* worker = (ChunkStreamWorker*)arg;
+    ChunkStreamSystem* sys = worker->sys;
+    for (;;) {
+        pthread_mutex_lock(&sys->lock);
+        while (sys->running && sys->jobCount == 0) {
+            pthread_cond_wait(&sys->wake, &sys->lock);
+        }
+        if (!sys->running) {
+            pthread_mutex_unlock(&sys->lock);
+            break;
+        }
+        ChunkLoadJob job = pop_job(sys);
+        pthread_mutex_unlock(&sys->lock);
+
+        finish_job(sys, &worker->store, &job);
+    }
+    RegionStore_close(&worker->store);
+    return NULL;
+}
+#endif
+
+void ChunkStreamSystem_init(ChunkStreamSystem* sys, World* world, int workerCount, int loadRadius, int prefetchDepth) {
+    if (!sys) return;
+    memset(sys, 0, sizeof(*sys));
+    sys->world = world;
+    sys->loadRadius = loadRadius;
+    sys->prefetchDepth = prefetchDepth;
+    completion_init(&sys->done);
+    if (!world) return;
+
+    // Without paging nothing is ever evicted, so only new chunks are streamed
+    if (world->paging) RegionStore_open_readonly(&sys->store, world->store.directory);
+    World_set_loader(world, enqueue_load, sys);
+
+#ifdef USE_THREADING
+    pthread_mutex_init(&sys->lock, NULL);
+    pthread_cond_init(&sys->wake, NULL);
+    sys->running = true;
+    if (workerCount > CHUNK_STREAM_MAX_WORKERS) workerCount = CHUNK_STREAM_MAX_WORKERS;
+    for (int i = 0; i < workerCount; i++) {
+        ChunkStreamWorker* worker = &sys->workers[sys->workerCount];
+        worker->sys = sys;
+        if (world->paging) RegionStore_open_readonly(&worker->store, world->store.directory);
+        if (pthread_create(&worker->thread, NULL, worker_main, worker) != 0) {
+            TraceLog(LOG_WARNING, "ChunkStreamSystem_init: Failed to start worker %d, loading on fewer threads", i);
+            break;
+        }
+        sys->workerCount++;
+    }
+#else
+    (void)workerCount;
+#endif
+}
+
+void ChunkStreamSystem_shutdown(ChunkStreamSystem* sys) {
+    if (!sys || !sys->world) return;
+    World_set_loader(sys->world, NULL, NULL);
+
+#ifdef USE_THREADING
+    pthread_mutex_lock(&sys->lock);
+    sys->running = false;
+    pthread_cond_broadcast(&sys->wake);
+    pthread_mutex_unlock(&sys->lock);
+    for (int i = 0; i < sys->workerCount; i++) {
+        pthread_join(sys->workers[i].thread, NULL);
+    }
+    sys->workerCount = 0;
+    pthread_cond_destroy(&sys->wake);
+    pthread_mutex_destroy(&sys->lock);
+#endif
+
+    // Jobs nobody picked up go back to plain paged-out or dropped chunks;
+    // first generations are finished here, since nothing else would
+    while (sys->jobCount > 0) {
+        ChunkLoadJob job = pop_job(sys);
+        if (job.chunk->generating) {
+            finish_job(sys, &sys->store, &job);
+            continue;
+        }
+        job.chunk->loading = false;
+        sys->outstanding--;
+    }
+    ChunkStreamSystem_update(sys);
+    RegionStore_close(&sys->store);
+}
+
+int ChunkStreamSystem_update(ChunkStreamSystem* sys) {
+    if (!sys || !sys->world) return 0;
+
+    // No workers: spend a fixed number of loads per frame on the main thread
+    if (sys->workerCount == 0) {
+        for (int i = 0; i < CHUNK_STREAM_SYNC_PER_FRAME && sys->jobCount > 0; i++) {
+            ChunkLoadJob job = pop_job(sys);
+            finish_job(sys, &sys->store, &job);
+        }
+    }
+
+    int installed = 0;
+    ChunkLoadResult result;
+    while (completion_pop(&sys->done, &result)) {
+        World_finish_load(sys->world, result.chunk, result.tiles);
+        installed++;
+    }
+    sys->outstanding -= installed;
+    sys->installed += installed;
+    return installed;
+}
+
+void ChunkStreamSystem_prefetch(ChunkStreamSystem* sys, int tileX, int tileY) {
+    if (!sys || !sys->world || !sys->world->loader || sys->prefetchDepth <= 0) return;
+
+    if (!sys->hasLastPos) {
+        sys->hasLastPos = true;
+        sys->lastTileX = tileX;
+        sys->lastTileY = tileY;
+        return;
+    }
+
+    // Heading is a decaying average of recent steps; standing still lets it fade out
+    int dx = tileX - sys->lastTileX;
+    int dy = tileY - sys->lastTileY;
+    if (dx != 0 || dy != 0) {
+        float len = sqrtf((float)(dx * dx + dy * dy));
+        sys->dirX = sys->dirX * 0.75f + 0.25f * (float)dx / len;
+        sys->dirY = sys->dirY * 0.75f + 0.25f * (float)dy / len;
+        sys->lastTileX = tileX;
+        sys->lastTileY = tileY;
+    } else {
+        sys->dirX *= 0.99f;
+        sys->dirY *= 0.99f;
+    }
+
+    float heading = sqrtf(sys->dirX * sys->dirX + sys->dirY * sys->dirY);
+    if (heading < 0.3f) return;
+
+    // Load window around where the observer is heading, minus the one it already has.
+    // World_find_chunk leaves the LRU alone; only chunks out of memory are queued, and
+    // chunks that do not exist yet are handed to the generator through World_request_chunk
+    int ocx = Chunk_coord(tileX), ocy = Chunk_coord(tileY);
+    int pcx = ocx + (int)lroundf(sys->dirX / heading * (float)sys->prefetchDepth);
+    int pcy = ocy + (int)lroundf(sys->dirY / heading * (float)sys->prefetchDepth);
+    int r = sys->loadRadius;
+
+    sys->prefetching = true;
+    for (int cy = pcy - r; cy <= pcy + r; cy++) {
+        for (int cx = pcx - r; cx <= pcx + r; cx++) {
+            if (abs(cx - ocx) <= r && abs(cy - ocy) <= r) continue;
+            Chunk* chunk = World_find_chunk(sys->world, cx, cy);
+            // World_request_chunk generates right here when the loader is full
+            if (!chunk && has_room(sys)) World_request_chunk(sys->world, cx, cy);
+            else if (chunk && !chunk->resident && !chunk->packed) World_load_async(sys->world, chunk);
+        }
+    }
+    sys->prefetching = false;
+}
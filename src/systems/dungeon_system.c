@@ -0,0 +1,126 @@
+#include "systems/dungeon_system.h"
+
+#include <string.h>
+
+#include "raylib.h"
+
+// Regions index, index + participants, ... of the current pass. Striding
+// keeps neighbouring regions on different threads and needs no shared cursor.
+static void run_share(DungeonSystem* sys, int index, int participants) {
+    int count = FloorSystem_region_count(sys->floor);
+    for (int region = index; region < count; region += participants) {
+        sys->pass(sys->floor, region);
+    }
+}
+
+#ifdef USE_THREADING
+static void* worker_main(void* arg) {
+    DungeonWorker* worker = (DungeonWorker*)arg;
+    DungeonSystem* sys = worker->sys;
+    uint32_t seen = 0;
+    for (;;) {
+        pthread_mutex_lock(&sys->lock);
+        while (sys->running && sys->passNumber == seen) {
+            pthread_cond_wait(&sys->wake, &sys->lock);
+        }
+        if (!sys->running) {
+            pthread_mutex_unlock(&sys->lock);
+            break;
+        }
+        seen = sys->passNumber;
+        pthread_mutex_unlock(&sys->lock);
+
+        run_share(sys, worker->index, sys->workerCount + 1);
+
+        pthread_mutex_lock(&sys->lock);
+        sys->finished++;
+        pthread_cond_signal(&sys->done);
+        pthread_mutex_unlock(&sys->lock);
+    }
+    return NULL;
+}
+#endif
+
+// Runs pass over every region of sys->floor and returns once all of them are done
+static void run_pass(DungeonSystem* sys, void (*pass)(Floor* floor, int region)) {
+#ifdef USE_THREADING
+    if (sys->workerCount > 0) {
+        pthread_mutex_lock(&sys->lock);
+        sys->pass = pass;
+        sys->finished = 0;
+        sys->passNumber++;
+        pthread_cond_broadcast(&sys->wake);
+        pthread_mutex_unlock(&sys->lock);
+
+        run_share(sys, 0, sys->workerCount + 1);
+
+        pthread_mutex_lock(&sys->lock);
+        while (sys->finished < sys->workerCount) {
+            pthread_cond_wait(&sys->done, &sys->lock);
+        }
+        pthread_mutex_unlock(&sys->lock);
+        return;
+    }
+#endif
+    sys->pass = pass;
+    run_share(sys, 0, 1);
+}
+
+void DungeonSystem_init(DungeonSystem* sys, uint32_t seed, int workerCount) {
+    if (!sys) return;
+    memset(sys, 0, sizeof(*sys));
+    sys->seed = seed;
+
+#ifdef USE_THREADING
+    pthread_mutex_init(&sys->lock, NULL);
+    pthread_cond_init(&sys->wake, NULL);
+    pthread_cond_init(&sys->done, NULL);
+    sys->running = true;
+    if (workerCount > DUNGEON_MAX_WORKERS) workerCount = DUNGEON_MAX_WORKERS;
+    for (int i = 0; i < workerCount; i++) {
+        DungeonWorker* worker = &sys->workers[sys->workerCount];
+        worker->sys = sys;
+        worker->index = sys->workerCount + 1;  // the calling thread takes share 0
+        if (pthread_create(&worker->thread, NULL, worker_main, worker) != 0) {
+            TraceLog(LOG_WARNING, "DungeonSystem_init: Failed to start worker %d, generating on fewer threads", i);
+            break;
+        }
+        sys->workerCount++;
+    }
+#else
+    (void)workerCount;
+#endif
+}
+
+void DungeonSystem_shutdown(DungeonSystem* sys) {
+    if (!sys) return;
+#ifdef USE_THREADING
+    if (!sys->running) return;
+    pthread_mutex_lock(&sys->lock);
+    sys->running = false;
+    pthread_cond_broadcast(&sys->wake);
+    pthread_mutex_unlock(&sys->lock);
+    for (int i = 0; i < sys->workerCount; i++) {
+        pthread_join(sys->workers[i].thread, NULL);
+    }
+    // Later floors are generated on the calling thread
+    sys->workerCount = 0;
+    pthread_cond_destroy(&sys->done);
+    pthread_cond_destroy(&sys->wake);
+    pthread_mutex_destroy(&sys->lock);
+#endif
+}
+
+void DungeonSystem_generate(DungeonSystem* sys, Floor* floor, int depth, const FloorTiles* palette) {
+    if (!sys || !floor || !floor->tiles || !palette) return;
+
+    FloorSystem_begin(floor, FloorSystem_floor_seed(sys->seed, depth), palette);
+    sys->floor = floor;
+    run_pass(sys, FloorSystem_place_rooms);
+    run_pass(sys, FloorSystem_connect);
+    FloorSystem_finish(floor);
+    sys->floor = NULL;
+
+    sys->floors++;
+    sys->regions += FloorSystem_region_count(floor);
+}
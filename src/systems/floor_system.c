@@ -0,0 +1,244 @@
+#include "systems/floor_system.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "components/world.h"
+
+static void set_size(Floor* floor, int width, int height) {
+    floor->width = width;
+    floor->height = height;
+    floor->regionsX = (width + FLOOR_REGION_SIZE - 1) / FLOOR_REGION_SIZE;
+    floor->regionsY = (height + FLOOR_REGION_SIZE - 1) / FLOOR_REGION_SIZE;
+}
+
+bool FloorSystem_init(Floor* floor, int width, int height) {
+    if (!floor) return false;
+    memset(floor, 0, sizeof(*floor));
+    if (width <= 0 || height <= 0) return false;
+
+    set_size(floor, width, height);
+    floor->tiles = (uint16_t*)malloc(sizeof(uint16_t) * (size_t)width * (size_t)height);
+    floor->rooms = (Room*)calloc((size_t)floor->regionsX * (size_t)floor->regionsY, sizeof(Room));
+    if (!floor->tiles || !floor->rooms) {
+        FloorSystem_free(floor);
+        return false;
+    }
+    return true;
+}
+
+static void place_stairs(Floor* floor);
+
+bool FloorSystem_init_streamed(Floor* floor, int width, int height, uint32_t seed, const FloorTiles* palette) {
+    if (!floor) return false;
+    memset(floor, 0, sizeof(*floor));
+    if (width <= 0 || height <= 0 || !palette) return false;
+
+    floor->cache = (FloorRegion*)calloc(FLOOR_REGION_CACHE, sizeof(FloorRegion));
+    if (!floor->cache) return false;
+#ifdef USE_THREADING
+    pthread_mutex_init(&floor->cacheLock, NULL);
+#endif
+    set_size(floor, width, height);
+    FloorSystem_begin(floor, seed, palette);
+    place_stairs(floor);
+    return true;
+}
+
+void FloorSystem_free(Floor* floor) {
+    if (!floor) return;
+    free(floor->tiles);
+    free(floor->rooms);
+    floor->tiles = NULL;
+    floor->rooms = NULL;
+    if (floor->cache) {
+#ifdef USE_THREADING
+        pthread_mutex_destroy(&floor->cacheLock);
+#endif
+        free(floor->cache);
+        floor->cache = NULL;
+    }
+}
+
+uint32_t FloorSystem_floor_seed(uint32_t dungeonSeed, int depth) {
+    return World_chunk_seed(dungeonSeed, depth, -1);
+}
+
+static Room region_rect(const Floor* floor, int regionX, int regionY) {
+    Room rect = { regionX * FLOOR_REGION_SIZE, regionY * FLOOR_REGION_SIZE, FLOOR_REGION_SIZE, FLOOR_REGION_SIZE };
+    if (rect.x + rect.width > floor->width) rect.width = floor->width - rect.x;
+    if (rect.y + rect.height > floor->height) rect.height = floor->height - rect.y;
+    return rect;
+}
+
+void FloorSystem_begin(Floor* floor, uint32_t seed, const FloorTiles* palette) {
+    floor->seed = seed;
+    floor->palette = *palette;
+}
+
+int FloorSystem_region_count(const Floor* floor) {
+    return floor->regionsX * floor->regionsY;
+}
+
+// The room of region (regionX, regionY); a streamed floor places it again each time
+static Room room_at(const Floor* floor, int regionX, int regionY) {
+    if (floor->rooms) return floor->rooms[regionY * floor->regionsX + regionX];
+    Room cell = region_rect(floor, regionX, regionY);
+    return RoomSystem_place(World_chunk_seed(floor->seed, regionX, regionY), cell.x, cell.y, cell.width, cell.height);
+}
+
+void FloorSystem_place_rooms(Floor* floor, int region) {
+    int regionX = region % floor->regionsX, regionY = region / floor->regionsX;
+    Room cell = region_rect(floor, regionX, regionY);
+    Room room = RoomSystem_place(World_chunk_seed(floor->seed, regionX, regionY), cell.x, cell.y, cell.width, cell.height);
+    floor->rooms[region] = room;
+
+    RoomSystem_carve(floor->tiles, floor->width, cell, cell, floor->palette.wall);
+    RoomSystem_carve(floor->tiles, floor->width, room, cell, floor->palette.room);
+}
+
+// Corridor from region (ax, ay) to its right (down false) or lower neighbour, clipped to clip.
+// tiles has stride columns and starts at tile (originX, originY).
+// The bend comes from the first region's seed, so both regions it crosses agree on it.
+static void carve_edge(const Floor* floor, uint16_t* tiles, int stride, int originX, int originY, Room clip,
+                       int ax, int ay, bool down) {
+    Room a = room_at(floor, ax, ay);
+    Room b = down ? room_at(floor, ax, ay + 1) : room_at(floor, ax + 1, ay);
+    uint32_t bits = World_chunk_seed(floor->seed, ax, ay);
+    bool horizontalFirst = ((bits >> (down ? 31 : 30)) & 1u) != 0;
+    clip.x -= originX;
+    clip.y -= originY;
+    RoomSystem_carve_corridor(tiles, stride, clip,
+                              Room_center_x(&a) - originX, Room_center_y(&a) - originY,
+                              Room_center_x(&b) - originX, Room_center_y(&b) - originY,
+                              horizontalFirst, floor->palette.wall, floor->palette.corridor);
+}
+
+static void connect_region(const Floor* floor, uint16_t* tiles, int stride, int originX, int originY,
+                           int regionX, int regionY) {
+    Room cell = region_rect(floor, regionX, regionY);
+
+    // A corridor between two neighbours never leaves them, so these four are all that cross the cell
+    if (regionX > 0) carve_edge(floor, tiles, stride, originX, originY, cell, regionX - 1, regionY, false);
+    if (regionX + 1 < floor->regionsX) carve_edge(floor, tiles, stride, originX, originY, cell, regionX, regionY, false);
+    if (regionY > 0) carve_edge(floor, tiles, stride, originX, originY, cell, regionX, regionY - 1, true);
+    if (regionY + 1 < floor->regionsY) carve_edge(floor, tiles, stride, originX, originY, cell, regionX, regionY, true);
+}
+
+void FloorSystem_connect(Floor* floor, int region) {
+    connect_region(floor, floor->tiles, floor->width, 0, 0, region % floor->regionsX, region / floor->regionsX);
+}
+
+// Picks the two stair rooms from the floor's seed
+static void place_stairs(Floor* floor) {
+    uint32_t rng = floor->seed ? floor->seed : 0x9E3779B9u;
+    uint32_t count = (uint32_t)FloorSystem_region_count(floor);
+    uint32_t up = RoomSystem_rand(&rng) % count;
+    uint32_t down = up;
+    if (count > 1) down = (up + 1 + RoomSystem_rand(&rng) % (count - 1)) % count;
+
+    Room upRoom = room_at(floor, (int)up % floor->regionsX, (int)up / floor->regionsX);
+    Room downRoom = room_at(floor, (int)down % floor->regionsX, (int)down / floor->regionsX);
+    floor->upX = Room_center_x(&upRoom);
+    floor->upY = Room_center_y(&upRoom);
+    floor->downX = Room_center_x(&downRoom);
+    floor->downY = Room_center_y(&downRoom);
+}
+
+void FloorSystem_finish(Floor* floor) {
+    place_stairs(floor);
+    floor->tiles[(long)floor->downY * floor->width + floor->downX] = floor->palette.stairsDown;
+    floor->tiles[(long)floor->upY * floor->width + floor->upX] = floor->palette.stairsUp;
+}
+
+void FloorSystem_generate(Floor* floor, uint32_t seed, const FloorTiles* palette) {
+    if (!floor || !floor->tiles) return;
+    FloorSystem_begin(floor, seed, palette);
+    int count = FloorSystem_region_count(floor);
+    for (int i = 0; i < count; i++) FloorSystem_place_rooms(floor, i);
+    for (int i = 0; i < count; i++) FloorSystem_connect(floor, i);
+    FloorSystem_finish(floor);
+}
+
+static void put_stairs(uint16_t* tiles, Room cell, int x, int y, uint16_t tile_id) {
+    if (x < cell.x || y < cell.y || x >= cell.x + cell.width || y >= cell.y + cell.height) return;
+    tiles[(y - cell.y) * FLOOR_REGION_SIZE + (x - cell.x)] = tile_id;
+}
+
+// Both passes and FloorSystem_finish for one region, into tiles FLOOR_REGION_SIZE
+// wide that start at the region's corner
+static void generate_region(const Floor* floor, int regionX, int regionY, uint16_t* tiles) {
+    Room cell = region_rect(floor, regionX, regionY);
+    Room local = { 0, 0, cell.width, cell.height };
+    Room room = room_at(floor, regionX, regionY);
+    room.x -= cell.x;
+    room.y -= cell.y;
+    RoomSystem_carve(tiles, FLOOR_REGION_SIZE, local, local, floor->palette.wall);
+    RoomSystem_carve(tiles, FLOOR_REGION_SIZE, room, local, floor->palette.room);
+    connect_region(floor, tiles, FLOOR_REGION_SIZE, cell.x, cell.y, regionX, regionY);
+    put_stairs(tiles, cell, floor->downX, floor->downY, floor->palette.stairsDown);
+    put_stairs(tiles, cell, floor->upX, floor->upY, floor->palette.stairsUp);
+}
+
+// Copies the region out of the cache, generating it on a miss. The lock is
+// only held for the copies, so workers generate different regions in parallel.
+static void load_region(Floor* floor, int regionX, int regionY, uint16_t* tiles) {
+    if (!floor->cache) {
+        generate_region(floor, regionX, regionY, tiles);
+        return;
+    }
+    FloorRegion* slot = &floor->cache[(uint32_t)(regionY * floor->regionsX + regionX) % FLOOR_REGION_CACHE];
+#ifdef USE_THREADING
+    pthread_mutex_lock(&floor->cacheLock);
+#endif
+    bool hit = slot->valid && slot->regionX == regionX && slot->regionY == regionY;
+    if (hit) memcpy(tiles, slot->tiles, sizeof(slot->tiles));
+#ifdef USE_THREADING
+    pthread_mutex_unlock(&floor->cacheLock);
+#endif
+    if (hit) return;
+
+    generate_region(floor, regionX, regionY, tiles);
+#ifdef USE_THREADING
+    pthread_mutex_lock(&floor->cacheLock);
+#endif
+    slot->regionX = regionX;
+    slot->regionY = regionY;
+    slot->valid = true;
+    memcpy(slot->tiles, tiles, sizeof(slot->tiles));
+#ifdef USE_THREADING
+    pthread_mutex_unlock(&floor->cacheLock);
+#endif
+}
+
+bool FloorSystem_generate_chunk(void* userData, int chunkX, int chunkY, uint32_t seed, uint16_t* tiles) {
+    (void)seed;  // a chunk is made of whole or partial regions, each seeded from the floor's seed
+    Floor* floor = (Floor*)userData;
+    int x0 = chunkX * CHUNK_SIZE, y0 = chunkY * CHUNK_SIZE;
+    if (!floor || floor->width <= 0 || x0 >= floor->width || y0 >= floor->height ||
+        x0 + CHUNK_SIZE <= 0 || y0 + CHUNK_SIZE <= 0) return false;
+
+    int fromX = x0 < 0 ? 0 : x0;
+    int fromY = y0 < 0 ? 0 : y0;
+    int toX = x0 + CHUNK_SIZE < floor->width ? x0 + CHUNK_SIZE : floor->width;
+    int toY = y0 + CHUNK_SIZE < floor->height ? y0 + CHUNK_SIZE : floor->height;
+    uint16_t region[FLOOR_REGION_SIZE * FLOOR_REGION_SIZE];
+    for (int regionY = fromY / FLOOR_REGION_SIZE; regionY <= (toY - 1) / FLOOR_REGION_SIZE; regionY++) {
+        for (int regionX = fromX / FLOOR_REGION_SIZE; regionX <= (toX - 1) / FLOOR_REGION_SIZE; regionX++) {
+            load_region(floor, regionX, regionY, region);
+
+            // The part of the region inside the chunk
+            Room cell = region_rect(floor, regionX, regionY);
+            int left = cell.x > fromX ? cell.x : fromX;
+            int right = cell.x + cell.width < toX ? cell.x + cell.width : toX;
+            int top = cell.y > fromY ? cell.y : fromY;
+            int bottom = cell.y + cell.height < toY ? cell.y + cell.height : toY;
+            for (int y = top; y < bottom; y++) {
+                memcpy(&tiles[(y - y0) * CHUNK_SIZE + (left - x0)],
+                       &region[(y - cell.y) * FLOOR_REGION_SIZE + (left - cell.x)],
+                       sizeof(uint16_t) * (size_t)(right - left));
+            }
+        }
+    }
+    return true;
+}
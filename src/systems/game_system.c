@@ -7,13 +7,14 @@
 #include "ui_provider_raylib.h"
 #include "clay_renderer_raylib.h"
 
-Clay_Dimensions Raylib_MeasureText(Clay_StringSlice text, Clay_TextElementConfig *config, void *userData);
-
+// userData is GameState.uiGlyphs, indexed by fontId
 static UIDimensions raylib_measure_text_wrapper(void* text, void* config, void* userData) {
     Clay_StringSlice* textSlice = (Clay_StringSlice*)text;
     Clay_TextElementConfig* textConfig = (Clay_TextElementConfig*)config;
-    Clay_Dimensions result = Raylib_MeasureText(*textSlice, textConfig, userData);
-    return (UIDimensions){.width = result.width, .height = result.height};
+    const GlyphAdvanceTable* glyphs = (const GlyphAdvanceTable*)userData;
+    Vector2 size = GlyphAdvanceTable_measure(&glyphs[textConfig->fontId], textSlice->chars, textSlice->length,
+                                             (float)textConfig->fontSize, (float)textConfig->letterSpacing);
+    return (UIDimensions){.width = size.x, .height = size.y};
 }
 #include "systems/input_system.h"
 #include "systems/movement_system.h"
@@ -24,8 +25,14 @@ static UIDimensions raylib_measure_text_wrapper(void* text, void* config, void*
 #include "gramarye_event_bus/event_bus.h"
 #include "gramarye_renderer/renderer.h"
 #include "gramarye_chunk_controller/tile_update_queue.h"
-#include "gramarye_chunk_renderer/chunk_render_system.h"
 #include "gramarye_chunk_controller/chunk_manager_system.h"
+#include "gramarye_chunk_renderer/chunk_render_system.h"
+#include "systems/tile_update_system.h"
+#include "systems/map_render_system.h"
+#include "systems/sprite_render_system.h"
+#include "systems/chunk_stream_system.h"
+#include "systems/save_system.h"
+#include "systems/floor_system.h"
 #include "gramarye_clay_ui/popup.h"
 #include "camera.h"
 
@@ -35,7 +42,24 @@ static UIDimensions raylib_measure_text_wrapper(void* text, void* config, void*
 
 #include "textures/atlas.h"
 #include "textures/atlas_table.h"
-#include "tilemap/tilemap.h"
+#include "components/tile_storage.h"
+#include "renderer/baked_font.h"
+
+// Dungeon seed; every floor and region derives its own from it
+#define WORLD_SEED 0x6A09E667u
+// Chunks untouched this many frames are kept palette/RLE compressed
+#define WORLD_COMPRESS_AFTER_FRAMES 300
+// Cold chunks are paged out to region files here once tile memory passes the budget
+#define WORLD_PAGE_DIRECTORY "cache/world"
+#define WORLD_RESIDENT_BUDGET (16u * 1024u * 1024u)
+// Tile edits are journaled here and restored on the next start
+#define SAVE_DIRECTORY "saves/world"
+// Paged-out chunks are read back on this many worker threads (main thread without USE_THREADING)
+#define CHUNK_STREAM_WORKERS 2
+#define CHUNK_PREFETCH_DEPTH 3
+// UI font: the atlas CMake bakes into the build tree, and the TrueType it is baked from
+#define UI_FONT_BAKED "resources/font/Roboto-32.font"
+#define UI_FONT_TTF "resources/font/Roboto-VariableFont_wdth,wght.ttf"
 
 struct GameSystem {
     GameState state;
@@ -46,7 +70,9 @@ static void init_atlas(GameState* s) {
     s->atlasTable = AtlasTable_new();
     AtlasTable_add(&s->atlasTable, "ground", Atlas_new(400));
     s->atlas = AtlasTable_get(&s->atlasTable, "ground");
-    Atlas_setTexture(s->atlas, "resources/spritesheet-export.png");
+    // A headless renderer opens no window, so there is nothing to upload textures to;
+    // draws still reference the (empty) atlas texture
+    if (IsWindowReady()) Atlas_setTexture(s->atlas, "resources/spritesheet-export.png");
 
     for (int i = 0; i < 9; i++) {
         Rectangle rect = { (float)(i * 16), 0.0f, 16.0f, 16.0f };
@@ -54,25 +80,46 @@ static void init_atlas(GameState* s) {
     }
 }
 
-static void init_tilemap(GameState* s) {
-    s->tilemap = Tilemap_new(s->mapSize, s->mapSize, s->arena);
-
-    for (int y = 0; y < s->mapSize; y++) {
-        for (int x = 0; x < s->mapSize; x++) {
-            switch (x % 8) {
-                case 0:
-                case 1: Tilemap_set_tile(s->tilemap, x, y, 0); break;
-                case 2:
-                case 3: Tilemap_set_tile(s->tilemap, x, y, 1); break;
-                case 4:
-                case 5: Tilemap_set_tile(s->tilemap, x, y, 2); break;
-                case 6:
-                case 7: Tilemap_set_tile(s->tilemap, x, y, 3); break;
-            }
+// Brick walls, cobblestone rooms, dirt corridors, stone stairs
+static const FloorTiles dungeonTiles = { 5, 4, 3, 8, 7 };
+
+// The table holds the whole floor from the start, generated a chunk at a time
+static void fill_table(GameState* s) {
+    uint16_t tiles[CHUNK_AREA];
+    int chunks = (s->mapSize + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    for (int chunkY = 0; chunkY < chunks; chunkY++) {
+        for (int chunkX = 0; chunkX < chunks; chunkX++) {
+            for (int i = 0; i < CHUNK_AREA; i++) tiles[i] = TILE_NONE;
+            if (!FloorSystem_generate_chunk(&s->floor, chunkX, chunkY, 0, tiles)) continue;
+            TileStorage_blit(&s->map, chunkX * CHUNK_SIZE, chunkY * CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE, tiles, CHUNK_SIZE);
         }
     }
 }
 
+static void init_tilemap(GameState* s, TileStorageMode storageMode) {
+    // The first floor covers the mapSize x mapSize area, but only its stairs are placed
+    // here: the world generates the regions under each chunk as it comes into an
+    // observer's load radius, on the chunk stream workers
+    if (!FloorSystem_init_streamed(&s->floor, s->mapSize, s->mapSize, FloorSystem_floor_seed(WORLD_SEED, 0), &dungeonTiles)) {
+        TraceLog(LOG_WARNING, "init_tilemap: Out of memory for a %dx%d dungeon floor", s->mapSize, s->mapSize);
+    }
+
+    s->tiles = NULL;
+    if (storageMode == TILE_STORAGE_TABLE) {
+        if (TileStorage_init_table(&s->map, s->arena, s->mapSize, s->mapSize) && s->floor.cache) fill_table(s);
+        return;
+    }
+
+    if (!TileStorage_init_chunked(&s->map, s->arena)) return;
+    s->tiles = s->map.world;
+    World_set_generator(s->tiles, FloorSystem_generate_chunk, &s->floor, WORLD_SEED);
+
+    World_enable_compression(s->tiles, WORLD_COMPRESS_AFTER_FRAMES);
+    if (!World_enable_paging(s->tiles, WORLD_PAGE_DIRECTORY, WORLD_RESIDENT_BUDGET)) {
+        TraceLog(LOG_WARNING, "init_tilemap: Chunk paging disabled, cannot use %s", WORLD_PAGE_DIRECTORY);
+    }
+}
+
 static void init_entities(GameState* s) {
     s->ecs = ECS_new(s->arena);
     
@@ -83,11 +130,30 @@ static void init_entities(GameState* s) {
     EntityRegistry* entityRegistry = ECS_get_entity_registry(s->ecs);
     s->player = Entity_create(entityRegistry);
 
-    int startX = s->mapSize / 2;
-    int startY = s->mapSize / 2;
+    // Arrive on the floor's up stairs
+    int startX = s->floor.cache ? s->floor.upX : s->mapSize / 2;
+    int startY = s->floor.cache ? s->floor.upY : s->mapSize / 2;
     Position_add(s->ecs, s->player, s->positionTypeId, startX, startY);
     Health_add(s->ecs, s->player, s->healthTypeId, 100.0f);
     Sprite_add(s->ecs, s->player, s->spriteTypeId, s->atlas, 4);
+
+    SpatialIndex_init(&s->entities, 256);
+    s->playerHandle = SpatialIndex_insert(&s->entities, s->player, startX, startY);
+
+    SpriteRenderSystem_init(&s->sprites, s->ecs, &s->entities, s->spriteTypeId, s->tileSize);
+}
+
+// The atlas baked at build time (tools/font_baker.c) is mapped and uploaded;
+// the TTF is only rasterized when no baked atlas is found
+static Font load_ui_font(void) {
+    static const char* bakedPaths[] = { UI_FONT_BAKED, "../" UI_FONT_BAKED };
+    static const char* ttfPaths[] = { "../" UI_FONT_TTF, UI_FONT_TTF };
+    Font font = { 0 };
+    for (int i = 0; i < 2; i++) {
+        if (BakedFont_load(bakedPaths[i], &font, NULL)) return font;
+    }
+    for (int i = 0; i < 2 && !font.glyphs; i++) font = LoadFont(ttfPaths[i]);
+    return font;
 }
 
 static void init_camera(GameState* s, Vector2 logicalSize) {
@@ -102,48 +168,88 @@ static void init_camera(GameState* s, Vector2 logicalSize) {
     s->cam.pos.y = py - viewH * 0.5f;
 }
 
-GameSystem* GameSystem_create(Arena_T arena, int mapSize, int tileSize, Vector2 logicalSize, Renderer* renderer, InputProvider* inputProvider, UIProvider* uiProvider) {
+GameSystem* GameSystem_create(Arena_T arena, int mapSize, int tileSize, TileStorageMode storageMode, Vector2 logicalSize, Renderer* renderer, InputProvider* inputProvider, UIProvider* uiProvider) {
     GameSystem* g = (GameSystem*)Arena_alloc(arena, sizeof(GameSystem), __FILE__, __LINE__);
     g->state.arena = arena;
     g->state.mapSize = mapSize;
     g->state.tileSize = tileSize;
     g->state.renderer = renderer;
+    g->state.inputProvider = inputProvider;
     g->state.uiProvider = uiProvider;
     g->state.debug = false;
     g->state.hasLastClick = false;
     g->state.turnCount = 0;
     g->state.uiBlockingClick = false;
+    UIHitTest_clear(&g->state.uiHits);
+    g->state.uiCache = (UILayoutCache){ 0 };
 
     init_atlas(&g->state);
-    init_tilemap(&g->state);
+    init_tilemap(&g->state, storageMode);
+    // Before anything touches the world, so restored edits land first
+    g->state.save.open = false;
+    if (g->state.tiles && !SaveSystem_open(&g->state.save, g->state.tiles, SAVE_DIRECTORY)) {
+        TraceLog(LOG_WARNING, "GameSystem_create: Tile edits will not be saved to %s", SAVE_DIRECTORY);
+    }
     init_entities(&g->state);
 
     g->state.eventBus = EventBus_new(arena);
     
     TileUpdateQueue_init(&g->state.tileUpdateQueue);
+    // Bulk edits go through here in either mode, so both get the region event
+    TileUpdateSystem_init(&g->state.tileUpdates, &g->state.map, g->state.eventBus);
     
-    ChunkManagerSystem_init(&g->state.chunkManager,
-                            arena,
-                            g->state.tilemap,
-                            g->state.eventBus,
-                            64);
-    
-    ChunkRenderSystem_init(&g->state.chunkRenderer,
-                          g->state.arena,
-                          g->state.tilemap,
-                          g->state.atlas,
-                          g->state.renderer,
-                          g->state.tileSize,
-                          64,
-                          5,
-                          10);
-    
-    ChunkRenderSystem_add_entity_observer(&g->state.chunkRenderer,
-                                         g->state.ecs,
-                                         g->state.player,
-                                         g->state.positionTypeId);
+    if (g->state.map.mode == TILE_STORAGE_TABLE) {
+        ChunkManagerSystem_init(&g->state.chunkManager,
+                                arena,
+                                g->state.map.tilemap,
+                                g->state.eventBus,
+                                CHUNK_SIZE);
+        TileUpdateSystem_set_chunk_manager(&g->state.tileUpdates, &g->state.chunkManager);
+
+        ChunkRenderSystem_init(&g->state.chunkRenderer,
+                               g->state.arena,
+                               g->state.map.tilemap,
+                               g->state.atlas,
+                               g->state.renderer,
+                               g->state.tileSize,
+                               CHUNK_SIZE,
+                               5,
+                               10);
+
+        ChunkRenderSystem_add_entity_observer(&g->state.chunkRenderer,
+                                              g->state.ecs,
+                                              g->state.player,
+                                              g->state.positionTypeId);
+    } else {
+        if (g->state.save.open) TileUpdateSystem_set_journal(&g->state.tileUpdates, &g->state.save.journal);
+
+        MapRenderSystem_init(&g->state.mapRenderer,
+                             g->state.arena,
+                             g->state.tiles,
+                             g->state.atlas,
+                             g->state.tileSize,
+                             5,
+                             10);
+
+        MapRenderSystem_add_entity_observer(&g->state.mapRenderer,
+                                            g->state.ecs,
+                                            g->state.player,
+                                            g->state.positionTypeId);
+
+        // Same load radius as the map renderer, so prefetch covers the window it moves into next
+        ChunkStreamSystem_init(&g->state.chunkStream,
+                               g->state.tiles,
+                               CHUNK_STREAM_WORKERS,
+                               g->state.mapRenderer.loadRadius,
+                               CHUNK_PREFETCH_DEPTH);
+    }
     
     init_camera(&g->state, logicalSize);
+    RenderSystem_init(&g->state);
+    // Only a logical size below the window's (LOGICAL_SCALE > 1 in main.c) asks for
+    // the upscaled world target; a window resized later keeps drawing at full resolution
+    RenderVector2 windowSize = Renderer_get_window_size(renderer);
+    g->state.logicalTarget = logicalSize.x < windowSize.x || logicalSize.y < windowSize.y;
 
     g->state.popupState = (struct ClayUI_PopupState*)Arena_alloc(arena, sizeof(struct ClayUI_PopupState), __FILE__, __LINE__);
     ClayUI_PopupInit(g->state.popupState);
@@ -151,18 +257,26 @@ GameSystem* GameSystem_create(Arena_T arena, int mapSize, int tileSize, Vector2
 
     g->state.uiFontCount = 1;
     g->state.uiFonts = (Font*)Arena_alloc(arena, sizeof(Font) * g->state.uiFontCount, __FILE__, __LINE__);
-    g->state.uiFonts[0] = LoadFont("../resources/font/Roboto-VariableFont_wdth,wght.ttf");
-    if (!g->state.uiFonts[0].glyphs) {
-        g->state.uiFonts[0] = LoadFont("resources/font/Roboto-VariableFont_wdth,wght.ttf");
+    g->state.uiFonts[0] = (Font){ 0 };
+    // Headless runs have no UI provider and no window to load font atlases into
+    if (g->state.uiProvider && IsWindowReady()) {
+        g->state.uiFonts[0] = load_ui_font();
+        if (!g->state.uiFonts[0].glyphs) {
+            g->state.uiFonts[0] = GetFontDefault();
+            TraceLog(LOG_WARNING, "Failed to load Roboto font, using default font");
+        } else {
+            TraceLog(LOG_INFO, "Loaded Roboto font successfully");
+        }
     }
-    if (!g->state.uiFonts[0].glyphs) {
-        g->state.uiFonts[0] = GetFontDefault();
-        TraceLog(LOG_WARNING, "Failed to load Roboto font, using default font");
-    } else {
-        TraceLog(LOG_INFO, "Loaded Roboto font successfully");
+
+    g->state.uiGlyphs = (GlyphAdvanceTable*)Arena_alloc(arena, sizeof(GlyphAdvanceTable) * g->state.uiFontCount, __FILE__, __LINE__);
+    for (int i = 0; i < g->state.uiFontCount; i++) {
+        GlyphAdvanceTable_build(&g->state.uiGlyphs[i], g->state.uiFonts[i]);
     }
 
-    UIProvider_set_measure_text_function(g->state.uiProvider, raylib_measure_text_wrapper, g->state.uiFonts);
+    if (g->state.uiProvider) {
+        UIProvider_set_measure_text_function(g->state.uiProvider, raylib_measure_text_wrapper, g->state.uiGlyphs);
+    }
 
     g->input = InputSystem_create(arena, inputProvider);
 
@@ -180,7 +294,19 @@ void GameSystem_destroy(GameSystem* g) {
             }
         }
     }
-    ChunkRenderSystem_cleanup(&g->state.chunkRenderer);
+    RenderSystem_cleanup(&g->state);
+    SpriteRenderSystem_cleanup(&g->state.sprites);
+    SpatialIndex_free(&g->state.entities);
+    if (g->state.map.mode == TILE_STORAGE_TABLE) {
+        ChunkRenderSystem_cleanup(&g->state.chunkRenderer);
+    } else {
+        MapRenderSystem_cleanup(&g->state.mapRenderer);
+        ChunkStreamSystem_shutdown(&g->state.chunkStream);
+        SaveSystem_close(&g->state.save);
+    }
+    TileStorage_free(&g->state.map);
+    g->state.tiles = NULL;
+    FloorSystem_free(&g->state.floor);
     Atlas_free(g->state.atlas);
 }
 
@@ -193,8 +319,10 @@ void GameSystem_frame(GameSystem* g, float dt) {
     InputCommand deferredPlace[64];
     int deferredCount = 0;
 
+    g->state.frameInput = false;
     InputCommand cmd;
     while (InputSystem_pop(g->input, &cmd)) {
+        g->state.frameInput = true;
         switch (cmd.type) {
             case Cmd_ToggleDebug:
                 g->state.debug = !g->state.debug;
@@ -207,9 +335,9 @@ void GameSystem_frame(GameSystem* g, float dt) {
                 g->state.turnCount++;
                 break;
             case Cmd_PlaceTile: {
-                Vector2 mousePos = GetMousePosition();
-                bool mouseDown = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
-                bool uiBlocking = UISystem_check_ui_blocking(&g->state, mousePos, mouseDown);
+                // Position from the input provider, so scripted clicks land where they were aimed
+                Vector2 mousePos = cmd.as.place.mousePos;
+                bool uiBlocking = UISystem_check_ui_blocking(&g->state, mousePos);
                 if (!uiBlocking) {
                     if (deferredCount < 64) deferredPlace[deferredCount++] = cmd;
                 }
@@ -221,6 +349,7 @@ void GameSystem_frame(GameSystem* g, float dt) {
     }
 
     if (IsKeyPressed(KEY_P)) {
+        g->state.frameInput = true;
         if (ClayUI_PopupIsVisible(g->state.popupState)) {
             ClayUI_PopupHide(g->state.popupState);
         } else {
@@ -228,9 +357,19 @@ void GameSystem_frame(GameSystem* g, float dt) {
         }
     }
 
-    ChunkManagerSystem_process_updates(&g->state.chunkManager, &g->state.tileUpdateQueue);
-    
-    ChunkRenderSystem_update(&g->state.chunkRenderer, g->state.ecs, g->state.positionTypeId, &g->state.chunkManager);
+    if (g->state.map.mode == TILE_STORAGE_TABLE) {
+        ChunkManagerSystem_process_updates(&g->state.chunkManager, &g->state.tileUpdateQueue);
+        ChunkRenderSystem_update(&g->state.chunkRenderer, g->state.ecs, g->state.positionTypeId, &g->state.chunkManager);
+    } else {
+        TileUpdateSystem_process_updates(&g->state.tileUpdates, &g->state.tileUpdateQueue);
+        SaveSystem_update(&g->state.save);
+
+        ChunkStreamSystem_update(&g->state.chunkStream);
+        Position* playerPos = Position_get(g->state.ecs, g->state.player, g->state.positionTypeId);
+        if (playerPos) ChunkStreamSystem_prefetch(&g->state.chunkStream, playerPos->x, playerPos->y);
+        MapRenderSystem_update(&g->state.mapRenderer);
+        World_evict_cold(g->state.tiles);
+    }
     
     CameraSystem_follow_player(&g->state);
     AspectFit fit = CameraSystem_compute_fit(&g->state);
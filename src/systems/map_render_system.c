@@ -0,0 +1,426 @@
+#include "systems/map_render_system.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/position.h"
+#include "renderer/render_commands.h"
+
+static int chunk_distance(int ax, int ay, int bx, int by) {
+    int dx = ax > bx ? ax - bx : bx - ax;
+    int dy = ay > by ? ay - by : by - ay;
+    return dx > dy ? dx : dy;
+}
+
+static bool observer_chunk(const MapObserver* o, int* outChunkX, int* outChunkY) {
+    Position* p = Position_get(o->ecs, o->entity, o->positionTypeId);
+    if (!p) return false;
+    *outChunkX = Chunk_coord(p->x);
+    *outChunkY = Chunk_coord(p->y);
+    return true;
+}
+
+static int nearest_observer_distance(const MapRenderSystem* sys, int chunkX, int chunkY) {
+    int best = -1;
+    for (int i = 0; i < sys->observerCount; i++) {
+        int ocx, ocy;
+        if (!observer_chunk(&sys->observers[i], &ocx, &ocy)) continue;
+        int d = chunk_distance(chunkX, chunkY, ocx, ocy);
+        if (best < 0 || d < best) best = d;
+    }
+    return best;
+}
+
+static void load_view(MapRenderSystem* sys, int chunkX, int chunkY) {
+    if (sys->viewCount >= sys->viewCapacity || ChunkMap_get(&sys->viewLookup, chunkX, chunkY)) return;
+
+    int slot = RenderTexturePool_acquire(&sys->texturePool);
+    if (slot < 0) return;
+
+    MapChunkView* view = &sys->views[sys->viewCount];
+    view->chunkX = chunkX;
+    view->chunkY = chunkY;
+    view->slot = slot;
+    view->renderedRevision = 0;
+    view->rendered = false;
+    ChunkMap_put(&sys->viewLookup, chunkX, chunkY, view);
+    sys->viewCount++;
+}
+
+static void unload_view(MapRenderSystem* sys, int index) {
+    MapChunkView* view = &sys->views[index];
+    RenderTexturePool_release(&sys->texturePool, view->slot);
+    ChunkMap_remove(&sys->viewLookup, view->chunkX, view->chunkY);
+    if (view->rendered) sys->imageRevision++;
+
+    int last = sys->viewCount - 1;
+    if (index != last) {
+        sys->views[index] = sys->views[last];
+        MapChunkView* moved = &sys->views[index];
+        ChunkMap_put(&sys->viewLookup, moved->chunkX, moved->chunkY, moved);
+    }
+    sys->viewCount--;
+}
+
+// Clears and redraws a local tile rectangle of the chunk into its slot
+static void draw_tiles(MapRenderSystem* sys, const MapChunkView* view, const Chunk* chunk,
+                       int lx0, int ly0, int width, int height) {
+    float ts = (float)sys->tileSize;
+    Rectangle slot = RenderTexturePool_slot_rect(&sys->texturePool, view->slot);
+    RenderTexturePool_clear_slot_rect(&sys->texturePool, view->slot,
+                                      (Rectangle){ lx0 * ts, ly0 * ts, width * ts, height * ts });
+    const uint16_t* row = &chunk->tiles[Chunk_index(lx0, ly0)];
+    for (int ly = ly0; ly < ly0 + height; ly++, row += CHUNK_SIZE) {
+        for (int i = 0; i < width; i++) {
+            uint16_t id = row[i];
+            if (id >= sys->tileRectCount) continue;  // also skips TILE_NONE
+            DrawTextureRec(sys->atlas->texture, sys->tileRects[id],
+                           (Vector2){ slot.x + (lx0 + i) * ts, slot.y + ly * ts }, WHITE);
+        }
+    }
+    sys->tilesRedrawn += (long)width * height;
+}
+
+// A view drawn at the chunk's dirtyRevision only redraws the dirty blocks,
+// a run of adjacent dirty blocks in a block row at a time
+static void render_view(MapRenderSystem* sys, MapChunkView* view, Chunk* chunk) {
+    bool partial = view->rendered && view->renderedRevision == chunk->dirtyRevision;
+    if (sys->drawTextures) {
+        RenderTexturePool_begin_slot(&sys->texturePool, view->slot);
+        if (!partial) {
+            draw_tiles(sys, view, chunk, 0, 0, CHUNK_SIZE, CHUNK_SIZE);
+        } else {
+            for (int by = 0; by < CHUNK_DIRTY_BLOCKS; by++) {
+                unsigned bits = (unsigned)(chunk->dirtyBlocks >> (by * CHUNK_DIRTY_BLOCKS)) & 0xFFu;
+                for (int bx = 0; bits; ) {
+                    if (!(bits & 1u)) { bits >>= 1; bx++; continue; }
+                    int run = 0;
+                    while (bits & 1u) { bits >>= 1; run++; }
+                    draw_tiles(sys, view, chunk, bx * CHUNK_DIRTY_BLOCK, by * CHUNK_DIRTY_BLOCK,
+                               run * CHUNK_DIRTY_BLOCK, CHUNK_DIRTY_BLOCK);
+                    bx += run;
+                }
+            }
+        }
+        RenderTexturePool_end_slot(&sys->texturePool);
+    }
+
+    Chunk_clear_dirty(chunk);
+    view->renderedRevision = chunk->revision;
+    view->rendered = true;
+    sys->imageRevision++;
+}
+
+static ChunkMap* lod_lookup(MapRenderSystem* sys, int level) {
+    return &sys->lodLookup[level - 1];
+}
+
+static void release_lod(MapRenderSystem* sys, int index) {
+    MapLodView* lod = &sys->lodViews[index];
+    RenderTexturePool_release(&sys->lodPool, lod->slot);
+    ChunkMap_remove(lod_lookup(sys, lod->level), lod->superX, lod->superY);
+
+    int last = sys->lodViewCount - 1;
+    if (index != last) {
+        sys->lodViews[index] = sys->lodViews[last];
+        MapLodView* moved = &sys->lodViews[index];
+        ChunkMap_put(lod_lookup(sys, moved->level), moved->superX, moved->superY, moved);
+    }
+    sys->lodViewCount--;
+}
+
+static bool has_child_views(const MapRenderSystem* sys, int level, int superX, int superY) {
+    int n = 1 << level;
+    for (int dy = 0; dy < n; dy++) {
+        for (int dx = 0; dx < n; dx++) {
+            if (ChunkMap_get(&sys->viewLookup, superX * n + dx, superY * n + dy)) return true;
+        }
+    }
+    return false;
+}
+
+static MapLodView* acquire_lod(MapRenderSystem* sys, int level, int superX, int superY) {
+    MapLodView* lod = (MapLodView*)ChunkMap_get(lod_lookup(sys, level), superX, superY);
+    if (lod) return lod;
+    if (sys->lodViewCount >= sys->lodViewCapacity || !has_child_views(sys, level, superX, superY)) return NULL;
+
+    int slot = RenderTexturePool_acquire(&sys->lodPool);
+    if (slot < 0) return NULL;
+    lod = &sys->lodViews[sys->lodViewCount++];
+    memset(lod, 0, sizeof(MapLodView));
+    lod->level = level;
+    lod->superX = superX;
+    lod->superY = superY;
+    lod->slot = slot;
+    ChunkMap_put(lod_lookup(sys, level), superX, superY, lod);
+    return lod;
+}
+
+// Redraws the super-chunk when the set of drawn children or any child's revision changed
+static void refresh_lod(MapRenderSystem* sys, MapLodView* lod) {
+    int n = 1 << lod->level;
+    const MapChunkView* children[MAP_RENDER_LOD_MAX_CHILDREN];
+    uint32_t mask = 0;
+    bool stale = !lod->rendered;
+    for (int i = 0; i < n * n; i++) {
+        const MapChunkView* child = (const MapChunkView*)ChunkMap_get(&sys->viewLookup, lod->superX * n + i % n,
+                                                                      lod->superY * n + i / n);
+        children[i] = child && child->rendered ? child : NULL;
+        if (!children[i]) continue;
+        mask |= 1u << i;
+        if (lod->childRevisions[i] != child->renderedRevision) stale = true;
+    }
+    if (!stale && mask == lod->childMask) return;
+
+    if (sys->drawTextures) {
+        Rectangle slot = RenderTexturePool_slot_rect(&sys->lodPool, lod->slot);
+        float childSize = slot.width / n;
+        RenderTexturePool_begin_slot(&sys->lodPool, lod->slot);
+        RenderTexturePool_clear_slot_rect(&sys->lodPool, lod->slot, (Rectangle){ 0.0f, 0.0f, slot.width, slot.height });
+        for (int i = 0; i < n * n; i++) {
+            if (!children[i]) continue;
+            RenderTexture2D* page = RenderTexturePool_page(&sys->texturePool, children[i]->slot);
+            Rectangle src = RenderTexturePool_slot_source(&sys->texturePool, children[i]->slot);
+            Rectangle dst = { slot.x + (i % n) * childSize, slot.y + (i / n) * childSize, childSize, childSize };
+            DrawTexturePro(page->texture, src, dst, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+        }
+        RenderTexturePool_end_slot(&sys->lodPool);
+    }
+
+    for (int i = 0; i < n * n; i++) {
+        lod->childRevisions[i] = children[i] ? children[i]->renderedRevision : 0;
+    }
+    lod->childMask = mask;
+    lod->rendered = true;
+}
+
+// Visible first, then never drawn before stale, then nearest the view centre
+// (or the nearest observer before anything was rendered), in chunks squared
+static float rebuild_priority(const MapRenderSystem* sys, const MapChunkView* view) {
+    float priority = view->rendered ? 1e6f : 0.0f;
+    if (!sys->hasLastView) {
+        int d = nearest_observer_distance(sys, view->chunkX, view->chunkY);
+        return priority + 2e6f + (d < 0 ? 1e5f : (float)(d * d));
+    }
+
+    float chunkPixels = (float)(CHUNK_SIZE * sys->tileSize);
+    const Rectangle* v = &sys->lastView;
+    float wx = view->chunkX * chunkPixels;
+    float wy = view->chunkY * chunkPixels;
+    bool visible = wx + chunkPixels >= v->x && wx <= v->x + v->width &&
+                   wy + chunkPixels >= v->y && wy <= v->y + v->height;
+    float dx = (wx + chunkPixels * 0.5f - (v->x + v->width * 0.5f)) / chunkPixels;
+    float dy = (wy + chunkPixels * 0.5f - (v->y + v->height * 0.5f)) / chunkPixels;
+    return priority + (visible ? 0.0f : 2e6f) + dx * dx + dy * dy;
+}
+
+static int compare_rebuild(const void* a, const void* b) {
+    const MapRebuildEntry* ea = (const MapRebuildEntry*)a;
+    const MapRebuildEntry* eb = (const MapRebuildEntry*)b;
+    if (ea->priority != eb->priority) return ea->priority < eb->priority ? -1 : 1;
+    return ea->view - eb->view;
+}
+
+static void rebuild_stale_views(MapRenderSystem* sys) {
+    int queued = 0;
+    for (int i = 0; i < sys->viewCount; i++) {
+        MapChunkView* view = &sys->views[i];
+        // Only a redraw uses the chunk; checking its revision must not keep it from aging out
+        const Chunk* chunk = World_find_chunk(sys->world, view->chunkX, view->chunkY);
+        if (!chunk || (view->rendered && view->renderedRevision == chunk->revision)) continue;
+        sys->rebuildQueue[queued++] = (MapRebuildEntry){ i, rebuild_priority(sys, view) };
+    }
+    qsort(sys->rebuildQueue, queued, sizeof(MapRebuildEntry), compare_rebuild);
+
+    double start = GetTime();
+    int rebuilt = 0;
+    for (; rebuilt < queued; rebuilt++) {
+        if (rebuilt > 0 && sys->rebuildBudgetMs > 0.0 && (GetTime() - start) * 1000.0 >= sys->rebuildBudgetMs) break;
+        MapChunkView* view = &sys->views[sys->rebuildQueue[rebuilt].view];
+        // Peeked again: an earlier redraw may have paged chunks in or out
+        Chunk* chunk = World_peek_chunk(sys->world, view->chunkX, view->chunkY);
+        if (chunk) render_view(sys, view, chunk);
+    }
+
+    sys->rebuild.queued = queued;
+    sys->rebuild.rebuilt = rebuilt;
+    sys->rebuild.deferred = queued - rebuilt;
+    sys->rebuild.deferredTotal += queued - rebuilt;
+    sys->rebuild.milliseconds = (GetTime() - start) * 1000.0;
+}
+
+void MapRenderSystem_init(MapRenderSystem* sys, Arena_T arena, World* world, Atlas* atlas,
+                          int tileSize, int loadRadius, int unloadRadius) {
+    if (!sys) return;
+    sys->world = world;
+    sys->atlas = atlas;
+    sys->tileSize = tileSize;
+    sys->loadRadius = loadRadius;
+    sys->unloadRadius = unloadRadius > loadRadius ? unloadRadius : loadRadius;
+    sys->observerCount = 0;
+    sys->tilesRedrawn = 0;
+    sys->imageRevision = 0;
+    // Without a window (headless renderer) there is no GPU to draw chunk textures on
+    sys->drawTextures = IsWindowReady();
+
+    sys->tileRectCount = atlas ? atlas->rectCount : 0;
+    sys->tileRects = (Rectangle*)Arena_alloc(arena, sizeof(Rectangle) * (sys->tileRectCount > 0 ? sys->tileRectCount : 1), __FILE__, __LINE__);
+    for (int i = 0; i < sys->tileRectCount; i++) {
+        sys->tileRects[i] = Atlas_getRect(atlas, i);
+    }
+
+    // Views never outnumber the chunks within unloadRadius of every observer
+    int span = 2 * sys->unloadRadius + 1;
+    sys->viewCapacity = span * span * MAP_RENDER_MAX_OBSERVERS;
+    sys->views = (MapChunkView*)Arena_alloc(arena, sizeof(MapChunkView) * sys->viewCapacity, __FILE__, __LINE__);
+    sys->viewCount = 0;
+    ChunkMap_init(&sys->viewLookup, span * span);
+
+    // Enough slots for a full load window up front; pages added past that are kept
+    int loadSpan = 2 * sys->loadRadius + 1;
+    RenderTexturePool_init(&sys->texturePool, CHUNK_SIZE * tileSize, MAP_RENDER_PAGE_SIZE, sys->drawTextures);
+    RenderTexturePool_reserve(&sys->texturePool, loadSpan * loadSpan);
+
+    // Super-chunks never outnumber the views they are built from
+    RenderTexturePool_init(&sys->lodPool, CHUNK_SIZE * tileSize, MAP_RENDER_PAGE_SIZE, sys->drawTextures);
+    sys->lodViewCapacity = sys->viewCapacity;
+    sys->lodViews = (MapLodView*)Arena_alloc(arena, sizeof(MapLodView) * sys->lodViewCapacity, __FILE__, __LINE__);
+    sys->lodViewCount = 0;
+    for (int level = 1; level < MAP_RENDER_LOD_LEVELS; level++) {
+        ChunkMap_init(lod_lookup(sys, level), span * span);
+    }
+    sys->lodLevel = 0;
+
+    sys->rebuildBudgetMs = MAP_RENDER_REBUILD_BUDGET_MS;
+    sys->rebuildQueue = (MapRebuildEntry*)Arena_alloc(arena, sizeof(MapRebuildEntry) * sys->viewCapacity, __FILE__, __LINE__);
+    memset(&sys->rebuild, 0, sizeof(sys->rebuild));
+    sys->hasLastView = false;
+}
+
+void MapRenderSystem_cleanup(MapRenderSystem* sys) {
+    if (!sys) return;
+    while (sys->viewCount > 0) {
+        unload_view(sys, sys->viewCount - 1);
+    }
+    while (sys->lodViewCount > 0) {
+        release_lod(sys, sys->lodViewCount - 1);
+    }
+    for (int level = 1; level < MAP_RENDER_LOD_LEVELS; level++) {
+        ChunkMap_free(lod_lookup(sys, level));
+    }
+    ChunkMap_free(&sys->viewLookup);
+    RenderTexturePool_free(&sys->texturePool);
+    RenderTexturePool_free(&sys->lodPool);
+}
+
+bool MapRenderSystem_add_entity_observer(MapRenderSystem* sys, ECS* ecs, EntityId entity, ComponentTypeId positionTypeId) {
+    if (!sys || sys->observerCount >= MAP_RENDER_MAX_OBSERVERS) return false;
+    sys->observers[sys->observerCount++] = (MapObserver){ ecs, entity, positionTypeId };
+    return true;
+}
+
+void MapRenderSystem_update(MapRenderSystem* sys) {
+    if (!sys || !sys->world) return;
+
+    for (int i = sys->viewCount - 1; i >= 0; i--) {
+        int d = nearest_observer_distance(sys, sys->views[i].chunkX, sys->views[i].chunkY);
+        if (d < 0 || d > sys->unloadRadius) unload_view(sys, i);
+    }
+
+    for (int i = 0; i < sys->observerCount; i++) {
+        int ocx, ocy;
+        if (!observer_chunk(&sys->observers[i], &ocx, &ocy)) continue;
+        for (int cy = ocy - sys->loadRadius; cy <= ocy + sys->loadRadius; cy++) {
+            for (int cx = ocx - sys->loadRadius; cx <= ocx + sys->loadRadius; cx++) {
+                // Entering the load radius generates new chunks; paged-out ones come back
+                // through the world's loader and their views appear once they do
+                if (World_request_chunk(sys->world, cx, cy)) load_view(sys, cx, cy);
+            }
+        }
+    }
+
+    rebuild_stale_views(sys);
+
+    // Super-chunks of a level no longer drawn, or with every child unloaded, give their slot back
+    for (int i = sys->lodViewCount - 1; i >= 0; i--) {
+        const MapLodView* lod = &sys->lodViews[i];
+        if (lod->level != sys->lodLevel || !has_child_views(sys, lod->level, lod->superX, lod->superY)) {
+            release_lod(sys, i);
+        }
+    }
+}
+
+int MapRenderSystem_lod_level(float zoom) {
+    int level = 0;
+    while (level + 1 < MAP_RENDER_LOD_LEVELS && zoom * (float)(1 << (level + 1)) <= 1.0f) level++;
+    return level;
+}
+
+static void queue_image(RenderLayer* layer, const RenderTexturePool* pool, int slot, Vector2 screenPos, float screenSize) {
+    RenderTexture2D* page = RenderTexturePool_page(pool, slot);
+    Rectangle src = RenderTexturePool_slot_source(pool, slot);
+    RenderCommand cmd = RenderCommand_texture((void*)&page->texture,
+                                              (RenderRect){ src.x, src.y, src.width, src.height },
+                                              (RenderRect){ screenPos.x, screenPos.y, screenSize, screenSize },
+                                              (RenderColor){ 255, 255, 255, 255 });
+    RenderLayer_add_command(layer, &cmd);
+}
+
+static void render_lod(MapRenderSystem* sys, RenderLayer* layer, const Camera2DEx* cam, AspectFit fit, int level) {
+    float superPixels = (float)(CHUNK_SIZE * sys->tileSize) * (float)(1 << level);
+    float viewW = cam->logicalSize.x / cam->zoom;
+    float viewH = cam->logicalSize.y / cam->zoom;
+    float screenSize = superPixels * fit.scale * cam->zoom;
+    int sx0 = (int)floorf(cam->pos.x / superPixels), sx1 = (int)floorf((cam->pos.x + viewW) / superPixels);
+    int sy0 = (int)floorf(cam->pos.y / superPixels), sy1 = (int)floorf((cam->pos.y + viewH) / superPixels);
+
+    for (int sy = sy0; sy <= sy1; sy++) {
+        for (int sx = sx0; sx <= sx1; sx++) {
+            MapLodView* lod = acquire_lod(sys, level, sx, sy);
+            if (!lod) continue;
+            refresh_lod(sys, lod);
+            if (!lod->childMask) continue;
+            Vector2 screenPos = Camera_WorldToScreen(cam, fit, (Vector2){ sx * superPixels, sy * superPixels });
+            queue_image(layer, &sys->lodPool, lod->slot, screenPos, screenSize);
+        }
+    }
+}
+
+void MapRenderSystem_render(MapRenderSystem* sys, RenderLayer* layer, const Camera2DEx* cam, AspectFit fit) {
+    if (!sys || !layer || !cam) return;
+
+    sys->lastView = (Rectangle){ cam->pos.x, cam->pos.y, cam->logicalSize.x / cam->zoom, cam->logicalSize.y / cam->zoom };
+    sys->hasLastView = true;
+    sys->lodLevel = MapRenderSystem_lod_level(cam->zoom);
+    if (sys->lodLevel > 0) {
+        render_lod(sys, layer, cam, fit, sys->lodLevel);
+        return;
+    }
+
+    float chunkPixels = (float)(CHUNK_SIZE * sys->tileSize);
+    float viewW = cam->logicalSize.x / cam->zoom;
+    float viewH = cam->logicalSize.y / cam->zoom;
+    float screenSize = chunkPixels * fit.scale * cam->zoom;
+
+    for (int i = 0; i < sys->viewCount; i++) {
+        const MapChunkView* view = &sys->views[i];
+        if (!view->rendered) continue;
+
+        float wx = view->chunkX * chunkPixels;
+        float wy = view->chunkY * chunkPixels;
+        if (wx + chunkPixels < cam->pos.x || wx > cam->pos.x + viewW) continue;
+        if (wy + chunkPixels < cam->pos.y || wy > cam->pos.y + viewH) continue;
+
+        Vector2 screenPos = Camera_WorldToScreen(cam, fit, (Vector2){ wx, wy });
+        queue_image(layer, &sys->texturePool, view->slot, screenPos, screenSize);
+    }
+}
+
+bool MapRenderSystem_screen_to_tile(const MapRenderSystem* sys, const Camera2DEx* cam, AspectFit fit,
+                                    Vector2 screenPos, int* outTileX, int* outTileY) {
+    if (!sys || !cam || sys->tileSize <= 0 || fit.scale <= 0.0f) return false;
+    Vector2 world = Camera_ScreenToWorld(cam, fit, screenPos);
+    if (outTileX) *outTileX = (int)floorf(world.x / (float)sys->tileSize);
+    if (outTileY) *outTileY = (int)floorf(world.y / (float)sys->tileSize);
+    return true;
+}
@@ -2,7 +2,7 @@
 
 #include "core/position.h"
 
-#include "tilemap/tilemap.h"
+#include "components/tile_storage.h"
 
 static bool is_tile_walkable(uint16_t tile_id) {
     (void)tile_id;
@@ -16,11 +16,11 @@ void MovementSystem_apply_move(GameState* state, int dx, int dy) {
 
     int newX = p->x + dx;
     int newY = p->y + dy;
-    if (newX < 0 || newX >= state->mapSize || newY < 0 || newY >= state->mapSize) return;
 
-    Tile* targetTile = Tilemap_get_tile(state->tilemap, newX, newY);
-    if (targetTile && is_tile_walkable(targetTile->tile_id)) {
-        Position_set(state->ecs, state->player, state->positionTypeId, newX, newY);
+    // Cells with no tile stop movement: off the table, or nowhere in the world
+    uint16_t targetTile = TileStorage_get_tile(&state->map, newX, newY);
+    if (targetTile != TILE_NONE && is_tile_walkable(targetTile)) {
+        SpatialIndex_set_position(&state->entities, state->playerHandle, state->ecs, state->positionTypeId, newX, newY);
     }
 }
 
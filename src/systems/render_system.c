@@ -1,31 +1,19 @@
 #include "systems/render_system.h"
 
+#include <string.h>
+
 #include "raylib.h"
+#include "systems/map_render_system.h"
 #include "gramarye_chunk_renderer/chunk_render_system.h"
 #include "gramarye_renderer/renderer.h"
+#include "gramarye_renderer/input_provider.h"
 #include "gramarye_ui/ui_provider.h"
+#include "gramarye_clay_ui/popup.h"
+#include "renderer/render_commands.h"
 
-#include "core/position.h"
-#include "textures/sprite.h"
-
-#include "textures/atlas.h"
+#include "systems/sprite_render_system.h"
 #include "systems/ui_system.h"
 
-static void render_player(GameState* state, AspectFit fit) {
-    Position* p = Position_get(state->ecs, state->player, state->positionTypeId);
-    Sprite* s = Sprite_get(state->ecs, state->player, state->spriteTypeId);
-    if (!p || !s) return;
-
-    float worldToScreenScale = fit.scale * state->cam.zoom;
-    Vector2 screenPos = Camera_WorldToScreen(&state->cam, fit, (Vector2){
-        (float)(p->x * state->tileSize),
-        (float)(p->y * state->tileSize)
-    });
-    Rectangle src = Atlas_getRect(s->atlas, s->tile_id);
-    Rectangle dst = { screenPos.x, screenPos.y, state->tileSize * worldToScreenScale, state->tileSize * worldToScreenScale };
-    DrawTexturePro(s->atlas->texture, src, dst, (Vector2){0,0}, 0.0f, WHITE);
-}
-
 static void render_debug_last_click(GameState* state, AspectFit fit) {
     if (!state->debug || !state->hasLastClick) return;
     float worldToScreenScale = fit.scale * state->cam.zoom;
@@ -33,19 +21,200 @@ static void render_debug_last_click(GameState* state, AspectFit fit) {
         (float)(state->lastClickTileX * state->tileSize),
         (float)(state->lastClickTileY * state->tileSize)
     });
-    Rectangle r = { tl.x, tl.y, state->tileSize * worldToScreenScale, state->tileSize * worldToScreenScale };
-    DrawRectangleLinesEx(r, 2.0f, RED);
+    float size = state->tileSize * worldToScreenScale;
+    RenderCommand cmd = RenderCommand_rectangle_lines((RenderRect){ tl.x, tl.y, size, size }, 2.0f,
+                                                      (RenderColor){ 230, 41, 55, 255 });
+    RenderLayer_add_command(state->layers[RENDER_LAYER_OVERLAY], &cmd);
+}
+
+static void render_debug_world_stats(GameState* state, int renderHeight) {
+    if (!state->debug || !state->tiles) return;
+    const WorldMemoryStats* m = &state->tiles->stats;
+    const MapRebuildStats* r = &state->mapRenderer.rebuild;
+    const char* text = TextFormat("chunks raw %d (%ld KiB)  packed %d (%ld KiB)  paged in/out %ld/%ld  redraw %d/%d (%.1f ms)",
+                                  m->residentChunks, m->residentBytes / 1024,
+                                  m->compressedChunks, m->compressedBytes / 1024,
+                                  m->pageIns, m->pageOuts,
+                                  r->rebuilt, r->queued, r->milliseconds);
+    RenderCommand cmd = RenderCommand_text(text, 10.0f, (float)(renderHeight - 30), 20.0f,
+                                           (RenderColor){ 245, 245, 245, 255 });
+    RenderLayer_add_command(state->layers[RENDER_LAYER_OVERLAY], &cmd);
+}
+
+// Pointer state comes from the game's input provider, like every other input
+typedef struct PointerState {
+    Vector2 pos;
+    bool down;
+    bool pressed;
+} PointerState;
+
+static PointerState read_pointer(const GameState* state) {
+    PointerState p = { { 0.0f, 0.0f }, false, false };
+    if (!state->inputProvider) return p;
+    RenderVector2 pos = InputProvider_get_mouse_position(state->inputProvider);
+    p.pos = (Vector2){ pos.x, pos.y };
+    p.down = InputProvider_is_mouse_button_down(state->inputProvider, INPUT_MOUSE_BUTTON_LEFT);
+    p.pressed = InputProvider_is_mouse_button_pressed(state->inputProvider, INPUT_MOUSE_BUTTON_LEFT);
+    return p;
+}
+
+static FrameSignature capture_frame(const GameState* state, AspectFit fit, int renderWidth, int renderHeight) {
+    FrameSignature f;
+    memset(&f, 0, sizeof(f));
+    f.camPos = state->cam.pos;
+    f.camZoom = state->cam.zoom;
+    f.fit = fit;
+    f.renderWidth = renderWidth;
+    f.renderHeight = renderHeight;
+    f.entityRevision = state->entities.revision;
+    f.mapRevision = state->map.mode == TILE_STORAGE_CHUNKED ? state->mapRenderer.imageRevision : 0;
+    f.turnCount = state->turnCount;
+    BarValue* health = Health_get(state->ecs, state->player, state->healthTypeId);
+    if (health) {
+        f.health = health->value;
+        f.maxHealth = health->maxValue;
+    }
+    PointerState pointer = read_pointer(state);
+    f.mousePos = pointer.pos;
+    f.mouseDown = pointer.down;
+    f.popupVisible = state->popupState && ClayUI_PopupIsVisible(state->popupState);
+    return f;
+}
+
+static bool same_frame(const FrameSignature* a, const FrameSignature* b) {
+    return a->camPos.x == b->camPos.x && a->camPos.y == b->camPos.y && a->camZoom == b->camZoom &&
+           a->fit.dest.x == b->fit.dest.x && a->fit.dest.y == b->fit.dest.y &&
+           a->fit.dest.width == b->fit.dest.width && a->fit.dest.height == b->fit.dest.height &&
+           a->fit.scale == b->fit.scale &&
+           a->renderWidth == b->renderWidth && a->renderHeight == b->renderHeight &&
+           a->entityRevision == b->entityRevision && a->mapRevision == b->mapRevision &&
+           a->turnCount == b->turnCount && a->health == b->health && a->maxHealth == b->maxHealth &&
+           a->mousePos.x == b->mousePos.x && a->mousePos.y == b->mousePos.y &&
+           a->mouseDown == b->mouseDown && a->popupVisible == b->popupVisible;
+}
+
+// Table storage: the chunk renderer draws straight into the current target,
+// under the pipeline's layers
+static void render_table_map(GameState* state, AspectFit fit) {
+    if (state->map.mode != TILE_STORAGE_TABLE) return;
+    ChunkRenderSystem_render(&state->chunkRenderer, state->ecs, state->positionTypeId,
+                             (CameraHandle)&state->cam, (AspectFitHandle)&fit);
+}
+
+// Render textures are stored bottom-up, so the source is flipped
+static void present_frame(const GameState* state, int renderWidth, int renderHeight) {
+    const Texture2D* texture = &state->screen.renderFrame.texture;
+    DrawTexturePro(*texture, (Rectangle){ 0.0f, 0.0f, (float)texture->width, -(float)texture->height },
+                   (Rectangle){ 0.0f, 0.0f, (float)renderWidth, (float)renderHeight },
+                   (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+}
+
+static bool ensure_target(RenderTexture2D* target, int width, int height) {
+    if (target->id != 0 && target->texture.width == width && target->texture.height == height) return true;
+    if (target->id != 0) UnloadRenderTexture(*target);
+    *target = LoadRenderTexture(width, height);
+    return target->id != 0;
+}
+
+static bool ensure_frame_texture(GameState* state, int renderWidth, int renderHeight) {
+    RenderTexture2D* frame = &state->screen.renderFrame;
+    if (frame->id != 0 && frame->texture.width == renderWidth && frame->texture.height == renderHeight) return true;
+    state->frameCached = false;
+    return ensure_target(frame, renderWidth, renderHeight);
+}
+
+// The world target only saves work when the fit scales logical pixels up
+static bool use_world_target(GameState* state, AspectFit fit) {
+    if (!state->logicalTarget || !IsWindowReady() || fit.scale <= 1.0f) return false;
+    int width = (int)(state->cam.logicalSize.x + 0.5f);
+    int height = (int)(state->cam.logicalSize.y + 0.5f);
+    if (width <= 0 || height <= 0) return false;
+    return ensure_target(&state->screen.worldFrame, width, height);
+}
+
+// One letterboxed, point-filtered blit of the world target into fit.dest
+static void upscale_world(const GameState* state, AspectFit fit) {
+    const Texture2D* texture = &state->screen.worldFrame.texture;
+    DrawTexturePro(*texture, (Rectangle){ 0.0f, 0.0f, (float)texture->width, -(float)texture->height },
+                   fit.dest, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+}
+
+void RenderSystem_init(GameState* state) {
+    if (!state) return;
+    state->pipeline = RenderPipeline_create(state->arena);
+    for (int i = 0; i < RENDER_LAYER_COUNT; i++) {
+        state->layers[i] = RenderLayer_create(state->arena, i);
+        RenderPipeline_add_layer(state->pipeline, state->layers[i]);
+    }
+
+    state->screen = (ScreenBuffer){ 0 };
+    state->logicalTarget = false;  // GameSystem_create turns it on for LOGICAL_SCALE > 1
+    // The table renderer reports no image revision to tell a changed map by
+    state->frameCacheEnabled = IsWindowReady() && state->map.mode == TILE_STORAGE_CHUNKED;
+    state->frameCached = false;
+    state->frameInput = false;
+    state->framesReused = 0;
+}
+
+void RenderSystem_cleanup(GameState* state) {
+    if (!state) return;
+    if (state->screen.renderFrame.id != 0) UnloadRenderTexture(state->screen.renderFrame);
+    if (state->screen.worldFrame.id != 0) UnloadRenderTexture(state->screen.worldFrame);
+    state->screen = (ScreenBuffer){ 0 };
+    state->frameCached = false;
 }
 
 void RenderSystem_render(GameState* state, AspectFit fit) {
     if (!state) return;
-    ChunkRenderSystem_render(&state->chunkRenderer, state->ecs, state->positionTypeId, 
-                            (CameraHandle)&state->cam, (AspectFitHandle)&fit);
-    render_debug_last_click(state, fit);
-    render_player(state, fit);
-    
     int renderWidth = Renderer_get_render_width(state->renderer);
     int renderHeight = Renderer_get_render_height(state->renderer);
+
+    // Nothing the image depends on changed: show the last one again and skip
+    // the pipeline and UI layout. The debug overlay shows live counters, so
+    // it always redraws.
+    FrameSignature frame = capture_frame(state, fit, renderWidth, renderHeight);
+    bool cache = state->frameCacheEnabled && !state->debug && ensure_frame_texture(state, renderWidth, renderHeight);
+    if (cache && state->frameCached && !state->frameInput && same_frame(&frame, &state->lastFrame)) {
+        present_frame(state, renderWidth, renderHeight);
+        state->framesReused++;
+        return;
+    }
+
+    // Everything is queued before any texture mode begins: redrawing LOD
+    // images binds their own targets, and raylib texture modes do not nest
+    bool world = use_world_target(state, fit);
+    AspectFit worldFit = fit;
+    if (world) {
+        RenderTexture2D* target = &state->screen.worldFrame;
+        worldFit = (AspectFit){ { 0.0f, 0.0f, (float)target->texture.width, (float)target->texture.height }, 1.0f };
+    }
+    RenderPipeline_clear(state->pipeline);
+    if (state->map.mode == TILE_STORAGE_CHUNKED) {
+        MapRenderSystem_render(&state->mapRenderer, state->layers[RENDER_LAYER_WORLD], &state->cam, worldFit);
+    }
+    SpriteRenderSystem_render(&state->sprites, state->layers[RENDER_LAYER_ENTITIES], &state->cam, worldFit);
+    render_debug_last_click(state, fit);
+    // Last TextFormat before the execute, so the overlay text is still intact
+    render_debug_world_stats(state, renderHeight);
+
+    if (world) {
+        BeginTextureMode(state->screen.worldFrame);
+        ClearBackground(RENDER_FRAME_BACKGROUND);
+        render_table_map(state, worldFit);
+        RenderPipeline_execute_layers(state->pipeline, state->renderer, RENDER_LAYER_WORLD, RENDER_LAYER_ENTITIES);
+        EndTextureMode();
+    }
+    if (cache) {
+        BeginTextureMode(state->screen.renderFrame);
+        ClearBackground(RENDER_FRAME_BACKGROUND);
+    }
+    if (world) {
+        upscale_world(state, fit);
+        RenderPipeline_execute_layers(state->pipeline, state->renderer, RENDER_LAYER_OVERLAY, RENDER_LAYER_COUNT - 1);
+    } else {
+        render_table_map(state, fit);
+        RenderPipeline_execute(state->pipeline, state->renderer);
+    }
     if (state->uiProvider) {
         UIDimensions dimensions = {
             .width = (float)renderWidth,
@@ -54,18 +223,26 @@ void RenderSystem_render(GameState* state, AspectFit fit) {
         UIProvider_set_layout_dimensions(state->uiProvider, dimensions);
     }
     
-    Vector2 mousePos = GetMousePosition();
-    bool mouseDown = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
-    bool mousePressedThisFrame = IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
-    
-    UISystem_begin(state);
-    UISystem_set_pointer_state(state, mousePos, mouseDown);
-    UISystem_draw_hud(state);
-    UISystem_draw_popup(state);
-    UISystem_end_and_render(state);
-    UISystem_set_pointer_state(state, mousePos, mouseDown);
-    UISystem_update_popup_interactions(state, mousePressedThisFrame);
-    
+    PointerState pointer = read_pointer(state);
+    if (!UISystem_replay(state, pointer.pos, pointer.down)) {
+        UISystem_begin(state);
+        UISystem_set_pointer_state(state, pointer.pos, pointer.down);
+        UISystem_draw_hud(state);
+        UISystem_draw_popup(state);
+        UISystem_end_and_render(state);
+    }
+    UISystem_set_pointer_state(state, pointer.pos, pointer.down);
+    UISystem_update_popup_interactions(state, pointer.pressed);
+
+    if (cache) {
+        EndTextureMode();
+        present_frame(state, renderWidth, renderHeight);
+        // Popup interactions may have changed what the next frame shows
+        state->lastFrame = capture_frame(state, fit, renderWidth, renderHeight);
+        state->frameCached = true;
+    } else {
+        state->frameCached = false;
+    }
 }
 
 
@@ -0,0 +1,68 @@
+#include "systems/room_system.h"
+
+static int rand_range(uint32_t* rng, int count) {
+    return count > 1 ? (int)(RoomSystem_rand(rng) % (uint32_t)count) : 0;
+}
+
+Room RoomSystem_place(uint32_t seed, int cellX, int cellY, int cellWidth, int cellHeight) {
+    uint32_t rng = seed ? seed : 0x9E3779B9u;
+    int innerWidth = cellWidth - 2;
+    int innerHeight = cellHeight - 2;
+
+    bool junction = rand_range(&rng, ROOM_JUNCTION_CHANCE) == 0;
+    if (junction || innerWidth < ROOM_MIN_SIZE || innerHeight < ROOM_MIN_SIZE) {
+        Room room = { cellX + cellWidth / 2, cellY + cellHeight / 2, 1, 1 };
+        if (innerWidth > 0) room.x = cellX + 1 + rand_range(&rng, innerWidth);
+        if (innerHeight > 0) room.y = cellY + 1 + rand_range(&rng, innerHeight);
+        return room;
+    }
+
+    Room room;
+    room.width = ROOM_MIN_SIZE + rand_range(&rng, innerWidth - ROOM_MIN_SIZE + 1);
+    room.height = ROOM_MIN_SIZE + rand_range(&rng, innerHeight - ROOM_MIN_SIZE + 1);
+    room.x = cellX + 1 + rand_range(&rng, innerWidth - room.width + 1);
+    room.y = cellY + 1 + rand_range(&rng, innerHeight - room.height + 1);
+    return room;
+}
+
+void RoomSystem_carve(uint16_t* tiles, int stride, Room rect, Room clip, uint16_t tile_id) {
+    int x0 = rect.x > clip.x ? rect.x : clip.x;
+    int y0 = rect.y > clip.y ? rect.y : clip.y;
+    int x1 = rect.x + rect.width < clip.x + clip.width ? rect.x + rect.width : clip.x + clip.width;
+    int y1 = rect.y + rect.height < clip.y + clip.height ? rect.y + rect.height : clip.y + clip.height;
+    for (int y = y0; y < y1; y++) {
+        uint16_t* row = tiles + (long)y * stride;
+        for (int x = x0; x < x1; x++) {
+            row[x] = tile_id;
+        }
+    }
+}
+
+// Straight run from (x0, y0) to (x1, y1), one of which must share an axis
+static void carve_run(uint16_t* tiles, int stride, Room clip, int x0, int y0, int x1, int y1,
+                      uint16_t wall, uint16_t tile_id) {
+    int minX = x0 < x1 ? x0 : x1, maxX = x0 < x1 ? x1 : x0;
+    int minY = y0 < y1 ? y0 : y1, maxY = y0 < y1 ? y1 : y0;
+    if (minX < clip.x) minX = clip.x;
+    if (minY < clip.y) minY = clip.y;
+    if (maxX > clip.x + clip.width - 1) maxX = clip.x + clip.width - 1;
+    if (maxY > clip.y + clip.height - 1) maxY = clip.y + clip.height - 1;
+    for (int y = minY; y <= maxY; y++) {
+        uint16_t* row = tiles + (long)y * stride;
+        for (int x = minX; x <= maxX; x++) {
+            if (row[x] == wall) row[x] = tile_id;
+        }
+    }
+}
+
+void RoomSystem_carve_corridor(uint16_t* tiles, int stride, Room clip,
+                               int x0, int y0, int x1, int y1, bool horizontalFirst,
+                               uint16_t wall, uint16_t tile_id) {
+    if (horizontalFirst) {
+        carve_run(tiles, stride, clip, x0, y0, x1, y0, wall, tile_id);
+        carve_run(tiles, stride, clip, x1, y0, x1, y1, wall, tile_id);
+    } else {
+        carve_run(tiles, stride, clip, x0, y0, x0, y1, wall, tile_id);
+        carve_run(tiles, stride, clip, x0, y1, x1, y1, wall, tile_id);
+    }
+}
@@ -0,0 +1,382 @@
+#include "systems/save_system.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "raylib.h"
+
+static const char JOURNAL_MAGIC[4] = { 'G', 'R', 'J', 'L' };
+static const char MANIFEST_MAGIC[4] = { 'G', 'R', 'S', 'V' };
+#define SAVE_VERSION 1u
+#define JOURNAL_HEADER_SIZE 12  // magic, version, segment number
+
+static bool save_path(const SaveSystem* sys, char* out, const char* name, uint32_t segment) {
+    int n = segment ? snprintf(out, REGION_PATH_MAX, "%s/%s.%u.bin", sys->directory, name, segment)
+                    : snprintf(out, REGION_PATH_MAX, "%s/%s", sys->directory, name);
+    return n > 0 && n < REGION_PATH_MAX;
+}
+
+static void swap_journals(TileJournal* a, TileJournal* b) {
+    TileJournal tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+// Chunk stream workers (or the main thread without one): chunks come back
+// from their snapshot if there is one, else from whatever the world's own
+// generator makes. The workers share readStore's open region file
+static bool restore_generate(void* userData, int chunkX, int chunkY, uint32_t seed, uint16_t* tiles) {
+    SaveSystem* sys = (SaveSystem*)userData;
+#ifdef USE_THREADING
+    pthread_mutex_lock(&sys->readLock);
+#endif
+    bool restored = RegionStore_read_tiles(&sys->readStore, chunkX, chunkY, tiles);
+#ifdef USE_THREADING
+    pthread_mutex_unlock(&sys->readLock);
+#endif
+    if (restored) return true;
+    for (int i = 0; i < CHUNK_AREA; i++) tiles[i] = TILE_NONE;  // a failed decode may have written some
+    return sys->generator && sys->generator(sys->generatorData, chunkX, chunkY, seed, tiles);
+}
+
+static uint32_t read_manifest(const SaveSystem* sys) {
+    char path[REGION_PATH_MAX];
+    if (!save_path(sys, path, "snapshot.bin", 0)) return 0;
+    FILE* file = fopen(path, "rb");
+    if (!file) return 0;
+    char magic[4];
+    uint32_t version = 0, saved = 0;
+    bool ok = fread(magic, 1, 4, file) == 4 && memcmp(magic, MANIFEST_MAGIC, 4) == 0 &&
+              fread(&version, sizeof(version), 1, file) == 1 && version == SAVE_VERSION &&
+              fread(&saved, sizeof(saved), 1, file) == 1;
+    fclose(file);
+    return ok ? saved : 0;
+}
+
+static bool write_manifest(const SaveSystem* sys, uint32_t saved) {
+    char path[REGION_PATH_MAX], tmpPath[REGION_PATH_MAX];
+    if (!save_path(sys, path, "snapshot.bin", 0) || !save_path(sys, tmpPath, "snapshot.tmp", 0)) return false;
+    FILE* file = fopen(tmpPath, "wb");
+    if (!file) return false;
+    uint32_t version = SAVE_VERSION;
+    bool ok = fwrite(MANIFEST_MAGIC, 1, 4, file) == 4 &&
+              fwrite(&version, sizeof(version), 1, file) == 1 &&
+              fwrite(&saved, sizeof(saved), 1, file) == 1;
+    ok = fclose(file) == 0 && ok;
+    if (!ok) return false;
+#ifdef _WIN32
+    remove(path);  // rename does not replace on Windows
+#endif
+    return rename(tmpPath, path) == 0;
+}
+
+// Reads a whole segment; *records points past the header into the returned buffer
+static uint8_t* read_segment(const SaveSystem* sys, uint32_t segment, const uint8_t** records, size_t* size) {
+    char path[REGION_PATH_MAX];
+    if (!save_path(sys, path, "journal", segment)) return NULL;
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    uint8_t* data = NULL;
+    long length = -1;
+    if (fseek(file, 0, SEEK_END) == 0) length = ftell(file);
+    if (length >= JOURNAL_HEADER_SIZE && fseek(file, 0, SEEK_SET) == 0) {
+        data = (uint8_t*)malloc((size_t)length);
+        if (data && fread(data, 1, (size_t)length, file) != (size_t)length) {
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(file);
+    if (!data) return NULL;
+
+    uint32_t version, number;
+    memcpy(&version, data + 4, sizeof(version));
+    memcpy(&number, data + 8, sizeof(number));
+    if (memcmp(data, JOURNAL_MAGIC, 4) != 0 || version != SAVE_VERSION || number != segment) {
+        free(data);
+        return NULL;
+    }
+    *records = data + JOURNAL_HEADER_SIZE;
+    *size = (size_t)length - JOURNAL_HEADER_SIZE;
+    return data;
+}
+
+static void open_segment(SaveSystem* sys) {
+    char path[REGION_PATH_MAX];
+    sys->file = save_path(sys, path, "journal", sys->fileSegment) ? fopen(path, "wb") : NULL;
+    if (!sys->file) {
+        TraceLog(LOG_WARNING, "SaveSystem: Cannot create journal segment %u in %s", sys->fileSegment, sys->directory);
+        return;
+    }
+    setvbuf(sys->file, NULL, _IOFBF, SAVE_JOURNAL_BUFFER);
+    uint32_t header[2] = { SAVE_VERSION, sys->fileSegment };
+    if (fwrite(JOURNAL_MAGIC, 1, 4, sys->file) != 4 || fwrite(header, sizeof(header), 1, sys->file) != 1) {
+        sys->failures++;
+    }
+}
+
+static void write_records(SaveSystem* sys, const TileJournal* records) {
+    if (records->size == 0) return;
+    if (!sys->file || fwrite(records->data, 1, records->size, sys->file) != records->size) {
+        sys->failures++;
+        return;
+    }
+    sys->bytesWritten += (long)records->size;
+}
+
+// Writer: appends what the main thread handed over, closing the segment first if it was sealed
+static void write_work(SaveSystem* sys, bool seal) {
+    if (seal) {
+        write_records(sys, &sys->closing);
+        if (sys->file && fclose(sys->file) != 0) sys->failures++;
+        sys->file = NULL;
+        sys->closedSegment = sys->fileSegment++;
+        open_segment(sys);
+    }
+    write_records(sys, &sys->writing);
+    if (sys->file) fflush(sys->file);
+    TileJournal_clear(&sys->closing);
+    TileJournal_clear(&sys->writing);
+}
+
+// Writer: stores every frozen chunk as a snapshot, then moves the manifest
+// up to the segment sealed with the freeze and drops the segments it covers
+static bool save_frozen(SaveSystem* sys) {
+    for (int i = 0; i < sys->frozen.count; i++) {
+        const WorldFrozenChunk* frozen = &sys->frozen.chunks[i];
+        bool ok;
+        if (frozen->tiles) {
+            ok = RegionStore_write_tiles(&sys->snapshots, frozen->chunkX, frozen->chunkY, frozen->tiles);
+        } else if (frozen->packed) {
+            ok = RegionStore_write(&sys->snapshots, frozen->chunkX, frozen->chunkY, frozen->packed, frozen->packedSize);
+        } else {
+            // Paged out: both stores use the same slot payload, copy it across
+            uint8_t payload[REGION_SLOT_PAYLOAD];
+            uint32_t length = RegionStore_read(&sys->pages, frozen->chunkX, frozen->chunkY, payload);
+            ok = length > 0 && RegionStore_write(&sys->snapshots, frozen->chunkX, frozen->chunkY, payload, length);
+        }
+        if (!ok) return false;
+        sys->savedChunks++;
+    }
+
+    // The manifest goes last: until it names the segment, loading still replays it
+    if (!write_manifest(sys, sys->closedSegment)) return false;
+    char path[REGION_PATH_MAX];
+    for (uint32_t segment = sys->savedSegment + 1; segment <= sys->closedSegment; segment++) {
+        if (save_path(sys, path, "journal", segment)) remove(path);
+    }
+    sys->savedSegment = sys->closedSegment;
+    sys->saves++;
+    return true;
+}
+
+// Takes the handed-over records; called with the lock held when threaded
+static bool take_work(SaveSystem* sys) {
+    swap_journals(&sys->pending, &sys->writing);
+    bool seal = sys->sealRequested;
+    if (seal) {
+        swap_journals(&sys->sealed, &sys->closing);
+        sys->sealRequested = false;
+    }
+    return seal;
+}
+
+// Writer: a seal always comes with a frozen snapshot to save
+static void run_work(SaveSystem* sys, bool seal) {
+    write_work(sys, seal);
+    if (!seal) return;
+    bool saved = !sys->saveFailed && save_frozen(sys);
+
+#ifdef USE_THREADING
+    if (sys->threaded) pthread_mutex_lock(&sys->lock);
+#endif
+    if (!saved && !sys->saveFailed) {
+        sys->saveFailed = true;
+        sys->failures++;
+        TraceLog(LOG_WARNING, "SaveSystem: Failed to save a snapshot, keeping the journal from segment %u", sys->savedSegment + 1);
+    }
+    sys->saveDone = true;
+#ifdef USE_THREADING
+    if (sys->threaded) pthread_mutex_unlock(&sys->lock);
+#endif
+}
+
+#ifdef USE_THREADING
+static void* writer_main(void* arg) {
+    SaveSystem* sys = (SaveSystem*)arg;
+    for (;;) {
+        pthread_mutex_lock(&sys->lock);
+        while (sys->running && sys->pending.size == 0 && !sys->sealRequested) {
+            pthread_cond_wait(&sys->wake, &sys->lock);
+        }
+        bool stop = !sys->running;
+        bool seal = take_work(sys);
+        pthread_mutex_unlock(&sys->lock);
+
+        run_work(sys, seal);
+        if (stop) break;
+    }
+    return NULL;
+}
+#endif
+
+bool SaveSystem_open(SaveSystem* sys, World* world, const char* directory) {
+    if (!sys) return false;
+    memset(sys, 0, sizeof(*sys));
+    if (!world || !directory) return false;
+    size_t len = strlen(directory);
+    if (len == 0 || len >= sizeof(sys->directory)) return false;
+    memcpy(sys->directory, directory, len + 1);
+    if (!RegionStore_open(&sys->snapshots, directory)) return false;
+    RegionStore_open_readonly(&sys->readStore, directory);
+    if (world->paging) RegionStore_open_readonly(&sys->pages, world->store.directory);
+
+    sys->world = world;
+    sys->open = true;
+#ifdef USE_THREADING
+    pthread_mutex_init(&sys->readLock, NULL);
+#endif
+    TileJournal_init(&sys->journal);
+    TileJournal_init(&sys->pending);
+    TileJournal_init(&sys->sealed);
+    TileJournal_init(&sys->writing);
+    TileJournal_init(&sys->closing);
+
+    // Chunks come back from their snapshots as they are generated, nothing is read up front
+    sys->generator = world->generator;
+    sys->generatorData = world->generatorData;
+    sys->seed = world->seed;
+    World_set_generator(world, restore_generate, sys, sys->seed);
+
+    // Only the segments after the last save are replayed; the edits they
+    // make leave their chunks changed, so the first autosave covers them
+    sys->savedSegment = read_manifest(sys);
+    sys->closedSegment = sys->savedSegment;
+    for (;;) {
+        const uint8_t* records = NULL;
+        size_t size = 0;
+        uint8_t* data = read_segment(sys, sys->closedSegment + 1, &records, &size);
+        if (!data) break;
+        long applied = TileJournal_replay(world, records, size);
+        free(data);
+        if (applied < 0) {
+            TraceLog(LOG_WARNING, "SaveSystem_open: Journal segment %u is truncated", sys->closedSegment + 1);
+        } else {
+            sys->replayed += applied;
+        }
+        sys->closedSegment++;
+    }
+
+    sys->segment = sys->fileSegment = sys->closedSegment + 1;
+    open_segment(sys);
+
+#ifdef USE_THREADING
+    pthread_mutex_init(&sys->lock, NULL);
+    pthread_cond_init(&sys->wake, NULL);
+    sys->running = true;
+    sys->threaded = pthread_create(&sys->thread, NULL, writer_main, sys) == 0;
+    if (!sys->threaded) {
+        TraceLog(LOG_WARNING, "SaveSystem_open: Failed to start the writer thread, saving on the main thread");
+    }
+#endif
+    return sys->file != NULL;
+}
+
+// Main thread: hands the snapshot's buffers back once the writer is done with them
+static void collect_save(SaveSystem* sys) {
+#ifdef USE_THREADING
+    if (sys->threaded) pthread_mutex_lock(&sys->lock);
+#endif
+    bool done = sys->saveDone;
+    sys->saveDone = false;
+#ifdef USE_THREADING
+    if (sys->threaded) pthread_mutex_unlock(&sys->lock);
+#endif
+    if (!done) return;
+    World_release_snapshot(sys->world, &sys->frozen);
+    sys->saving = false;
+}
+
+void SaveSystem_update(SaveSystem* sys) {
+    if (!sys || !sys->open) return;
+    if (sys->saving) collect_save(sys);
+
+    // saveFailed is only written while a save is in flight
+    size_t unsaved = sys->segmentBytes + sys->journal.size;
+    if (unsaved > 0) sys->framesSinceSave++;
+    bool autosave = unsaved > 0 && !sys->saving && !sys->saveFailed &&
+                    (unsaved >= SAVE_COMPACT_BYTES || sys->framesSinceSave >= SAVE_AUTOSAVE_FRAMES);
+    if (sys->journal.size == 0 && !autosave) return;
+
+    if (autosave) {
+        World_freeze(sys->world, &sys->frozen);
+        sys->saving = true;
+        sys->framesSinceSave = 0;
+    }
+
+#ifdef USE_THREADING
+    if (sys->threaded) pthread_mutex_lock(&sys->lock);
+#endif
+    if (sys->journal.size > 0) {
+        if (!TileJournal_append(&sys->pending, sys->journal.data, sys->journal.size)) sys->failures++;
+        sys->segmentBytes += sys->journal.size;
+        TileJournal_clear(&sys->journal);
+    }
+    // The segment ends exactly where the frozen state does
+    if (autosave) {
+        swap_journals(&sys->pending, &sys->sealed);
+        sys->sealRequested = true;
+        sys->segment++;
+        sys->segmentBytes = 0;
+    }
+#ifdef USE_THREADING
+    if (sys->threaded) {
+        pthread_cond_signal(&sys->wake);
+        pthread_mutex_unlock(&sys->lock);
+        return;
+    }
+#endif
+
+    // No writer thread: write and save here
+    run_work(sys, take_work(sys));
+    if (sys->saving) collect_save(sys);
+}
+
+void SaveSystem_close(SaveSystem* sys) {
+    if (!sys || !sys->open) return;
+    SaveSystem_update(sys);
+
+#ifdef USE_THREADING
+    if (sys->threaded) {
+        pthread_mutex_lock(&sys->lock);
+        sys->running = false;
+        pthread_cond_signal(&sys->wake);
+        pthread_mutex_unlock(&sys->lock);
+        pthread_join(sys->thread, NULL);
+        sys->threaded = false;
+    }
+    pthread_cond_destroy(&sys->wake);
+    pthread_mutex_destroy(&sys->lock);
+#endif
+
+    // The writer finishes a save it has taken before it stops
+    if (sys->saving) collect_save(sys);
+    World_snapshot_free(&sys->frozen);
+
+    if (sys->file) fclose(sys->file);
+    sys->file = NULL;
+    RegionStore_close(&sys->snapshots);
+    RegionStore_close(&sys->readStore);
+#ifdef USE_THREADING
+    pthread_mutex_destroy(&sys->readLock);
+#endif
+    RegionStore_close(&sys->pages);
+    World_set_generator(sys->world, sys->generator, sys->generatorData, sys->seed);
+    TileJournal_free(&sys->journal);
+    TileJournal_free(&sys->pending);
+    TileJournal_free(&sys->sealed);
+    TileJournal_free(&sys->writing);
+    TileJournal_free(&sys->closing);
+    sys->open = false;
+}
@@ -0,0 +1,168 @@
+#include "systems/sprite_render_system.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "textures/sprite.h"
+#include "renderer/render_commands.h"
+
+#define SPRITE_RENDER_INITIAL_CAPACITY 64
+
+static void free_frame_arrays(SpriteRenderSystem* sys) {
+    free(sys->hits);
+    free(sys->x);
+    free(sys->y);
+    free(sys->atlases);
+    free(sys->tileIds);
+    free(sys->batchOf);
+    free(sys->order);
+    free(sys->batchAtlases);
+    free(sys->batchOffsets);
+}
+
+static bool grow(SpriteRenderSystem* sys, int needed) {
+    int capacity = sys->capacity > 0 ? sys->capacity : SPRITE_RENDER_INITIAL_CAPACITY;
+    while (capacity < needed) capacity *= 2;
+
+    // Per-frame arrays hold nothing between renders, so they are replaced rather than copied
+    SpriteRenderSystem next = *sys;
+    next.hits = (SpatialHit*)malloc(sizeof(SpatialHit) * capacity);
+    next.x = (float*)malloc(sizeof(float) * capacity);
+    next.y = (float*)malloc(sizeof(float) * capacity);
+    next.atlases = (Atlas**)malloc(sizeof(Atlas*) * capacity);
+    next.tileIds = (int*)malloc(sizeof(int) * capacity);
+    next.batchOf = (int*)malloc(sizeof(int) * capacity);
+    next.order = (int*)malloc(sizeof(int) * capacity);
+    next.batchAtlases = (Atlas**)malloc(sizeof(Atlas*) * capacity);
+    next.batchOffsets = (int*)malloc(sizeof(int) * (capacity + 1));
+    if (!next.hits || !next.x || !next.y || !next.atlases || !next.tileIds || !next.batchOf ||
+        !next.order || !next.batchAtlases || !next.batchOffsets) {
+        free_frame_arrays(&next);
+        return false;
+    }
+    free_frame_arrays(sys);
+    next.capacity = capacity;
+    *sys = next;
+    return true;
+}
+
+void SpriteRenderSystem_init(SpriteRenderSystem* sys, ECS* ecs, const SpatialIndex* index,
+                             ComponentTypeId spriteTypeId, int tileSize) {
+    if (!sys) return;
+    memset(sys, 0, sizeof(SpriteRenderSystem));
+    sys->ecs = ecs;
+    sys->index = index;
+    sys->spriteTypeId = spriteTypeId;
+    sys->tileSize = tileSize;
+}
+
+void SpriteRenderSystem_cleanup(SpriteRenderSystem* sys) {
+    if (!sys) return;
+    free_frame_arrays(sys);
+    SpriteRenderSystem_init(sys, sys->ecs, sys->index, sys->spriteTypeId, sys->tileSize);
+}
+
+// Queries the tiles under the view, a tile counting when any of it shows
+static int query_view(SpriteRenderSystem* sys, const Camera2DEx* cam) {
+    float ts = (float)sys->tileSize;
+    int x0 = (int)floorf(cam->pos.x / ts);
+    int y0 = (int)floorf(cam->pos.y / ts);
+    int x1 = (int)ceilf((cam->pos.x + cam->logicalSize.x / cam->zoom) / ts);
+    int y1 = (int)ceilf((cam->pos.y + cam->logicalSize.y / cam->zoom) / ts);
+
+    int found = SpatialIndex_query_rect(sys->index, x0, y0, x1 - x0, y1 - y0, sys->hits, sys->capacity);
+    if (found > sys->capacity) {
+        if (!grow(sys, found)) return sys->capacity;
+        found = SpatialIndex_query_rect(sys->index, x0, y0, x1 - x0, y1 - y0, sys->hits, sys->capacity);
+    }
+    return found;
+}
+
+// Collects visible sprites in world pixels; indexed entities without a Sprite are skipped
+static void gather(SpriteRenderSystem* sys, int hitCount) {
+    float ts = (float)sys->tileSize;
+    int visible = 0;
+    for (int i = 0; i < hitCount; i++) {
+        const SpatialHit* hit = &sys->hits[i];
+        Sprite* s = Sprite_get(sys->ecs, hit->entity, sys->spriteTypeId);
+        if (!s || !s->atlas) continue;
+        sys->x[visible] = hit->x * ts;
+        sys->y[visible] = hit->y * ts;
+        sys->atlases[visible] = s->atlas;
+        sys->tileIds[visible] = s->tile_id;
+        visible++;
+    }
+    sys->visibleCount = visible;
+}
+
+// Camera_WorldToScreen folded into one scale and offset per axis
+static void transform(SpriteRenderSystem* sys, const Camera2DEx* cam, AspectFit fit) {
+    float scale = fit.scale * cam->zoom;
+    float ox = fit.dest.x - cam->pos.x * scale;
+    float oy = fit.dest.y - cam->pos.y * scale;
+    float* x = sys->x;
+    float* y = sys->y;
+    for (int i = 0; i < sys->visibleCount; i++) {
+        x[i] = x[i] * scale + ox;
+        y[i] = y[i] * scale + oy;
+    }
+}
+
+// Stable counting sort on atlas, atlases in the order they first appear.
+// A frame rarely sees more than a few atlases, so the lookup is a scan
+// that tries the previous sprite's batch first.
+static void group_by_atlas(SpriteRenderSystem* sys) {
+    int batches = 0;
+    int last = -1;
+    for (int i = 0; i < sys->visibleCount; i++) {
+        Atlas* atlas = sys->atlases[i];
+        int batch = last;
+        if (batch < 0 || sys->batchAtlases[batch] != atlas) {
+            for (batch = 0; batch < batches && sys->batchAtlases[batch] != atlas; batch++) {}
+            if (batch == batches) sys->batchAtlases[batches++] = atlas;
+        }
+        sys->batchOf[i] = batch;
+        last = batch;
+    }
+
+    memset(sys->batchOffsets, 0, sizeof(int) * (batches + 1));
+    for (int i = 0; i < sys->visibleCount; i++) sys->batchOffsets[sys->batchOf[i] + 1]++;
+    for (int b = 0; b < batches; b++) sys->batchOffsets[b + 1] += sys->batchOffsets[b];
+
+    // Scatter with the offsets as write cursors, which leaves each one at the
+    // next batch's start; shift them back
+    for (int i = 0; i < sys->visibleCount; i++) {
+        sys->order[sys->batchOffsets[sys->batchOf[i]]++] = i;
+    }
+    for (int b = batches; b > 0; b--) sys->batchOffsets[b] = sys->batchOffsets[b - 1];
+    sys->batchOffsets[0] = 0;
+    sys->batchCount = batches;
+}
+
+void SpriteRenderSystem_render(SpriteRenderSystem* sys, RenderLayer* layer, const Camera2DEx* cam, AspectFit fit) {
+    if (!sys || !layer || !cam || !sys->ecs || !sys->index) return;
+    sys->visibleCount = 0;
+    sys->batchCount = 0;
+    if (sys->index->itemCount == 0) return;
+    if (sys->capacity == 0 && !grow(sys, SPRITE_RENDER_INITIAL_CAPACITY)) return;
+
+    gather(sys, query_view(sys, cam));
+    transform(sys, cam, fit);
+    group_by_atlas(sys);
+
+    float size = sys->tileSize * fit.scale * cam->zoom;
+    RenderColor white = { 255, 255, 255, 255 };
+    for (int b = 0; b < sys->batchCount; b++) {
+        Atlas* atlas = sys->batchAtlases[b];
+        for (int k = sys->batchOffsets[b]; k < sys->batchOffsets[b + 1]; k++) {
+            int i = sys->order[k];
+            Rectangle src = Atlas_getRect(atlas, sys->tileIds[i]);
+            RenderCommand cmd = RenderCommand_texture(&atlas->texture,
+                                                      (RenderRect){ src.x, src.y, src.width, src.height },
+                                                      (RenderRect){ sys->x[i], sys->y[i], size, size },
+                                                      white);
+            RenderLayer_add_command(layer, &cmd);
+        }
+    }
+}
@@ -1,7 +1,8 @@
 #include "systems/tile_edit_system.h"
 
 #include "raylib.h"
-#include "gramarye_chunk_renderer/chunk_render_system.h"  // For RenderVector2 type
+#include "systems/map_render_system.h"
+#include "gramarye_chunk_renderer/chunk_render_system.h"  // Table storage clicks, RenderVector2
 #include "gramarye_chunk_controller/tile_update_queue.h"  // TileUpdateQueue
 
 void TileEditSystem_place_tile_at_mouse(GameState* state, AspectFit fit, Vector2 mousePos) {
@@ -9,10 +10,16 @@ void TileEditSystem_place_tile_at_mouse(GameState* state, AspectFit fit, Vector2
     if (!state) return;
 
     int tileX = 0, tileY = 0;
-    RenderVector2 renderMousePos = {mousePos.x, mousePos.y};
 
-    if (!ChunkRenderSystem_handle_click(&state->chunkRenderer, renderMousePos, 
-                                       (CameraHandle)&state->cam, (AspectFitHandle)&fit, &tileX, &tileY)) {
+    bool hit;
+    if (state->map.mode == TILE_STORAGE_TABLE) {
+        RenderVector2 renderMousePos = { mousePos.x, mousePos.y };
+        hit = ChunkRenderSystem_handle_click(&state->chunkRenderer, renderMousePos,
+                                             (CameraHandle)&state->cam, (AspectFitHandle)&fit, &tileX, &tileY);
+    } else {
+        hit = MapRenderSystem_screen_to_tile(&state->mapRenderer, &state->cam, fit, mousePos, &tileX, &tileY);
+    }
+    if (!hit) {
         TraceLog(LOG_DEBUG, "TileEditSystem_place_tile_at_mouse: Failed to get tile at mouse: %f, %f", mousePos.x, mousePos.y);
         return;
     }
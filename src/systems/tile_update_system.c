@@ -0,0 +1,100 @@
+#include "systems/tile_update_system.h"
+
+static void publish_region(TileUpdateSystem* sys, int x, int y, int width, int height) {
+    if (!sys->eventBus || width <= 0 || height <= 0) return;
+    TileRegionEvent event = { x, y, width, height };
+    EventBus_publish(sys->eventBus, EVENT_TILE_REGION_UPDATED, &event);
+}
+
+// ChunkManagerSystem uses the same CHUNK_SIZE grid, so each chunk is marked once
+static void mark_chunks(TileUpdateSystem* sys, int x, int y, int width, int height) {
+    if (!sys->chunkManager) return;
+    for (int chunkY = Chunk_coord(y); chunkY <= Chunk_coord(y + height - 1); chunkY++) {
+        for (int chunkX = Chunk_coord(x); chunkX <= Chunk_coord(x + width - 1); chunkX++) {
+            ChunkManagerSystem_mark_chunk_dirty(sys->chunkManager, chunkX, chunkY);
+        }
+    }
+}
+
+void TileUpdateSystem_init(TileUpdateSystem* sys, TileStorage* map, EventBus* eventBus) {
+    if (!sys) return;
+    sys->map = map;
+    sys->eventBus = eventBus;
+    sys->journal = NULL;
+    sys->chunkManager = NULL;
+}
+
+void TileUpdateSystem_set_journal(TileUpdateSystem* sys, TileJournal* journal) {
+    if (!sys) return;
+    sys->journal = journal;
+}
+
+void TileUpdateSystem_set_chunk_manager(TileUpdateSystem* sys, ChunkManagerSystem* chunkManager) {
+    if (!sys) return;
+    sys->chunkManager = chunkManager;
+}
+
+int TileUpdateSystem_process_updates(TileUpdateSystem* sys, TileUpdateQueue* queue) {
+    if (!sys || !sys->map || !queue) return 0;
+
+    int applied = 0;
+    int minX = 0, minY = 0, maxX = -1, maxY = -1;
+    TileUpdateCommand cmd;
+    while (TileUpdateQueue_pop(queue, &cmd)) {
+        int x = cmd.tileX, y = cmd.tileY, width = 1, height = 1;
+        if (!TileStorage_clip(sys->map, &x, &y, &width, &height)) continue;
+        TileStorage_set_tile(sys->map, x, y, cmd.tile_id);
+        if (sys->journal) TileJournal_set(sys->journal, x, y, cmd.tile_id);
+        if (applied == 0) {
+            minX = maxX = x;
+            minY = maxY = y;
+        } else {
+            if (x < minX) minX = x;
+            if (x > maxX) maxX = x;
+            if (y < minY) minY = y;
+            if (y > maxY) maxY = y;
+        }
+        applied++;
+    }
+
+    if (applied > 0) publish_region(sys, minX, minY, maxX - minX + 1, maxY - minY + 1);
+    return applied;
+}
+
+// The event and the journal get the clipped rectangle, i.e. exactly the tiles written
+
+int TileUpdateSystem_fill_rect(TileUpdateSystem* sys, int x, int y, int width, int height, uint16_t tile_id) {
+    if (!sys || !sys->map) return 0;
+    if (!TileStorage_clip(sys->map, &x, &y, &width, &height)) return 0;
+    int touched = TileStorage_fill_rect(sys->map, x, y, width, height, tile_id);
+    if (touched > 0 && sys->journal) TileJournal_fill(sys->journal, x, y, width, height, tile_id);
+    if (touched > 0) mark_chunks(sys, x, y, width, height);
+    if (touched > 0) publish_region(sys, x, y, width, height);
+    return touched;
+}
+
+int TileUpdateSystem_blit(TileUpdateSystem* sys, int x, int y, int width, int height, const uint16_t* src, int srcStride) {
+    if (!sys || !sys->map || !src || srcStride < 0) return 0;
+    int cx = x, cy = y;
+    if (!TileStorage_clip(sys->map, &cx, &cy, &width, &height)) return 0;
+    src += (long)(cy - y) * srcStride + (cx - x);
+    int touched = TileStorage_blit(sys->map, cx, cy, width, height, src, srcStride);
+    if (touched > 0 && sys->journal) TileJournal_blit(sys->journal, cx, cy, width, height, src, srcStride);
+    if (touched > 0) mark_chunks(sys, cx, cy, width, height);
+    if (touched > 0) publish_region(sys, cx, cy, width, height);
+    return touched;
+}
+
+int TileUpdateSystem_copy_region(TileUpdateSystem* sys, int srcX, int srcY, int width, int height, int dstX, int dstY) {
+    if (!sys || !sys->map) return 0;
+    // Clipping the destination moves the source by the same amount
+    int cx = dstX, cy = dstY;
+    if (!TileStorage_clip(sys->map, &cx, &cy, &width, &height)) return 0;
+    srcX += cx - dstX;
+    srcY += cy - dstY;
+    int touched = TileStorage_copy_region(sys->map, srcX, srcY, width, height, cx, cy);
+    if (touched > 0 && sys->journal) TileJournal_copy(sys->journal, sys->map->world, cx, cy, width, height);
+    if (touched > 0) mark_chunks(sys, cx, cy, width, height);
+    if (touched > 0) publish_region(sys, cx, cy, width, height);
+    return touched;
+}
@@ -8,10 +8,15 @@
 #include "gramarye_clay_ui/popup.h"
 #include "core/health.h"
 #include "core/position.h"
+#include "components/ui_hit_test.h"
 #include "gramarye_renderer/renderer.h"
 #include "gramarye_ui/ui_provider.h"
 
+#define UI_HUD_Z_INDEX 100
+#define UI_POPUP_Z_INDEX 1000
+
 static bool lastMouseDown = false;
+static uint32_t hudId = 0;
 
 typedef struct {
     UIElementId popupId;
@@ -34,6 +39,15 @@ typedef struct {
 
 static ClayUI_PopupConfig popupConfig = {0};
 
+static UIHudInputs hud_inputs(const GameState* state) {
+    BarValue* health = Health_get(state->ecs, state->player, state->healthTypeId);
+    return (UIHudInputs){
+        .turnCount = state->turnCount,
+        .health = health ? health->value : 0.0f,
+        .maxHealth = health ? health->maxValue : 100.0f
+    };
+}
+
 void UISystem_begin(GameState* state) {
     if (state && state->uiProvider) {
         UIProvider_begin_layout(state->uiProvider);
@@ -51,10 +65,9 @@ void UISystem_set_pointer_state(GameState* state, Vector2 mousePos, bool mouseDo
 void UISystem_draw_hud(GameState* state) {
     if (!state) return;
 
-    // Get player health
-    BarValue* health = Health_get(state->ecs, state->player, state->healthTypeId);
-    float currentHealth = health ? health->value : 0.0f;
-    float maxHealth = health ? health->maxValue : 100.0f;
+    UIHudInputs inputs = hud_inputs(state);
+    float currentHealth = inputs.health;
+    float maxHealth = inputs.maxHealth;
 
     CLAY({
         .id = CLAY_ID("hudContainer"),
@@ -72,7 +85,7 @@ void UISystem_draw_hud(GameState* state) {
             .attachTo = CLAY_ATTACH_TO_ROOT,
             .attachPoints = {CLAY_ATTACH_POINT_RIGHT_TOP, CLAY_ATTACH_POINT_RIGHT_TOP},
             .offset = {-10.0f, 10.0f},
-            .zIndex = 100,
+            .zIndex = UI_HUD_Z_INDEX,
             .pointerCaptureMode = CLAY_POINTER_CAPTURE_MODE_PASSTHROUGH
         }
     }) {
@@ -177,7 +190,7 @@ void UISystem_draw_popup(GameState* state) {
             .attachTo = CLAY_ATTACH_TO_ROOT,
             .attachPoints = {CLAY_ATTACH_POINT_CENTER_CENTER, CLAY_ATTACH_POINT_CENTER_CENTER},
             .offset = {currentOffsetX, currentOffsetY},
-            .zIndex = 1000,
+            .zIndex = UI_POPUP_Z_INDEX,
             .pointerCaptureMode = CLAY_POINTER_CAPTURE_MODE_CAPTURE
         }
     }) {
@@ -293,13 +306,86 @@ void UISystem_update_popup_interactions(GameState* state, bool mousePressedThisF
 
     if (closeButtonHovered && mousePressedThisFrame) {
         ClayUI_PopupHide(state->popupState);
+        // Gone before the next layout, so it must stop blocking now
+        UIHitTest_remove(&state->uiHits, popupConfig.popupId.id);
+    }
+}
+
+static void add_hit_region(UIHitTest* hits, uint32_t id, int16_t zIndex, bool captures) {
+    Clay_ElementData data = Clay_GetElementData((Clay_ElementId){ .id = id });
+    if (!data.found) return;
+    Rectangle bounds = { data.boundingBox.x, data.boundingBox.y, data.boundingBox.width, data.boundingBox.height };
+    UIHitTest_add(hits, id, bounds, zIndex, captures);
+}
+
+// Keeps the bounds of the top-level elements of the layout just ended
+static void record_hit_regions(GameState* state) {
+    UIHitTest_clear(&state->uiHits);
+    if (hudId == 0) hudId = CLAY_ID("hudContainer").id;
+    add_hit_region(&state->uiHits, hudId, UI_HUD_Z_INDEX, false);
+    if (state->popupState && state->popupState->isVisible && popupConfig.popupId.id != 0) {
+        add_hit_region(&state->uiHits, popupConfig.popupId.id, UI_POPUP_Z_INDEX, true);
+    }
+}
+
+static UIPopupInputs popup_inputs(const GameState* state) {
+    UIPopupInputs inputs = { 0 };
+    if (!state->popupState || !state->popupState->isVisible) return inputs;
+    inputs.visible = true;
+    inputs.offsetX = state->popupState->offsetX;
+    inputs.offsetY = state->popupState->offsetY;
+    inputs.closeHovered = popupConfig.closeButtonId.id != 0 &&
+                          UIProvider_is_pointer_over(state->uiProvider, popupConfig.closeButtonId);
+    return inputs;
+}
+
+static bool same_inputs(const UILayoutCache* cache, float width, float height,
+                        const UIHudInputs* hud, const UIPopupInputs* popup) {
+    return cache->width == width && cache->height == height &&
+           cache->hud.turnCount == hud->turnCount && cache->hud.health == hud->health &&
+           cache->hud.maxHealth == hud->maxHealth &&
+           cache->popup.visible == popup->visible && cache->popup.offsetX == popup->offsetX &&
+           cache->popup.offsetY == popup->offsetY && cache->popup.closeHovered == popup->closeHovered;
+}
+
+bool UISystem_replay(GameState* state, Vector2 mousePos, bool mouseDown) {
+    if (!state || !state->uiProvider) return false;
+    UILayoutCache* cache = &state->uiCache;
+
+    // Pointer-over queries read the last layout, so hover is known without a new one
+    UISystem_set_pointer_state(state, mousePos, mouseDown);
+    float width = (float)Renderer_get_render_width(state->renderer);
+    float height = (float)Renderer_get_render_height(state->renderer);
+    UIHudInputs hud = hud_inputs(state);
+    UIPopupInputs popup = popup_inputs(state);
+
+    if (cache->valid && same_inputs(cache, width, height, &hud, &popup)) {
+        UIFonts fonts = {
+            .fonts = state->uiFonts,
+            .fontCount = state->uiFontCount
+        };
+        UIProvider_render(state->uiProvider, cache->commands, &fonts);
+        cache->replays++;
+        return true;
     }
+
+    // UISystem_end_and_render stores the commands laid out from these
+    cache->valid = false;
+    cache->width = width;
+    cache->height = height;
+    cache->hud = hud;
+    cache->popup = popup;
+    return false;
 }
 
 void UISystem_end_and_render(GameState* state) {
     if (!state || !state->uiProvider) return;
     
     UIRenderCommands renderCommands = UIProvider_end_layout(state->uiProvider);
+    record_hit_regions(state);
+    state->uiCache.commands = renderCommands;
+    state->uiCache.valid = true;
+    state->uiCache.layouts++;
     UIFonts fonts = {
         .fonts = state->uiFonts,
         .fontCount = state->uiFontCount
@@ -322,28 +408,7 @@ bool UISystem_is_pointer_over_ui(GameState* state) {
     return false;
 }
 
-bool UISystem_check_ui_blocking(GameState* state, Vector2 mousePos, bool mouseDown) {
+bool UISystem_check_ui_blocking(const GameState* state, Vector2 mousePos) {
     if (!state || !state->uiProvider) return false;
-    
-    int renderWidth = Renderer_get_render_width(state->renderer);
-    int renderHeight = Renderer_get_render_height(state->renderer);
-    UIDimensions dimensions = {
-        .width = (float)renderWidth,
-        .height = (float)renderHeight
-    };
-    UIProvider_set_layout_dimensions(state->uiProvider, dimensions);
-    
-    UIVector2 pos = {.x = mousePos.x, .y = mousePos.y};
-    UIProvider_set_pointer_state(state->uiProvider, pos, mouseDown);
-    
-    UISystem_begin(state);
-    UISystem_draw_hud(state);
-    UISystem_draw_popup(state);
-    UISystem_end_and_render(state);
-    
-    bool blocking = UISystem_is_pointer_over_ui(state);
-    
-    return blocking;
+    return UIHitTest_find(&state->uiHits, mousePos) != NULL;
 }
-
-
@@ -1,14 +1,30 @@
 #ifndef TEST_COMMON_H
 #define TEST_COMMON_H
 
+#include <stdio.h>
+
 // Common test utilities and stubs
 
-// Stub for raylib's TraceLog to avoid dependency in tests
+// Stub for raylib's TraceLog to avoid dependency in tests.
+// Include this header after the module headers, so a module that pulls in
+// raylib.h keeps the real declarations.
+#ifndef RAYLIB_H
 #define LOG_INFO 0
 #define LOG_DEBUG 1
 #define LOG_WARNING 2
 #define LOG_ERROR 3
 #define TraceLog(level, ...) ((void)0)
+#endif
 
-#endif // TEST_COMMON_H
+// Fails the current test: prints the reason and jumps to its `done:` label,
+// where the test releases what it created and returns `passed`
+#define TEST_EXPECT(condition, message)                   \
+    do {                                                  \
+        if (!(condition)) {                               \
+            printf("    ✗ FAILED: %s\n", message);        \
+            passed = false;                               \
+            goto done;                                    \
+        }                                                 \
+    } while (0)
 
+#endif // TEST_COMMON_H
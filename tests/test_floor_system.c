@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "components/world.h"
+#include "systems/floor_system.h"
+#include "test_common.h"
+
+#define FLOOR_SEED 0x5EEDu
+
+static const FloorTiles palette = { 5, 4, 3, 8, 7 };
+
+// Chunk (chunkX, chunkY) of a streamed floor against the same tiles of the full one;
+// outside the floor both should be empty
+static bool chunk_matches(Floor* streamed, const Floor* full, int chunkX, int chunkY) {
+    uint16_t tiles[CHUNK_AREA];
+    for (int i = 0; i < CHUNK_AREA; i++) tiles[i] = TILE_NONE;
+    bool exists = FloorSystem_generate_chunk(streamed, chunkX, chunkY, 0, tiles);
+    bool inside = false;
+    for (int ly = 0; ly < CHUNK_SIZE; ly++) {
+        for (int lx = 0; lx < CHUNK_SIZE; lx++) {
+            int x = chunkX * CHUNK_SIZE + lx, y = chunkY * CHUNK_SIZE + ly;
+            bool onFloor = x >= 0 && y >= 0 && x < full->width && y < full->height;
+            uint16_t expected = onFloor ? full->tiles[y * full->width + x] : TILE_NONE;
+            if (tiles[ly * CHUNK_SIZE + lx] != expected) return false;
+            inside = inside || onFloor;
+        }
+    }
+    return exists == inside;
+}
+
+static bool test_streamed_chunks(void) {
+    printf("  Testing streamed chunks against the full floor...\n");
+    bool passed = true;
+    Floor full, streamed;
+    // Neither size is a multiple of the region or chunk size, so edge regions are clipped
+    bool ready = FloorSystem_init(&full, 200, 150);
+    ready = FloorSystem_init_streamed(&streamed, 200, 150, FLOOR_SEED, &palette) && ready;
+    TEST_EXPECT(ready, "the floors could not be created");
+    FloorSystem_generate(&full, FLOOR_SEED, &palette);
+
+    TEST_EXPECT(!streamed.tiles && !streamed.rooms, "a streamed floor should not hold the whole floor");
+    TEST_EXPECT(streamed.upX == full.upX && streamed.upY == full.upY &&
+                streamed.downX == full.downX && streamed.downY == full.downY,
+                "the streamed floor put its stairs elsewhere");
+
+    // Twice: the second pass reads regions back from the cache
+    for (int pass = 0; pass < 2; pass++) {
+        for (int chunkY = -1; chunkY <= 3; chunkY++) {
+            for (int chunkX = -1; chunkX <= 4; chunkX++) {
+                TEST_EXPECT(chunk_matches(&streamed, &full, chunkX, chunkY), "a streamed chunk differs from the full floor");
+            }
+        }
+    }
+
+    printf("    ✓ Streamed chunk test passed\n");
+done:
+    FloorSystem_free(&streamed);
+    FloorSystem_free(&full);
+    return passed;
+}
+
+// Main test function for the floor_system module
+bool test_floor_system(void) {
+    bool all_passed = true;
+
+    all_passed &= test_streamed_chunks();
+
+    return all_passed;
+}
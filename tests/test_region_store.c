@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "components/region_file.h"
+#include "test_common.h"
+
+#define REGION_DIR "test_region_store"
+
+static void remove_regions(void) {
+    static const char* const names[] = { "r.0.-1.bin", "r.1.1.bin", "r.-1.0.bin", "r.2.2.bin" };
+    char path[REGION_PATH_MAX];
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        snprintf(path, sizeof(path), "%s/%s", REGION_DIR, names[i]);
+        remove(path);
+    }
+    remove(REGION_DIR);
+}
+
+static void fill_pattern(uint16_t* tiles, int seed) {
+    for (int i = 0; i < CHUNK_AREA; i++) tiles[i] = (uint16_t)(i * 7 + seed);
+}
+
+static bool test_round_trip(void) {
+    printf("  Testing tile round trip...\n");
+    bool passed = true;
+    RegionStore store = { 0 };
+    static uint16_t tiles[CHUNK_AREA], read[CHUNK_AREA];
+    TEST_EXPECT(RegionStore_open(&store, REGION_DIR), "the store could not be opened");
+
+    TEST_EXPECT(!RegionStore_read_tiles(&store, 3, -5, read), "an unwritten chunk should read as empty");
+
+    // Chunk (3, -5) is in region (0, -1); a varied pattern stays raw, a flat one is encoded
+    fill_pattern(tiles, 0);
+    TEST_EXPECT(RegionStore_write_tiles(&store, 3, -5, tiles), "write failed");
+    TEST_EXPECT(RegionStore_read_tiles(&store, 3, -5, read), "read failed");
+    TEST_EXPECT(memcmp(tiles, read, sizeof(tiles)) == 0, "raw tiles changed on the way through");
+
+    for (int i = 0; i < CHUNK_AREA; i++) tiles[i] = (uint16_t)(i < 100 ? 1 : 2);
+    TEST_EXPECT(RegionStore_write_tiles(&store, -1, 31, tiles), "encoded write failed");
+    TEST_EXPECT(RegionStore_read_tiles(&store, -1, 31, read), "encoded read failed");
+    TEST_EXPECT(memcmp(tiles, read, sizeof(tiles)) == 0, "encoded tiles changed on the way through");
+
+    printf("    ✓ Round trip test passed\n");
+done:
+    RegionStore_close(&store);
+    return passed;
+}
+
+static bool test_overwrite_and_readers(void) {
+    printf("  Testing overwrites seen by a read-only store...\n");
+    bool passed = true;
+    RegionStore store = { 0 }, reader = { 0 };
+    static uint16_t tiles[CHUNK_AREA], read[CHUNK_AREA];
+    TEST_EXPECT(RegionStore_open(&store, REGION_DIR), "the store could not be opened");
+    TEST_EXPECT(RegionStore_open_readonly(&reader, REGION_DIR), "the reader could not be opened");
+
+    // Each write lands in the other slot; the reader follows the index to the latest one
+    for (int version = 0; version < 3; version++) {
+        fill_pattern(tiles, version);
+        TEST_EXPECT(RegionStore_write_tiles(&store, 40, 40, tiles), "overwrite failed");
+        TEST_EXPECT(RegionStore_read_tiles(&reader, 40, 40, read), "reader could not read the chunk");
+        TEST_EXPECT(memcmp(tiles, read, sizeof(tiles)) == 0, "reader saw a stale copy");
+    }
+
+    uint8_t payload[4] = { 1, 2, 3, 4 };
+    static uint8_t buffer[REGION_SLOT_PAYLOAD];
+    TEST_EXPECT(RegionStore_write(&store, 41, 40, payload, sizeof(payload)), "payload write failed");
+    TEST_EXPECT(RegionStore_read(&reader, 41, 40, buffer) == sizeof(payload), "payload length changed");
+    TEST_EXPECT(memcmp(buffer, payload, sizeof(payload)) == 0, "payload bytes changed");
+    TEST_EXPECT(RegionStore_read(&reader, 42, 40, buffer) == 0, "a neighbouring slot should be empty");
+    TEST_EXPECT(!RegionStore_write(&store, 43, 40, buffer, REGION_SLOT_PAYLOAD + 1), "an oversized payload was accepted");
+
+    printf("    ✓ Overwrite test passed\n");
+done:
+    RegionStore_close(&reader);
+    RegionStore_close(&store);
+    return passed;
+}
+
+// Region (2, 2) holds something that is not a region file
+#define FOREIGN_PATH REGION_DIR "/r.2.2.bin"
+#define FOREIGN_BYTES "not a region file"
+
+static bool test_foreign_files(void) {
+    printf("  Testing files with an unknown header...\n");
+    bool passed = true;
+    RegionStore store = { 0 }, scratch = { 0 };
+    static uint16_t tiles[CHUNK_AREA], read[CHUNK_AREA];
+    char contents[sizeof(FOREIGN_BYTES)] = { 0 };
+    TEST_EXPECT(RegionStore_open(&store, REGION_DIR), "the store could not be opened");
+    FILE* file = fopen(FOREIGN_PATH, "wb");
+    TEST_EXPECT(file != NULL, "the foreign file could not be created");
+    fputs(FOREIGN_BYTES, file);
+    fclose(file);
+
+    // A save's store fails instead of truncating what it cannot read
+    fill_pattern(tiles, 0);
+    TEST_EXPECT(!RegionStore_read_tiles(&store, 64, 64, read), "a foreign file was read as a region");
+    TEST_EXPECT(!RegionStore_write_tiles(&store, 64, 64, tiles), "a write went into a foreign file");
+    RegionStore_close(&store);
+    file = fopen(FOREIGN_PATH, "rb");
+    TEST_EXPECT(file != NULL, "the foreign file was removed");
+    size_t length = fread(contents, 1, sizeof(contents), file);
+    fclose(file);
+    TEST_EXPECT(length == strlen(FOREIGN_BYTES) && strcmp(contents, FOREIGN_BYTES) == 0, "the foreign file was changed");
+
+    // The page cache starts the region over
+    TEST_EXPECT(RegionStore_open_scratch(&scratch, REGION_DIR), "the scratch store could not be opened");
+    TEST_EXPECT(RegionStore_write_tiles(&scratch, 64, 64, tiles), "the scratch store did not start the region over");
+    TEST_EXPECT(RegionStore_read_tiles(&scratch, 64, 64, read), "the restarted region could not be read");
+    TEST_EXPECT(memcmp(tiles, read, sizeof(tiles)) == 0, "the restarted region changed the tiles");
+
+    printf("    ✓ Unknown header test passed\n");
+done:
+    RegionStore_close(&scratch);
+    RegionStore_close(&store);
+    return passed;
+}
+
+// Main test function for the region_store module
+bool test_region_store(void) {
+    bool all_passed = true;
+
+    all_passed &= test_round_trip();
+    all_passed &= test_overwrite_and_readers();
+    all_passed &= test_foreign_files();
+
+    remove_regions();
+    return all_passed;
+}
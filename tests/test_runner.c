@@ -10,14 +10,33 @@ typedef struct {
 } TestCase;
 
 // Forward declarations for test modules
+#ifdef TEST_LEGACY_CORE
+// Written against the old in-tree src/core, which now lives in gramarye-libcore
 extern bool test_int_coord_hash(void);
 extern bool test_table_operations(void);
+#endif
+extern bool test_world(void);
+extern bool test_region_store(void);
+extern bool test_save_system(void);
+extern bool test_spatial_index(void);
+extern bool test_ui_hit_test(void);
+extern bool test_tile_storage(void);
+extern bool test_floor_system(void);
 // Add more test modules here as they're created
 
 // Test registry
 static TestCase test_registry[] = {
+#ifdef TEST_LEGACY_CORE
     { "int_coord_hash", test_int_coord_hash },
     { "table_operations", test_table_operations },
+#endif
+    { "world", test_world },
+    { "region_store", test_region_store },
+    { "save_system", test_save_system },
+    { "spatial_index", test_spatial_index },
+    { "ui_hit_test", test_ui_hit_test },
+    { "tile_storage", test_tile_storage },
+    { "floor_system", test_floor_system },
     { NULL, NULL } // Sentinel
 };
 
@@ -88,7 +107,7 @@ static void print_usage(const char *program_name) {
     printf("\nExamples:\n");
     printf("  %s                    # Run all tests\n", program_name);
     printf("  %s -a                 # Run all tests\n", program_name);
-    printf("  %s int_coord_hash     # Run specific test\n", program_name);
+    printf("  %s world              # Run specific test\n", program_name);
     printf("  %s --list             # List all tests\n", program_name);
 }
 
@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "systems/save_system.h"
+#include "test_common.h"
+
+#define SAVE_DIR "test_save_system"
+
+// The edits below touch chunks (0, 0) and (-1, -1), in regions (0, 0) and (-1, -1)
+static void remove_save(void) {
+    static const char* const names[] = { "snapshot.bin", "snapshot.tmp", "r.0.0.bin", "r.-1.-1.bin" };
+    char path[REGION_PATH_MAX];
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        snprintf(path, sizeof(path), "%s/%s", SAVE_DIR, names[i]);
+        remove(path);
+    }
+    for (int segment = 1; segment <= 8; segment++) {
+        snprintf(path, sizeof(path), "%s/journal.%d.bin", SAVE_DIR, segment);
+        remove(path);
+    }
+    remove(SAVE_DIR);
+}
+
+// Applies an edit and records it, as TileUpdateSystem does
+static void edit_tile(SaveSystem* sys, int x, int y, uint16_t tile_id) {
+    World_set_tile(sys->world, x, y, tile_id);
+    TileJournal_set(&sys->journal, x, y, tile_id);
+}
+
+static void edit_fill(SaveSystem* sys, int x, int y, int width, int height, uint16_t tile_id) {
+    World_fill_rect(sys->world, x, y, width, height, tile_id);
+    TileJournal_fill(&sys->journal, x, y, width, height, tile_id);
+}
+
+// Restored chunks only exist once generated from their snapshot, which
+// World_get_tile does not do; the game requests them through ChunkStreamSystem
+static uint16_t tile_at(World* world, int x, int y) {
+    uint16_t tile;
+    World_read_rect(world, x, y, 1, 1, &tile);
+    return tile;
+}
+
+static bool expect_edits(World* world) {
+    return tile_at(world, 0, 0) == 4 && tile_at(world, -1, -1) == 5 &&
+           tile_at(world, 10, 12) == 6 && tile_at(world, 9, 9) == TILE_NONE;
+}
+
+static bool test_journal_replay(void) {
+    printf("  Testing journal replay after close...\n");
+    bool passed = true;
+    SaveSystem sys = { 0 };
+    World* world = World_new(NULL);
+    World* restored = World_new(NULL);
+    remove_save();
+
+    TEST_EXPECT(SaveSystem_open(&sys, world, SAVE_DIR), "the save could not be opened");
+    TEST_EXPECT(sys.replayed == 0, "a new save should have nothing to replay");
+    edit_tile(&sys, 0, 0, 4);
+    edit_tile(&sys, -1, -1, 5);
+    SaveSystem_update(&sys);
+    edit_fill(&sys, 10, 10, 3, 3, 6);
+    SaveSystem_close(&sys);
+    TEST_EXPECT(sys.failures == 0, "the journal reported write failures");
+
+    // No autosave ran, so all three records come back from the journal
+    TEST_EXPECT(SaveSystem_open(&sys, restored, SAVE_DIR), "the save could not be reopened");
+    TEST_EXPECT(sys.replayed == 3, "every journaled edit should be replayed");
+    TEST_EXPECT(expect_edits(restored), "the replayed world differs from the edited one");
+    SaveSystem_close(&sys);
+
+    printf("    ✓ Journal replay test passed\n");
+done:
+    SaveSystem_close(&sys);
+    World_free(restored);
+    World_free(world);
+    return passed;
+}
+
+static bool test_snapshot_restore(void) {
+    printf("  Testing restore from an autosave snapshot...\n");
+    bool passed = true;
+    SaveSystem sys = { 0 };
+    World* world = World_new(NULL);
+    World* restored = World_new(NULL);
+    remove_save();
+
+    TEST_EXPECT(SaveSystem_open(&sys, world, SAVE_DIR), "the save could not be opened");
+    edit_tile(&sys, 0, 0, 4);
+    edit_tile(&sys, -1, -1, 5);
+    edit_fill(&sys, 10, 10, 3, 3, 6);
+    sys.framesSinceSave = SAVE_AUTOSAVE_FRAMES;  // due now
+    SaveSystem_update(&sys);
+
+    // The writer may still be saving: an unrecorded write must not reach the
+    // frozen chunks, and a recorded one goes to the next segment
+    World_set_tile(world, 1, 1, 7);
+    edit_tile(&sys, -20, -20, 8);
+    SaveSystem_close(&sys);
+    TEST_EXPECT(sys.saves == 1 && sys.failures == 0, "the autosave did not complete");
+    TEST_EXPECT(sys.savedChunks == 2, "both edited chunks should be saved");
+
+    // Tiles come back from the snapshot; only the edit after it is replayed
+    TEST_EXPECT(SaveSystem_open(&sys, restored, SAVE_DIR), "the save could not be reopened");
+    TEST_EXPECT(sys.replayed == 1, "segments covered by the snapshot were replayed");
+    TEST_EXPECT(expect_edits(restored), "the restored world differs from the saved one");
+    TEST_EXPECT(tile_at(restored, -20, -20) == 8, "the edit after the autosave was lost");
+    TEST_EXPECT(tile_at(restored, 1, 1) == TILE_NONE, "a write after the freeze leaked into the snapshot");
+    SaveSystem_close(&sys);
+
+    printf("    ✓ Snapshot restore test passed\n");
+done:
+    SaveSystem_close(&sys);
+    World_free(restored);
+    World_free(world);
+    return passed;
+}
+
+// A crash mid-save can leave a snapshot newer than the journal segment
+// replayed over it; a region copy must still replay to the tiles it copied
+static bool test_copy_replay(void) {
+    printf("  Testing region copies replayed over newer tiles...\n");
+    bool passed = true;
+    TileJournal journal;
+    TileJournal_init(&journal);
+    World* world = World_new(NULL);
+    World* restored = World_new(NULL);
+
+    World_fill_rect(world, 0, 0, 2, 2, 4);
+    World_copy_region(world, 0, 0, 2, 2, 10, 10);
+    TEST_EXPECT(TileJournal_copy(&journal, world, 10, 10, 2, 2), "the copy could not be recorded");
+    TEST_EXPECT(journal.records == 1 && journal.data[0] == TILE_JOURNAL_BLIT, "the copy should be journaled as a blit");
+
+    // The restored world already has a later edit to the copy's source
+    World_fill_rect(restored, 0, 0, 2, 2, 9);
+    for (int pass = 0; pass < 2; pass++) {
+        TEST_EXPECT(TileJournal_replay(restored, journal.data, journal.size) == 1, "the record did not replay");
+        TEST_EXPECT(tile_at(restored, 10, 10) == 4 && tile_at(restored, 11, 11) == 4, "the copy replayed the newer source");
+    }
+
+    printf("    ✓ Copy replay test passed\n");
+done:
+    TileJournal_free(&journal);
+    World_free(restored);
+    World_free(world);
+    return passed;
+}
+
+// Main test function for the save_system module
+bool test_save_system(void) {
+    bool all_passed = true;
+
+    all_passed &= test_journal_replay();
+    all_passed &= test_snapshot_restore();
+    all_passed &= test_copy_replay();
+
+    remove_save();
+    return all_passed;
+}
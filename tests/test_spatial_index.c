@@ -0,0 +1,130 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "components/spatial_index.h"
+#include "test_common.h"
+
+#define ENTITY_COUNT 500
+
+// Reference positions, checked against by brute force
+typedef struct Reference {
+    int x[ENTITY_COUNT];
+    int y[ENTITY_COUNT];
+    int handle[ENTITY_COUNT];
+    bool live[ENTITY_COUNT];
+} Reference;
+
+static int brute_rect(const Reference* ref, int x, int y, int width, int height) {
+    int count = 0;
+    for (int i = 0; i < ENTITY_COUNT; i++) {
+        if (ref->live[i] && ref->x[i] >= x && ref->x[i] < x + width && ref->y[i] >= y && ref->y[i] < y + height) count++;
+    }
+    return count;
+}
+
+static int brute_radius(const Reference* ref, int centerX, int centerY, int radius) {
+    int count = 0;
+    for (int i = 0; i < ENTITY_COUNT; i++) {
+        long dx = ref->x[i] - centerX, dy = ref->y[i] - centerY;
+        if (ref->live[i] && dx * dx + dy * dy <= (long)radius * radius) count++;
+    }
+    return count;
+}
+
+static bool test_queries_match_brute_force(void) {
+    printf("  Testing queries against a brute-force scan...\n");
+    bool passed = true;
+    SpatialIndex index;
+    SpatialIndex_init(&index, 4);
+    static Reference ref;
+    static SpatialHit hits[ENTITY_COUNT];
+    srand(3);
+
+    for (int i = 0; i < ENTITY_COUNT; i++) {
+        ref.x[i] = rand() % 2000 - 1000;
+        ref.y[i] = rand() % 2000 - 1000;
+        ref.handle[i] = SpatialIndex_insert(&index, (EntityId)i, ref.x[i], ref.y[i]);
+        ref.live[i] = true;
+    }
+
+    // Random moves, removals and reinserts, with small queries (cell lookups)
+    // alternating with ones spanning more cells than are occupied (occupied scan)
+    for (int step = 0; step < 3000; step++) {
+        int i = rand() % ENTITY_COUNT;
+        if (ref.live[i] && rand() % 4 == 0) {
+            SpatialIndex_remove(&index, ref.handle[i]);
+            ref.live[i] = false;
+        } else if (ref.live[i]) {
+            ref.x[i] += rand() % 41 - 20;
+            ref.y[i] += rand() % 41 - 20;
+            SpatialIndex_move(&index, ref.handle[i], ref.x[i], ref.y[i]);
+        } else {
+            ref.handle[i] = SpatialIndex_insert(&index, (EntityId)i, ref.x[i], ref.y[i]);
+            ref.live[i] = true;
+        }
+
+        int span = step % 2 ? 2000 : 40;
+        int x = rand() % 2400 - 1200, y = rand() % 2400 - 1200;
+        int width = rand() % span + 1, height = rand() % span + 1;
+        int found = SpatialIndex_query_rect(&index, x, y, width, height, hits, ENTITY_COUNT);
+        TEST_EXPECT(found == brute_rect(&ref, x, y, width, height), "query_rect disagrees with the scan");
+        for (int h = 0; h < found; h++) {
+            int e = (int)hits[h].entity;
+            TEST_EXPECT(ref.live[e] && hits[h].x == ref.x[e] && hits[h].y == ref.y[e], "query_rect returned a stale position");
+        }
+
+        int radius = rand() % 300;
+        found = SpatialIndex_query_radius(&index, x, y, radius, hits, ENTITY_COUNT);
+        TEST_EXPECT(found == brute_radius(&ref, x, y, radius), "query_radius disagrees with the scan");
+    }
+
+    printf("    ✓ Brute-force comparison passed\n");
+done:
+    SpatialIndex_free(&index);
+    return passed;
+}
+
+static bool test_handles_and_revision(void) {
+    printf("  Testing handle reuse and revisions...\n");
+    bool passed = true;
+    SpatialIndex index;
+    SpatialIndex_init(&index, 2);
+    SpatialHit hits[4];
+
+    int a = SpatialIndex_insert(&index, 1, -1, -1);
+    int b = SpatialIndex_insert(&index, 2, 0, 0);
+    TEST_EXPECT(a >= 0 && b >= 0 && a != b, "inserts should return distinct handles");
+    TEST_EXPECT(SpatialIndex_query_rect(&index, -1, -1, 1, 1, hits, 4) == 1 && hits[0].entity == 1,
+                "(-1, -1) should be found in the cell left of the origin");
+
+    uint32_t revision = index.revision;
+    SpatialIndex_move(&index, a, -1, -1);
+    SpatialIndex_move(&index, a, 40, 40);
+    TEST_EXPECT(index.revision != revision, "a move should bump the revision");
+    TEST_EXPECT(SpatialIndex_query_rect(&index, -1, -1, 1, 1, hits, 4) == 0, "the old cell still holds the entity");
+
+    SpatialIndex_remove(&index, a);
+    TEST_EXPECT(index.itemCount == 1, "remove should release the handle");
+    int c = SpatialIndex_insert(&index, 3, 5, 5);
+    TEST_EXPECT(c == a, "a released handle should be reused");
+
+    // A short buffer still reports every match, so the caller can grow it
+    SpatialIndex_insert(&index, 4, 6, 6);
+    TEST_EXPECT(SpatialIndex_query_rect(&index, 0, 0, 8, 8, hits, 1) == 3, "a short buffer should not cut the count");
+
+    printf("    ✓ Handle and revision test passed\n");
+done:
+    SpatialIndex_free(&index);
+    return passed;
+}
+
+// Main test function for the spatial_index module
+bool test_spatial_index(void) {
+    bool all_passed = true;
+
+    all_passed &= test_queries_match_brute_force();
+    all_passed &= test_handles_and_revision();
+
+    return all_passed;
+}
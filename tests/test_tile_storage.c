@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "components/tile_storage.h"
+#include "test_common.h"
+
+#define TABLE_SIZE 96
+
+// Every test below runs once per backend; the table is TABLE_SIZE square, so
+// the rectangles stay inside it and cross chunk boundaries at 64. Untouched
+// tiles are compared against a read of one, since a new Tilemap's tiles are
+// the library's default rather than TILE_NONE.
+static bool init_storage(TileStorage* storage, Arena_T arena, TileStorageMode mode) {
+    if (mode == TILE_STORAGE_TABLE) return TileStorage_init_table(storage, arena, TABLE_SIZE, TABLE_SIZE);
+    return TileStorage_init_chunked(storage, arena);
+}
+
+static const char* mode_name(TileStorageMode mode) {
+    return mode == TILE_STORAGE_TABLE ? "table" : "chunked";
+}
+
+static bool expect_rect(TileStorage* storage, int x, int y, int width, int height, uint16_t tile_id) {
+    for (int row = y; row < y + height; row++) {
+        for (int col = x; col < x + width; col++) {
+            if (TileStorage_get_tile(storage, col, row) != tile_id) return false;
+        }
+    }
+    return true;
+}
+
+static bool test_tiles(TileStorageMode mode) {
+    printf("  Testing single tiles, %s storage...\n", mode_name(mode));
+    bool passed = true;
+    Arena_T arena = Arena_new();
+    TileStorage storage = { 0 };
+    TEST_EXPECT(init_storage(&storage, arena, mode), "the storage could not be created");
+    TEST_EXPECT(storage.mode == mode, "the storage reports the wrong backend");
+
+    uint16_t blank = TileStorage_get_tile(&storage, 6, 5);
+    TileStorage_set_tile(&storage, 5, 5, 3);
+    TileStorage_set_tile(&storage, 70, 65, 4);
+    TEST_EXPECT(TileStorage_get_tile(&storage, 5, 5) == 3, "tile (5, 5) did not read back");
+    TEST_EXPECT(TileStorage_get_tile(&storage, 70, 65) == 4, "tile (70, 65) did not read back");
+    TEST_EXPECT(TileStorage_get_tile(&storage, 6, 5) == blank, "a neighbouring tile changed");
+
+    // The table drops writes outside it; the world has no edge
+    TileStorage_set_tile(&storage, -1, -1, 5);
+    uint16_t outside = mode == TILE_STORAGE_TABLE ? TILE_NONE : 5;
+    TEST_EXPECT(TileStorage_get_tile(&storage, -1, -1) == outside, "a write outside the map was handled wrongly");
+
+    int x, y, width, height;
+    TEST_EXPECT(TileStorage_get_bounds(&storage, &x, &y, &width, &height), "the map should have bounds");
+    TEST_EXPECT(x <= 0 && y <= 0 && x + width >= 71 && y + height >= 66, "the bounds miss a written tile");
+
+    printf("    ✓ Single tile test passed\n");
+done:
+    TileStorage_free(&storage);
+    Arena_dispose(&arena);
+    return passed;
+}
+
+static bool test_bulk_operations(TileStorageMode mode) {
+    printf("  Testing bulk operations, %s storage...\n", mode_name(mode));
+    bool passed = true;
+    Arena_T arena = Arena_new();
+    TileStorage storage = { 0 };
+    TEST_EXPECT(init_storage(&storage, arena, mode), "the storage could not be created");
+    uint16_t blank = TileStorage_get_tile(&storage, 0, 0);
+
+    // 60..69 crosses the chunk edge at 64: two columns by two rows of blocks
+    TEST_EXPECT(TileStorage_fill_rect(&storage, 60, 60, 10, 10, 2) == 4, "the fill should touch four blocks");
+    TEST_EXPECT(expect_rect(&storage, 60, 60, 10, 10, 2), "the fill did not cover its rectangle");
+    TEST_EXPECT(TileStorage_get_tile(&storage, 59, 60) == blank, "the fill spilled left");
+    TEST_EXPECT(TileStorage_get_tile(&storage, 60, 70) == blank, "the fill spilled down");
+
+    uint16_t src[4 * 3];
+    for (int i = 0; i < 4 * 3; i++) src[i] = (uint16_t)(10 + i);
+    TEST_EXPECT(TileStorage_blit(&storage, 8, 8, 4, 3, src, 4) == 1, "the blit should touch one block");
+    TEST_EXPECT(TileStorage_get_tile(&storage, 8, 8) == 10, "the blit's first tile is wrong");
+    TEST_EXPECT(TileStorage_get_tile(&storage, 11, 10) == 21, "the blit's last tile is wrong");
+
+    // A zero stride repeats the first row
+    TileStorage_blit(&storage, 0, 20, 4, 2, src, 0);
+    TEST_EXPECT(TileStorage_get_tile(&storage, 2, 21) == 12, "a zero-stride blit should repeat its first row");
+
+    // Overlapping copy, one tile right and down
+    TEST_EXPECT(TileStorage_copy_region(&storage, 8, 8, 4, 3, 9, 9) > 0, "the copy touched nothing");
+    TEST_EXPECT(TileStorage_get_tile(&storage, 9, 9) == 10, "the overlapping copy read tiles it had written");
+    TEST_EXPECT(TileStorage_get_tile(&storage, 12, 11) == 21, "the copy's last tile is wrong");
+    TEST_EXPECT(TileStorage_get_tile(&storage, 8, 8) == 10, "the copy changed its source outside the overlap");
+
+    // The table clips to its edge; the world takes the whole rectangle
+    TileStorage_fill_rect(&storage, TABLE_SIZE - 2, 0, 4, 1, 6);
+    TEST_EXPECT(expect_rect(&storage, TABLE_SIZE - 2, 0, 2, 1, 6), "the fill inside the table edge was lost");
+    uint16_t beyond = mode == TILE_STORAGE_TABLE ? TILE_NONE : 6;
+    TEST_EXPECT(TileStorage_get_tile(&storage, TABLE_SIZE, 0) == beyond, "the fill past the table edge was handled wrongly");
+
+    printf("    ✓ Bulk operations test passed\n");
+done:
+    TileStorage_free(&storage);
+    Arena_dispose(&arena);
+    return passed;
+}
+
+// Main test function for the tile_storage module
+bool test_tile_storage(void) {
+    bool all_passed = true;
+    static const TileStorageMode modes[] = { TILE_STORAGE_TABLE, TILE_STORAGE_CHUNKED };
+
+    for (size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); i++) {
+        all_passed &= test_tiles(modes[i]);
+        all_passed &= test_bulk_operations(modes[i]);
+    }
+
+    return all_passed;
+}
@@ -0,0 +1,77 @@
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "components/ui_hit_test.h"
+#include "test_common.h"
+
+static uint32_t hit_id(const UIHitTest* hits, float x, float y) {
+    const UIHitRegion* region = UIHitTest_find(hits, (Vector2){ x, y });
+    return region ? region->id : 0;
+}
+
+static bool test_topmost_region(void) {
+    printf("  Testing topmost region lookup...\n");
+    bool passed = true;
+    UIHitTest hits;
+    UIHitTest_clear(&hits);
+
+    // Added bottom first; a dropdown (z 10) over a panel (z 0), and a tooltip passthrough on top
+    UIHitTest_add(&hits, 1, (Rectangle){ 0, 0, 200, 100 }, 0, true);
+    UIHitTest_add(&hits, 2, (Rectangle){ 50, 50, 100, 100 }, 10, true);
+    UIHitTest_add(&hits, 3, (Rectangle){ 60, 60, 20, 20 }, 20, false);
+    UIHitTest_add(&hits, 4, (Rectangle){ 150, 0, 50, 50 }, 0, true);
+
+    TEST_EXPECT(hits.regions[0].id == 3 && hits.regions[1].id == 2, "regions should be kept highest zIndex first");
+    TEST_EXPECT(hits.regions[2].id == 1 && hits.regions[3].id == 4, "equal zIndex should keep insertion order");
+
+    TEST_EXPECT(hit_id(&hits, 10, 10) == 1, "the panel should capture its own area");
+    TEST_EXPECT(hit_id(&hits, 70, 70) == 2, "the dropdown should win over the panel, through the tooltip");
+    TEST_EXPECT(hit_id(&hits, 120, 120) == 2, "the dropdown should capture outside the panel");
+    TEST_EXPECT(hit_id(&hits, 160, 10) == 1, "equal zIndex should go to the region added first");
+    TEST_EXPECT(hit_id(&hits, 300, 300) == 0, "a point outside every region should reach the world");
+
+    // Bounds are half-open, like the layout rectangles they come from
+    TEST_EXPECT(hit_id(&hits, 199.5f, 99.5f) == 1, "the last pixel inside should hit");
+    TEST_EXPECT(hit_id(&hits, 200, 10) == 0, "the right edge should be outside");
+
+    printf("    ✓ Topmost region test passed\n");
+done:
+    return passed;
+}
+
+static bool test_remove_and_capacity(void) {
+    printf("  Testing remove and a full table...\n");
+    bool passed = true;
+    UIHitTest hits;
+    UIHitTest_clear(&hits);
+
+    UIHitTest_add(&hits, 1, (Rectangle){ 0, 0, 100, 100 }, 0, true);
+    UIHitTest_add(&hits, 2, (Rectangle){ 0, 0, 50, 50 }, 5, true);
+    UIHitTest_remove(&hits, 2);
+    TEST_EXPECT(hits.count == 1 && hit_id(&hits, 10, 10) == 1, "a removed region should stop capturing");
+    UIHitTest_remove(&hits, 99);
+    TEST_EXPECT(hits.count == 1, "removing an unknown id should do nothing");
+
+    for (uint32_t id = 10; id < 10 + UI_HIT_TEST_MAX_REGIONS; id++) {
+        UIHitTest_add(&hits, id, (Rectangle){ 500, 500, 10, 10 }, 1, true);
+    }
+    TEST_EXPECT(hits.count == UI_HIT_TEST_MAX_REGIONS, "the table should stop at its capacity");
+    TEST_EXPECT(hit_id(&hits, 10, 10) == 1, "regions recorded before the table filled should still be found");
+
+    UIHitTest_clear(&hits);
+    TEST_EXPECT(hits.count == 0 && hit_id(&hits, 10, 10) == 0, "clear should drop every region");
+
+    printf("    ✓ Remove and capacity test passed\n");
+done:
+    return passed;
+}
+
+// Main test function for the ui_hit_test module
+bool test_ui_hit_test(void) {
+    bool all_passed = true;
+
+    all_passed &= test_topmost_region();
+    all_passed &= test_remove_and_capacity();
+
+    return all_passed;
+}
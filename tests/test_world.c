@@ -0,0 +1,415 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "components/world.h"
+#include "test_common.h"
+
+#define PAGE_DIR "test_world_pages"
+#define CHUNK_BYTES ((size_t)CHUNK_AREA * sizeof(uint16_t))
+
+// Every test pages into chunks around the origin, so regions -1 and 0 cover them
+static void remove_pages(void) {
+    char path[REGION_PATH_MAX];
+    for (int ry = -1; ry <= 0; ry++) {
+        for (int rx = -1; rx <= 0; rx++) {
+            snprintf(path, sizeof(path), "%s/r.%d.%d.bin", PAGE_DIR, rx, ry);
+            remove(path);
+        }
+    }
+    remove(PAGE_DIR);
+}
+
+static Chunk* chunk_at(World* world, int chunkX, int chunkY) {
+    return (Chunk*)ChunkMap_get(&world->chunks, chunkX, chunkY);
+}
+
+// Chunk (x, y) is x * 10 + y plus a small pattern; chunks with x < 0 are left empty
+static int generatorCalls;
+
+static bool test_generator(void* userData, int chunkX, int chunkY, uint32_t seed, uint16_t* tiles) {
+    (void)userData;
+    (void)seed;
+    generatorCalls++;
+    if (chunkX < 0) return false;
+    for (int i = 0; i < CHUNK_AREA; i++) tiles[i] = (uint16_t)(chunkX * 10 + chunkY + i % 3);
+    return true;
+}
+
+static bool test_sparse_storage(void) {
+    printf("  Testing sparse storage and negative coordinates...\n");
+    bool passed = true;
+    World* world = World_new(NULL);
+    TEST_EXPECT(world != NULL, "World_new returned NULL");
+
+    TEST_EXPECT(World_get_tile(world, 5, 5) == TILE_NONE, "an untouched tile should read TILE_NONE");
+    TEST_EXPECT(!World_get_bounds(world, NULL, NULL, NULL, NULL), "an empty world should have no bounds");
+    TEST_EXPECT(world->chunks.count == 0, "reading should not create chunks");
+
+    World_set_tile(world, -1, -1, 7);
+    World_set_tile(world, -65, 64, 8);
+    World_set_tile(world, 130, 3, 9);
+    TEST_EXPECT(World_get_tile(world, -1, -1) == 7, "tile (-1, -1) did not read back");
+    TEST_EXPECT(World_get_tile(world, -65, 64) == 8, "tile (-65, 64) did not read back");
+    TEST_EXPECT(World_get_tile(world, 130, 3) == 9, "tile (130, 3) did not read back");
+    TEST_EXPECT(World_get_tile(world, 0, 0) == TILE_NONE, "a neighbouring chunk should stay empty");
+    TEST_EXPECT(chunk_at(world, -1, -1) != NULL, "(-1, -1) should live in chunk (-1, -1)");
+    TEST_EXPECT(chunk_at(world, -2, 1) != NULL, "(-65, 64) should live in chunk (-2, 1)");
+    TEST_EXPECT(chunk_at(world, 2, 0) != NULL, "(130, 3) should live in chunk (2, 0)");
+    TEST_EXPECT(world->chunks.count == 3, "only the written chunks should exist");
+
+    int x, y, width, height;
+    TEST_EXPECT(World_get_bounds(world, &x, &y, &width, &height), "bounds missing");
+    TEST_EXPECT(x == -2 * CHUNK_SIZE && y == -CHUNK_SIZE, "bounds origin should be chunk (-2, -1)");
+    TEST_EXPECT(width == 5 * CHUNK_SIZE && height == 3 * CHUNK_SIZE, "bounds should span chunks -2..2 by -1..1");
+
+    Chunk* chunk = chunk_at(world, -1, -1);
+    uint32_t revision = chunk->revision;
+    World_set_tile(world, -1, -1, 7);
+    TEST_EXPECT(chunk->revision == revision, "writing the same tile should not bump the revision");
+    World_set_tile(world, -2, -1, 7);
+    TEST_EXPECT(chunk->revision == revision + 1, "a change should bump the revision once");
+
+    printf("    ✓ Sparse storage test passed\n");
+done:
+    World_free(world);
+    return passed;
+}
+
+static bool test_bulk_operations(void) {
+    printf("  Testing bulk region operations...\n");
+    bool passed = true;
+    World* world = World_new(NULL);
+
+    // A rectangle straddling the origin touches four chunks, each bumped once
+    int touched = World_fill_rect(world, -10, -10, 20, 20, 2);
+    TEST_EXPECT(touched == 4, "fill across the origin should touch 4 chunks");
+    uint32_t before = chunk_at(world, -1, -1)->revision;
+    uint32_t beforeOrigin = chunk_at(world, 0, 0)->revision;
+    World_fill_rect(world, -10, -10, 20, 20, 3);
+    TEST_EXPECT(chunk_at(world, -1, -1)->revision == before + 1 && chunk_at(world, 0, 0)->revision == beforeOrigin + 1,
+                "each filled chunk should bump its revision exactly once");
+    TEST_EXPECT(World_get_tile(world, -10, -10) == 3 && World_get_tile(world, 9, 9) == 3, "fill corners missing");
+    TEST_EXPECT(World_get_tile(world, 10, 9) == TILE_NONE, "fill wrote past its right edge");
+
+    uint16_t row[4] = { 1, 2, 3, 4 };
+    World_blit(world, 62, 0, 4, 2, row, 0);
+    TEST_EXPECT(World_get_tile(world, 63, 1) == 2 && World_get_tile(world, 64, 1) == 3,
+                "a zero-stride blit should repeat its row across the chunk edge");
+
+    // Overlapping copy one tile to the right: every tile takes its left neighbour's old value
+    World_copy_region(world, 62, 0, 4, 1, 63, 0);
+    uint16_t expected[5] = { 1, 1, 2, 3, 4 };
+    for (int i = 0; i < 5; i++) {
+        TEST_EXPECT(World_get_tile(world, 62 + i, 0) == expected[i], "overlapping copy_region smeared its source");
+    }
+
+    uint16_t block[3 * 2];
+    World_read_rect(world, 63, 0, 3, 2, block);
+    TEST_EXPECT(block[0] == 1 && block[1] == 2 && block[2] == 3, "read_rect first row wrong");
+    TEST_EXPECT(block[3] == 2 && block[4] == 3 && block[5] == 4, "read_rect second row wrong");
+
+    printf("    ✓ Bulk operations test passed\n");
+done:
+    World_free(world);
+    return passed;
+}
+
+static bool test_eviction_budget(void) {
+    printf("  Testing eviction to the resident budget...\n");
+    bool passed = true;
+    World* world = World_new(NULL);
+    TEST_EXPECT(World_enable_paging(world, PAGE_DIR, 2 * CHUNK_BYTES), "paging could not be enabled");
+
+    for (int i = 0; i < 4; i++) World_set_tile(world, i * CHUNK_SIZE, 0, (uint16_t)(100 + i));
+    TEST_EXPECT(world->stats.residentChunks == 4, "four chunks should be resident");
+
+    // Everything was used this frame, so nothing may go yet
+    TEST_EXPECT(World_evict_cold(world) == 0, "chunks used this frame were evicted");
+
+    // Next frame only chunk 3 is used; the two least recently used go
+    World_get_chunk(world, 3, 0);
+    TEST_EXPECT(World_evict_cold(world) == 2, "two chunks should be evicted to reach the budget");
+    TEST_EXPECT((size_t)world->stats.residentBytes <= 2 * CHUNK_BYTES, "tile memory is over budget");
+    TEST_EXPECT(!chunk_at(world, 0, 0)->resident && !chunk_at(world, 1, 0)->resident,
+                "the least recently used chunks should be the ones evicted");
+    TEST_EXPECT(chunk_at(world, 2, 0)->resident && chunk_at(world, 3, 0)->resident,
+                "the most recently used chunks should stay resident");
+    TEST_EXPECT(world->stats.pageOuts == 2, "edited chunks should be written out");
+
+    // Reading an evicted chunk pages it back in with its edit
+    TEST_EXPECT(World_get_tile(world, 0, 0) == 100, "chunk 0 lost its tile across a page out");
+    TEST_EXPECT(World_get_tile(world, CHUNK_SIZE, 0) == 101, "chunk 1 lost its tile across a page out");
+    TEST_EXPECT(world->stats.pageIns == 2, "both chunks should be paged in");
+    TEST_EXPECT(world->stats.failures == 0, "paging reported failures");
+
+    printf("    ✓ Eviction budget test passed\n");
+done:
+    World_free(world);
+    remove_pages();
+    return passed;
+}
+
+static bool test_compression(void) {
+    printf("  Testing compression of aged-out chunks...\n");
+    bool passed = true;
+    World* world = World_new(NULL);
+    World_enable_compression(world, 1);
+
+    World_fill_rect(world, 0, 0, CHUNK_SIZE, CHUNK_SIZE, 5);
+    World_set_tile(world, 3, 3, 6);
+    World_evict_cold(world);
+    World_evict_cold(world);
+    Chunk* chunk = chunk_at(world, 0, 0);
+    TEST_EXPECT(chunk->cold && chunk->packed != NULL && !chunk->resident, "an idle chunk should be compressed");
+    TEST_EXPECT(world->stats.compressedChunks == 1 && world->stats.residentChunks == 0, "stats should count it as compressed");
+
+    TEST_EXPECT(World_get_tile(world, 3, 3) == 6 && World_get_tile(world, 4, 3) == 5, "tiles changed across compression");
+    TEST_EXPECT(chunk->resident && !chunk->cold, "a lookup should restore the chunk to the hot list");
+    TEST_EXPECT(world->stats.decompressions == 1, "the lookup should decompress once");
+
+    printf("    ✓ Compression test passed\n");
+done:
+    World_free(world);
+    return passed;
+}
+
+static bool test_snapshot_copy_on_write(void) {
+    printf("  Testing copy-on-write snapshots...\n");
+    bool passed = true;
+    World* world = World_new(NULL);
+    WorldSnapshot snapshot = { 0 };
+
+    World_set_tile(world, 1, 1, 10);
+    World_set_tile(world, CHUNK_SIZE, 0, 20);
+    TEST_EXPECT(World_freeze(world, &snapshot) == 2, "both changed chunks should be frozen");
+
+    Chunk* chunk = chunk_at(world, 0, 0);
+    const WorldFrozenChunk* frozen = snapshot.chunks[0].chunk == chunk ? &snapshot.chunks[0] : &snapshot.chunks[1];
+    TEST_EXPECT(frozen->tiles == chunk->tiles && chunk->shared, "freezing should share the tiles, not copy them");
+
+    // The first write gives the chunk a private copy; the snapshot keeps the frozen tiles
+    World_set_tile(world, 1, 1, 11);
+    TEST_EXPECT(frozen->tiles != chunk->tiles && !chunk->shared, "a write to a frozen chunk should clone it");
+    TEST_EXPECT(frozen->tiles[Chunk_index(1, 1)] == 10, "the snapshot saw a write made after the freeze");
+    TEST_EXPECT(World_get_tile(world, 1, 1) == 11, "the live chunk lost the write");
+
+    World_release_snapshot(world, &snapshot);
+    TEST_EXPECT(!chunk_at(world, 1, 0)->shared, "release should return an unchanged chunk's buffer to it");
+
+    // Only the chunk edited after the freeze is frozen again
+    TEST_EXPECT(World_freeze(world, &snapshot) == 1 && snapshot.chunks[0].chunk == chunk,
+                "the next freeze should only hold chunks changed since the last one");
+    World_release_snapshot(world, &snapshot);
+    TEST_EXPECT(World_freeze(world, &snapshot) == 0, "a freeze with no changes should be empty");
+
+    printf("    ✓ Snapshot test passed\n");
+done:
+    World_release_snapshot(world, &snapshot);
+    World_snapshot_free(&snapshot);
+    World_free(world);
+    return passed;
+}
+
+static bool test_pinned_chunks(void) {
+    printf("  Testing eviction around chunks pinned by a snapshot...\n");
+    bool passed = true;
+    World* world = World_new(NULL);
+    WorldSnapshot snapshot = { 0 };
+    World_enable_paging(world, PAGE_DIR, 0);
+
+    // Chunk a is frozen while paged out, so the snapshot reads its region slot
+    World_set_tile(world, 0, 0, 1);
+    World_evict_cold(world);
+    World_evict_cold(world);
+    Chunk* a = chunk_at(world, 0, 0);
+    TEST_EXPECT(!a->resident, "chunk a should be paged out");
+    World_freeze(world, &snapshot);
+    TEST_EXPECT(a->pinned, "freezing a paged-out chunk should pin it");
+
+    // a is edited and becomes the least recently used chunk; it must be stepped over, not end the walk
+    World_set_tile(world, 0, 0, 2);
+    World_set_tile(world, 100, 0, 3);
+    World_evict_cold(world);
+    World_evict_cold(world);
+    Chunk* b = chunk_at(world, 1, 0);
+    TEST_EXPECT(a->resident, "a pinned, edited chunk was written over its frozen slot");
+    TEST_EXPECT(!b->resident, "the chunk behind the pinned one should still be evicted");
+
+    World_release_snapshot(world, &snapshot);
+    World_evict_cold(world);
+    TEST_EXPECT(!a->resident, "the released chunk should be evicted");
+    TEST_EXPECT(World_get_tile(world, 0, 0) == 2, "the edit made while pinned was lost");
+
+    printf("    ✓ Pinned chunk test passed\n");
+done:
+    World_release_snapshot(world, &snapshot);
+    World_snapshot_free(&snapshot);
+    World_free(world);
+    remove_pages();
+    return passed;
+}
+
+static bool test_generated_chunks(void) {
+    printf("  Testing generated chunks: empty results and regeneration...\n");
+    bool passed = true;
+    World* world = World_new(NULL);
+    World_enable_paging(world, PAGE_DIR, 0);
+    World_set_generator(world, test_generator, NULL, 1);
+    generatorCalls = 0;
+
+    for (int i = 0; i < 5; i++) {
+        TEST_EXPECT(World_request_chunk(world, -1, 0) == NULL, "the generator left (-1, 0) empty");
+    }
+    TEST_EXPECT(generatorCalls == 1, "an empty result should be remembered, not generated again");
+
+    TEST_EXPECT(World_request_chunk(world, 0, 0) && World_request_chunk(world, 1, 0), "generated chunks missing");
+    World_set_tile(world, CHUNK_SIZE, 0, 77);  // only chunk (1, 0) is edited
+    World_evict_cold(world);
+    World_evict_cold(world);
+    Chunk* pristine = chunk_at(world, 0, 0);
+    Chunk* edited = chunk_at(world, 1, 0);
+    TEST_EXPECT(world->stats.dropped == 1 && !pristine->stored, "the unedited chunk should be dropped, not written");
+    TEST_EXPECT(world->stats.pageOuts == 1 && edited->stored, "the edited chunk should be written");
+
+    TEST_EXPECT(World_get_tile(world, 1, 0) == 1, "a dropped chunk should come back from the generator");
+    TEST_EXPECT(World_get_tile(world, CHUNK_SIZE, 0) == 77, "the edited chunk lost its edit");
+    TEST_EXPECT(World_get_tile(world, CHUNK_SIZE + 1, 0) == 11, "the edited chunk lost its generated tiles");
+    TEST_EXPECT(world->stats.pageIns == 1, "only the edited chunk should be read from disk");
+
+    printf("    ✓ Generated chunk test passed\n");
+done:
+    World_free(world);
+    remove_pages();
+    return passed;
+}
+
+// Loader that only records what it was handed; the test plays the worker
+static Chunk* queuedLoads[4];
+static int queuedCount;
+
+static bool test_loader(void* userData, Chunk* chunk) {
+    (void)userData;
+    if (queuedCount == 4) return false;
+    queuedLoads[queuedCount++] = chunk;
+    return true;
+}
+
+static bool test_async_loads(void) {
+    printf("  Testing asynchronous loads of paged-out and dropped chunks...\n");
+    bool passed = true;
+    World* world = World_new(NULL);
+    World_enable_paging(world, PAGE_DIR, 0);
+    World_set_generator(world, test_generator, NULL, 1);
+    queuedCount = 0;
+
+    TEST_EXPECT(World_request_chunk(world, 0, 0) && World_request_chunk(world, 1, 0), "generated chunks missing");
+    World_set_tile(world, CHUNK_SIZE, 0, 77);  // only chunk (1, 0) is edited
+    World_evict_cold(world);
+    World_evict_cold(world);
+    Chunk* pristine = chunk_at(world, 0, 0);
+    Chunk* edited = chunk_at(world, 1, 0);
+    TEST_EXPECT(!pristine->resident && !edited->resident, "both chunks should be evicted");
+    World_set_loader(world, test_loader, NULL);
+
+    generatorCalls = 0;
+    TEST_EXPECT(World_load_async(world, pristine), "the dropped chunk was not queued");
+    TEST_EXPECT(World_load_async(world, edited), "the paged-out chunk was not queued");
+    TEST_EXPECT(!World_load_async(world, edited), "a chunk already loading was queued twice");
+    TEST_EXPECT(queuedCount == 2 && pristine->loading && edited->loading, "the loader did not get both chunks");
+    TEST_EXPECT(generatorCalls == 0 && !pristine->resident, "queueing must not regenerate on the calling thread");
+    TEST_EXPECT(world->stats.pageIns == 0, "queueing must not read on the calling thread");
+
+    // What a ChunkStreamSystem worker does with each job
+    for (int i = 0; i < queuedCount; i++) {
+        Chunk* chunk = queuedLoads[i];
+        uint16_t* tiles = (uint16_t*)malloc(CHUNK_BYTES);
+        bool ok = chunk->stored ? RegionStore_read_tiles(&world->store, chunk->chunkX, chunk->chunkY, tiles)
+                                : World_generate_tiles(world, chunk->chunkX, chunk->chunkY, tiles);
+        World_finish_load(world, chunk, ok ? tiles : NULL);
+        if (!ok) free(tiles);
+    }
+    TEST_EXPECT(pristine->resident && edited->resident, "the finished loads were not installed");
+    TEST_EXPECT(world->stats.generated == 3 && world->stats.pageIns == 1, "the loads were counted wrongly");
+    TEST_EXPECT(World_get_tile(world, 1, 0) == 1, "the regenerated chunk has the wrong tiles");
+    TEST_EXPECT(World_get_tile(world, CHUNK_SIZE, 0) == 77, "the read chunk lost its edit");
+    TEST_EXPECT(!World_load_async(world, pristine), "a resident chunk should not be queued");
+
+    printf("    ✓ Asynchronous load test passed\n");
+done:
+    World_free(world);
+    remove_pages();
+    return passed;
+}
+
+// Runs the jobs test_loader collected as a worker would, first generations included
+static void finish_queued_loads(World* world) {
+    for (int i = 0; i < queuedCount; i++) {
+        Chunk* chunk = queuedLoads[i];
+        uint16_t* tiles = (uint16_t*)malloc(CHUNK_BYTES);
+        bool ok = World_generate_tiles(world, chunk->chunkX, chunk->chunkY, tiles);
+        World_finish_load(world, chunk, ok ? tiles : NULL);
+        if (!ok) free(tiles);
+    }
+    queuedCount = 0;
+}
+
+static bool test_async_generation(void) {
+    printf("  Testing first generation on the loader...\n");
+    bool passed = true;
+    World* world = World_new(NULL);
+    World_set_generator(world, test_generator, NULL, 1);
+    World_set_loader(world, test_loader, NULL);
+    queuedCount = 0;
+    generatorCalls = 0;
+
+    TEST_EXPECT(World_request_chunk(world, 2, 3) == NULL, "a new chunk should wait for the loader");
+    TEST_EXPECT(World_request_chunk(world, -1, 0) == NULL, "a new chunk should wait for the loader");
+    TEST_EXPECT(World_request_chunk(world, 2, 3) == NULL, "a chunk being generated should not be handed out");
+    TEST_EXPECT(queuedCount == 2 && generatorCalls == 0, "the requests should be queued once, not generated here");
+    Chunk* pending = chunk_at(world, 2, 3);
+    TEST_EXPECT(pending && pending->generating && pending->loading && !pending->resident, "the queued chunk is not a placeholder");
+    int x, y, width, height;
+    TEST_EXPECT(!World_get_bounds(world, &x, &y, &width, &height), "a placeholder should not extend the bounds");
+
+    finish_queued_loads(world);
+    Chunk* chunk = World_request_chunk(world, 2, 3);
+    TEST_EXPECT(chunk == pending && chunk->resident && !chunk->generating, "the generated chunk was not installed");
+    TEST_EXPECT(World_get_tile(world, 2 * CHUNK_SIZE, 3 * CHUNK_SIZE) == 23, "the generated chunk has the wrong tiles");
+    TEST_EXPECT(World_get_bounds(world, &x, &y, &width, &height) && x == 2 * CHUNK_SIZE && y == 3 * CHUNK_SIZE,
+                "the installed chunk should extend the bounds");
+
+    // The generator left (-1, 0) empty: the placeholder goes, the coordinate is remembered
+    TEST_EXPECT(chunk_at(world, -1, 0) == NULL, "an empty result should not leave a chunk behind");
+    TEST_EXPECT(World_request_chunk(world, -1, 0) == NULL && queuedCount == 0, "an empty result should not be queued again");
+
+    // Something that needs the tiles now generates them on the spot
+    TEST_EXPECT(World_request_chunk(world, 4, 0) == NULL, "a new chunk should wait for the loader");
+    pending = chunk_at(world, 4, 0);
+    TEST_EXPECT(World_get_tile(world, 4 * CHUNK_SIZE, 0) == 40, "a synchronous read did not generate the chunk");
+    finish_queued_loads(world);
+    TEST_EXPECT(pending->resident && World_get_tile(world, 4 * CHUNK_SIZE, 0) == 40, "the late result broke the chunk");
+    TEST_EXPECT(generatorCalls == 4, "the chunks were generated the wrong number of times");
+
+    printf("    ✓ Asynchronous generation test passed\n");
+done:
+    World_free(world);
+    return passed;
+}
+
+// Main test function for the world module
+bool test_world(void) {
+    bool all_passed = true;
+
+    all_passed &= test_sparse_storage();
+    all_passed &= test_bulk_operations();
+    all_passed &= test_eviction_budget();
+    all_passed &= test_compression();
+    all_passed &= test_snapshot_copy_on_write();
+    all_passed &= test_pinned_chunks();
+    all_passed &= test_generated_chunks();
+    all_passed &= test_async_loads();
+    all_passed &= test_async_generation();
+
+    return all_passed;
+}
@@ -0,0 +1,120 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "raylib.h"
+#include "renderer/baked_font.h"
+
+// Rasterizes the printable ASCII glyphs of a TrueType font into an atlas
+// and writes it in the BakedFont format (include/renderer/baked_font.h).
+// Runs at build time; needs no window, raylib's font rasterizer is CPU only.
+//
+// Usage: font_baker <input.ttf> <output.font> [size] [--sdf]
+//
+// The default size is raylib's LoadFont size, so a baked font measures and
+// draws like the TTF loaded directly. --sdf bakes distance fields, which
+// stay sharp when scaled but need raylib's SDF shader to draw.
+
+#define BAKER_FIRST_CHAR 32
+#define BAKER_CHAR_COUNT 95
+#define BAKER_DEFAULT_SIZE 32
+#define BAKER_PADDING 4
+
+static bool write_padding(FILE* out, long to) {
+    static const char zeros[BAKED_FONT_ALIGN];
+    long at = ftell(out);
+    return at >= 0 && at <= to && fwrite(zeros, 1, (size_t)(to - at), out) == (size_t)(to - at);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <input.ttf> <output.font> [size] [--sdf]\n", argv[0]);
+        return 2;
+    }
+    const char* inputPath = argv[1];
+    const char* outputPath = argv[2];
+    int size = BAKER_DEFAULT_SIZE;
+    bool sdf = false;
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "--sdf") == 0) sdf = true;
+        else size = atoi(argv[i]);
+    }
+    if (size <= 0) {
+        fprintf(stderr, "font_baker: bad size\n");
+        return 2;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    int dataSize = 0;
+    unsigned char* data = LoadFileData(inputPath, &dataSize);
+    if (!data) {
+        fprintf(stderr, "font_baker: cannot read %s\n", inputPath);
+        return 1;
+    }
+
+    int codepoints[BAKER_CHAR_COUNT];
+    for (int i = 0; i < BAKER_CHAR_COUNT; i++) codepoints[i] = BAKER_FIRST_CHAR + i;
+    GlyphInfo* glyphs = LoadFontData(data, dataSize, size, codepoints, BAKER_CHAR_COUNT, sdf ? FONT_SDF : FONT_DEFAULT);
+    UnloadFileData(data);
+    if (!glyphs) {
+        fprintf(stderr, "font_baker: cannot rasterize %s\n", inputPath);
+        return 1;
+    }
+
+    Rectangle* recs = NULL;
+    Image atlas = GenImageFontAtlas(glyphs, &recs, BAKER_CHAR_COUNT, size, BAKER_PADDING, sdf ? 1 : 0);
+    if (!atlas.data || !recs) {
+        fprintf(stderr, "font_baker: cannot pack the atlas\n");
+        UnloadFontData(glyphs, BAKER_CHAR_COUNT);
+        return 1;
+    }
+
+    BakedFontHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BAKED_FONT_MAGIC, 4);
+    header.version = BAKED_FONT_VERSION;
+    header.baseSize = size;
+    header.glyphCount = BAKER_CHAR_COUNT;
+    header.glyphPadding = BAKER_PADDING;
+    header.atlasWidth = atlas.width;
+    header.atlasHeight = atlas.height;
+    header.format = atlas.format;
+    header.flags = sdf ? BAKED_FONT_SDF : 0u;
+    header.glyphOffset = BakedFont_align((uint32_t)sizeof(BakedFontHeader));
+    header.pixelOffset = BakedFont_align(header.glyphOffset + (uint32_t)(sizeof(BakedGlyph) * BAKER_CHAR_COUNT));
+    header.pixelBytes = (uint32_t)GetPixelDataSize(atlas.width, atlas.height, atlas.format);
+
+    BakedGlyph baked[BAKER_CHAR_COUNT];
+    for (int i = 0; i < BAKER_CHAR_COUNT; i++) {
+        baked[i] = (BakedGlyph){
+            .value = glyphs[i].value,
+            .offsetX = glyphs[i].offsetX,
+            .offsetY = glyphs[i].offsetY,
+            .advanceX = glyphs[i].advanceX,
+            .x = recs[i].x,
+            .y = recs[i].y,
+            .width = recs[i].width,
+            .height = recs[i].height
+        };
+    }
+
+    FILE* out = fopen(outputPath, "wb");
+    bool ok = out != NULL;
+    if (ok) {
+        ok = fwrite(&header, sizeof(header), 1, out) == 1 &&
+             write_padding(out, (long)header.glyphOffset) &&
+             fwrite(baked, sizeof(BakedGlyph), BAKER_CHAR_COUNT, out) == BAKER_CHAR_COUNT &&
+             write_padding(out, (long)header.pixelOffset) &&
+             fwrite(atlas.data, 1, header.pixelBytes, out) == header.pixelBytes;
+        ok = fclose(out) == 0 && ok;
+    }
+    if (!ok) fprintf(stderr, "font_baker: cannot write %s\n", outputPath);
+    else printf("font_baker: %s, %d px%s, %dx%d atlas, %u bytes\n", outputPath, size, sdf ? " SDF" : "",
+                atlas.width, atlas.height, header.pixelOffset + header.pixelBytes);
+
+    UnloadImage(atlas);
+    MemFree(recs);
+    UnloadFontData(glyphs, BAKER_CHAR_COUNT);
+    return ok ? 0 : 1;
+}